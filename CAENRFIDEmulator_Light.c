@@ -0,0 +1,781 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2022, CAEN RFID S.R.L.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of CAEN RFID S.R.L. nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+
+#include <string.h>
+#include "CAENRFIDEmulator_Light.h"
+#include "Protocol_Light.h"
+
+#define EMU_SOURCES     (4)
+#define EMU_ANTENNAS    (4)
+#define EMU_MAX_AVPS    (32)
+#define EMU_EPC_BANK    (4 + MAX_ID_LENGTH)
+
+static const char * EmuAntName[] = {"Ant0","Ant1","Ant2","Ant3"};
+static const char * EmuSrcName[] = {"Source_0","Source_1","Source_2","Source_3"};
+
+typedef struct EmuAVP
+{
+    uint16_t         type;
+    uint16_t         len;
+    const uint8_t   *value;
+} EmuAVP_t;
+
+static uint16_t emu_get_short(const uint8_t *buf)
+{
+    return (uint16_t)((buf[0] << 8) | buf[1]);
+}
+
+static uint32_t emu_get_long(const uint8_t *buf)
+{
+    return (((uint32_t) buf[0] << 24) | ((uint32_t) buf[1] << 16) |
+            ((uint32_t) buf[2] <<  8) |  (uint32_t) buf[3]);
+}
+
+static uint32_t emu_random(CAENRFIDEmulator* emu)
+{
+    //xorshift32, deterministic for a given Seed
+    uint32_t x = emu->_rng;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    emu->_rng = x;
+    return x;
+}
+
+static bool emu_chance(CAENRFIDEmulator* emu, uint16_t per_mille)
+{
+    if(per_mille == 0) return false;
+    return (emu_random(emu) % 1000) < per_mille;
+}
+
+static void emu_compact(CAENRFIDEmulator* emu)
+{
+    //move pending output to the beginning of the buffer; only called
+    //while no reply frame is open, since frames are patched by offset
+    if(emu->_out_rpos == 0) return;
+    memmove(emu->_out, &emu->_out[emu->_out_rpos], emu->_out_wpos - emu->_out_rpos);
+    emu->_out_wpos -= emu->_out_rpos;
+    emu->_out_rpos = 0;
+}
+
+static void emu_put(CAENRFIDEmulator* emu, const void* data, uint32_t len)
+{
+    if(emu->_out_wpos + len > sizeof(emu->_out)) return;
+    memcpy(&emu->_out[emu->_out_wpos], data, len);
+    emu->_out_wpos += len;
+}
+
+static void emu_put_short(CAENRFIDEmulator* emu, uint16_t value)
+{
+    uint8_t buf[2] = {(uint8_t)(value >> 8), (uint8_t) value};
+    emu_put(emu, buf, sizeof(buf));
+}
+
+static void emu_put_long(CAENRFIDEmulator* emu, uint32_t value)
+{
+    uint8_t buf[4] = {(uint8_t)(value >> 24), (uint8_t)(value >> 16),
+                      (uint8_t)(value >> 8), (uint8_t) value};
+    emu_put(emu, buf, sizeof(buf));
+}
+
+static void emu_put_avp(CAENRFIDEmulator* emu, uint16_t type, const void* value, uint16_t len)
+{
+    emu_put_short(emu, 0);
+    emu_put_short(emu, AVP_HEADLEN + len);
+    emu_put_short(emu, type);
+    emu_put(emu, value, len);
+}
+
+static void emu_put_avp_short(CAENRFIDEmulator* emu, uint16_t type, uint16_t value)
+{
+    uint8_t buf[2] = {(uint8_t)(value >> 8), (uint8_t) value};
+    emu_put_avp(emu, type, buf, sizeof(buf));
+}
+
+static void emu_put_avp_long(CAENRFIDEmulator* emu, uint16_t type, uint32_t value)
+{
+    uint8_t buf[4] = {(uint8_t)(value >> 24), (uint8_t)(value >> 16),
+                      (uint8_t)(value >> 8), (uint8_t) value};
+    emu_put_avp(emu, type, buf, sizeof(buf));
+}
+
+static void emu_put_string(CAENRFIDEmulator* emu, uint16_t type, const char* value)
+{
+    emu_put_avp(emu, type, value, (uint16_t)(strlen(value) + 1));
+}
+
+static uint32_t emu_begin(CAENRFIDEmulator* emu, uint16_t CmdID, uint16_t cmd)
+{
+    uint32_t start = emu->_out_wpos;
+
+    emu_put_short(emu, 0x0001);
+    emu_put_short(emu, CmdID);
+    emu_put_long(emu, CAEN_VENDOR);
+    emu_put_short(emu, 0);
+    emu_put_avp_short(emu, AVP_COMMAND, cmd);
+    return start;
+}
+
+static void emu_end(CAENRFIDEmulator* emu, uint32_t start, uint16_t result)
+{
+    uint32_t len;
+
+    emu_put_avp_short(emu, AVP_RESULT_CODE, result);
+    len = emu->_out_wpos - start;
+    if(len > 0xFFFF) len = 0xFFFF;
+    emu->_out[start + 8] = (uint8_t)(len >> 8);
+    emu->_out[start + 9] = (uint8_t) len;
+}
+
+static const EmuAVP_t* emu_find(const EmuAVP_t* avps, int16_t n, uint16_t type, int16_t nth)
+{
+    int16_t i;
+
+    for(i = 0; i < n; i++)
+    {
+        if(avps[i].type == type && nth-- == 0) return &avps[i];
+    }
+    return NULL;
+}
+
+static uint32_t emu_find_value(const EmuAVP_t* avps, int16_t n, uint16_t type, uint32_t def)
+{
+    const EmuAVP_t* avp = emu_find(avps, n, type, 0);
+
+    if(avp == NULL) return def;
+    if(avp->len == 2) return emu_get_short(avp->value);
+    if(avp->len == 4) return emu_get_long(avp->value);
+    return def;
+}
+
+static int16_t emu_source_index(const EmuAVP_t* avp)
+{
+    int16_t i;
+
+    if(avp == NULL) return -1;
+    for(i = 0; i < EMU_SOURCES; i++)
+    {
+        if(strncmp((const char*) avp->value, EmuSrcName[i], avp->len) == 0) return i;
+    }
+    return -1;
+}
+
+static int16_t emu_antenna_index(const EmuAVP_t* avp)
+{
+    int16_t i;
+
+    if(avp == NULL) return -1;
+    for(i = 0; i < EMU_ANTENNAS; i++)
+    {
+        if(strncmp((const char*) avp->value, EmuAntName[i], avp->len) == 0) return i;
+    }
+    return -1;
+}
+
+//epc is a caller provided EMU_EPC_BANK bytes buffer the EPC bank is built in
+static uint16_t emu_bank(CAENRFIDEmuTag* tag, uint16_t bank, uint8_t** mem, uint8_t* epc)
+{
+    switch(bank)
+    {
+    case RESERVED:
+        *mem = tag->Reserved;
+        return CAENRFID_EMU_RESERVED_SIZE;
+    case EPC_CAEN:
+        //the EPC bank is rebuilt as CRC + PC + ID
+        memset(epc, 0, 2);
+        memcpy(&epc[2], tag->PC, PC_LENGTH);
+        memcpy(&epc[4], tag->ID, tag->Length);
+        *mem = epc;
+        return (uint16_t)(4 + tag->Length);
+    case TID:
+        *mem = tag->TID;
+        return tag->TIDLen;
+    case USER:
+        *mem = tag->User;
+        return CAENRFID_EMU_USER_SIZE;
+    default:
+        *mem = NULL;
+        return 0;
+    }
+}
+
+static bool emu_match(CAENRFIDEmulator* emu, CAENRFIDEmuTag* tag)
+{
+    uint8_t epc[EMU_EPC_BANK];
+    uint8_t* mem;
+    uint16_t size, i, bit, mbit;
+
+    if(tag->Killed) return false;
+    if(((emu->_src_antennas[emu->_inv_src] >> tag->Antenna) & 1) == 0) return false;
+    if(emu->_inv_mask_len == 0) return true;
+    size = emu_bank(tag, emu->_inv_bank, &mem, epc);
+    if(emu->_inv_mask_addr + emu->_inv_mask_len > size * 8) return false;
+    for(i = 0; i < emu->_inv_mask_len; i++)
+    {
+        bit = emu->_inv_mask_addr + i;
+        mbit = (emu->_inv_mask[i / 8] >> (7 - (i % 8))) & 1;
+        if(((mem[bit / 8] >> (7 - (bit % 8))) & 1) != mbit) return false;
+    }
+    return true;
+}
+
+static CAENRFIDEmuTag* emu_tag(CAENRFIDEmulator* emu, const EmuAVP_t* avps, int16_t n)
+{
+    const EmuAVP_t* id = emu_find(avps, n, AVP_TAGID, 0);
+    uint32_t i;
+
+    if(id == NULL) return NULL;
+    for(i = 0; i < emu->NumTags; i++)
+    {
+        if(!emu->Tags[i].Killed && emu->Tags[i].Length == id->len &&
+           memcmp(emu->Tags[i].ID, id->value, id->len) == 0) return &emu->Tags[i];
+    }
+    return NULL;
+}
+
+static void emu_put_tag(CAENRFIDEmulator* emu, CAENRFIDEmuTag* tag, uint16_t flag, const char* source)
+{
+    int16_t rssi = tag->RSSI;
+    uint8_t ts[8];
+
+    if(emu->RSSIJitter != 0)
+    {
+        rssi += (int16_t)(emu_random(emu) % (2 * emu->RSSIJitter + 1)) - (int16_t) emu->RSSIJitter;
+    }
+    emu->_time[1] += emu->TagTimeUs;
+    emu->_time[0] += emu->_time[1] / 1000000;
+    emu->_time[1] %= 1000000;
+    if((flag & COMPACT) == 0)
+    {
+        emu_put_string(emu, AVP_SOURCE_NAME, source);
+        emu_put_string(emu, AVP_READPOINT_NAME, EmuAntName[tag->Antenna % EMU_ANTENNAS]);
+        ts[0] = (uint8_t)(emu->_time[0] >> 24); ts[1] = (uint8_t)(emu->_time[0] >> 16);
+        ts[2] = (uint8_t)(emu->_time[0] >> 8);  ts[3] = (uint8_t) emu->_time[0];
+        ts[4] = (uint8_t)(emu->_time[1] >> 24); ts[5] = (uint8_t)(emu->_time[1] >> 16);
+        ts[6] = (uint8_t)(emu->_time[1] >> 8);  ts[7] = (uint8_t) emu->_time[1];
+        emu_put_avp(emu, AVP_TIMESTAMP, ts, sizeof(ts));
+        emu_put_avp_short(emu, AVP_TAGTYPE, CAENRFID_EPC_C1G2);
+        emu_put_avp_short(emu, AVP_TAGIDLEN, tag->Length);
+    }
+    emu_put_avp(emu, AVP_TAGID, tag->ID, tag->Length);
+    if(flag & RSSI) emu_put_avp_short(emu, AVP_RSSI, (uint16_t) rssi);
+    if(flag & TID_READING)
+    {
+        emu_put_avp_short(emu, AVP_LENGTH, tag->TIDLen);
+        if(tag->TIDLen) emu_put_avp(emu, AVP_TAG_VALUE, tag->TID, tag->TIDLen);
+    }
+    if(flag & XPC) emu_put_avp(emu, AVP_XPC, tag->XPC, XPC_LENGTH);
+    if(flag & PC) emu_put_avp(emu, AVP_PC, tag->PC, PC_LENGTH);
+}
+
+static void emu_inventory_round(CAENRFIDEmulator* emu, uint32_t start)
+{
+    uint32_t i, mark;
+
+    for(i = 0; i < emu->NumTags; i++)
+    {
+        if(!emu_match(emu, &emu->Tags[i])) continue;
+        mark = emu->_out_wpos;
+        emu_put_tag(emu, &emu->Tags[i], emu->_inv_flag, emu->_inv_source);
+        //a non framed reply must fit the 16 bit frame length
+        if(!emu->_inv_framed && emu->_out_wpos - start + 2 * AVP_HEADLEN + 2 > 0xFFFF)
+        {
+            emu->_out_wpos = mark;
+            break;
+        }
+    }
+}
+
+static uint16_t emu_inventory(CAENRFIDEmulator* emu, const EmuAVP_t* avps, int16_t n, uint32_t start)
+{
+    const EmuAVP_t* src = emu_find(avps, n, AVP_SOURCE_NAME, 0);
+    const EmuAVP_t* mask = emu_find(avps, n, AVP_TAGID, 0);
+    uint16_t flag = (uint16_t) emu_find_value(avps, n, AVP_BITMASK, 0);
+
+    if(emu_source_index(src) < 0) return CAENRFID_InvalidSourceNamError;
+    emu->_inv_src = (uint16_t) emu_source_index(src);
+    memset(emu->_inv_source, 0, sizeof(emu->_inv_source));
+    memcpy(emu->_inv_source, src->value, src->len < MAX_LOGICAL_SOURCE_NAME ? src->len : MAX_LOGICAL_SOURCE_NAME - 1);
+    emu->_inv_flag = flag;
+    emu->_inv_bank = (uint16_t) emu_find_value(avps, n, AVP_MEMBANK, 0);
+    emu->_inv_mask_addr = (uint16_t) emu_find_value(avps, n, AVP_TAGADDRESS, 0);
+    emu->_inv_mask_len = 0;
+    if(mask != NULL && mask->len <= MAX_ID_LENGTH)
+    {
+        emu->_inv_mask_len = (uint16_t) emu_find_value(avps, n, AVP_LENGTH, 0);
+        memcpy(emu->_inv_mask, mask->value, mask->len);
+        if(emu->_inv_mask_len > mask->len * 8) emu->_inv_mask_len = mask->len * 8;
+    }
+    if(flag & FRAMED)
+    {
+        emu->_inv_framed = true;
+        emu->_inv_abort = false;
+        emu->_inv_rounds = emu->_read_cycle;
+        return CAENRFID_StatusOK;
+    }
+    emu->_inv_framed = false;
+    emu_inventory_round(emu, start);
+    return CAENRFID_StatusOK;
+}
+
+static void emu_buffered_data(CAENRFIDEmulator* emu, const EmuAVP_t* avps, int16_t n, uint32_t start)
+{
+    uint16_t flag = (uint16_t) emu_find_value(avps, n, AVP_BITMASK, 0) & (RSSI | TID_READING | XPC | PC);
+    uint32_t count = emu_find_value(avps, n, AVP_LENGTH, 0);
+    uint32_t mark;
+
+    //oldest reads first, up to the requested count or the frame length
+    if(count == 0 || count > emu->_buf_count) count = emu->_buf_count;
+    while(count-- > 0)
+    {
+        mark = emu->_out_wpos;
+        emu_put_tag(emu, &emu->Tags[emu->_buf_tags[emu->_buf_head]], flag, EmuSrcName[0]);
+        if(emu->_out_wpos - start + 2 * AVP_HEADLEN + 2 > 0xFFFF)
+        {
+            emu->_out_wpos = mark;
+            break;
+        }
+        emu->_buf_head = (emu->_buf_head + 1) % CAENRFID_EMU_BUFFER_SIZE;
+        emu->_buf_count--;
+    }
+}
+
+static uint16_t emu_access(CAENRFIDEmulator* emu, uint16_t cmd, const EmuAVP_t* avps, int16_t n)
+{
+    CAENRFIDEmuTag* tag = emu_tag(emu, avps, n);
+    const EmuAVP_t* value;
+    uint8_t epc[EMU_EPC_BANK];
+    uint8_t* mem;
+    uint16_t size, bank, addr, len;
+    uint32_t pwd;
+
+    if(emu_chance(emu, emu->TagErrorRate)) return CAENRFID_TagNotPresentError;
+    if(cmd == CMD_G2PROGRAMID)
+    {
+        const EmuAVP_t* id = emu_find(avps, n, AVP_TAGID, 0);
+        uint32_t i;
+
+        if(id == NULL || id->len > MAX_ID_LENGTH) return CAENRFID_InvalidParameterError;
+        for(i = 0; i < emu->NumTags; i++)
+        {
+            if(emu->Tags[i].Killed) continue;
+            memcpy(emu->Tags[i].ID, id->value, id->len);
+            emu->Tags[i].Length = id->len;
+            return CAENRFID_StatusOK;
+        }
+        return CAENRFID_TagNotPresentError;
+    }
+    if(tag == NULL) return CAENRFID_TagNotPresentError;
+    switch(cmd)
+    {
+    case CMD_G2READ:
+    case CMD_G2WRITE:
+        bank = (uint16_t) emu_find_value(avps, n, AVP_MEMBANK, 0);
+        addr = (uint16_t) emu_find_value(avps, n, AVP_TAGADDRESS, 0);
+        len = (uint16_t) emu_find_value(avps, n, AVP_LENGTH, 0);
+        size = emu_bank(tag, bank, &mem, epc);
+        if(mem == NULL || addr + len > size) return CAENRFID_BadTagAddressError;
+        if(cmd == CMD_G2READ)
+        {
+            emu_put_avp(emu, AVP_TAG_VALUE, &mem[addr], len);
+            return CAENRFID_StatusOK;
+        }
+        value = emu_find(avps, n, AVP_TAG_VALUE, 0);
+        if(value == NULL || value->len != len) return CAENRFID_InvalidParameterError;
+        memcpy(&mem[addr], value->value, len);
+        if(bank == EPC_CAEN)
+        {
+            memcpy(tag->PC, &mem[2], PC_LENGTH);
+            memcpy(tag->ID, &mem[4], tag->Length);
+        }
+        return CAENRFID_StatusOK;
+    case CMD_G2KILL:
+        pwd = emu_find_value(avps, n, AVP_G2PWD, 0);
+        if(pwd == 0 || pwd != emu_get_long(tag->Reserved)) return CAENRFID_KillTagError;
+        tag->Killed = true;
+        return CAENRFID_StatusOK;
+    case CMD_G2CUSTOM:
+        value = emu_find(avps, n, AVP_LENGTH, 1);
+        if(value == NULL) value = emu_find(avps, n, AVP_LENGTH, 0);
+        len = value ? emu_get_short(value->value) : 0;
+        if(len > CAENRFID_EMU_USER_SIZE) return CAENRFID_InvalidParameterError;
+        emu_put_avp(emu, AVP_TAG_VALUE, tag->User, len);
+        return CAENRFID_StatusOK;
+    default:
+        return CAENRFID_StatusOK;
+    }
+}
+
+static void emu_command(CAENRFIDEmulator* emu, const uint8_t* frame, uint16_t size)
+{
+    EmuAVP_t avps[EMU_MAX_AVPS];
+    int16_t n = 0, idx;
+    uint16_t CmdID = emu_get_short(frame + 2), cmd = 0, result = CAENRFID_StatusOK, len;
+    uint32_t start, value;
+    char model[] = "R7100C 0000001";
+    char fwrel[] = "Emulator 1.0.0";
+    uint8_t vswr[4] = {0x3F, 0x80, 0x00, 0x00};
+
+    for(idx = HEADER_LEN; idx + AVP_HEADLEN <= size && n < EMU_MAX_AVPS; idx += len)
+    {
+        len = emu_get_short(frame + idx + 2);
+        if(len < AVP_HEADLEN || idx + len > size) break;
+        avps[n].type = emu_get_short(frame + idx + 4);
+        avps[n].len = len - AVP_HEADLEN;
+        avps[n].value = frame + idx + AVP_HEADLEN;
+        n++;
+    }
+    if(n > 0 && avps[0].type == AVP_COMMAND) cmd = emu_get_short(avps[0].value);
+    emu->_commands++;
+    start = emu_begin(emu, CmdID, cmd);
+    switch(cmd)
+    {
+    case CMD_GETFWRELEASE:
+        emu_put_string(emu, AVP_GETFWRELEASE, fwrel);
+        break;
+    case CMD_GETRDRINFO:
+        emu_put_string(emu, AVP_READERINFO, model);
+        break;
+    case CMD_SETPROTOCOL:
+        emu->_protocol = emu_find_value(avps, n, AVP_PROTOCOL_NAME, emu->_protocol);
+        break;
+    case CMD_GETPROTOCOL:
+        emu_put_avp_long(emu, AVP_PROTOCOL_NAME, emu->_protocol);
+        break;
+    case CMD_SETPOWER:
+        emu->_power = emu_find_value(avps, n, AVP_POWER, emu->_power);
+        break;
+    case CMD_GETPOWER:
+        emu_put_avp_long(emu, AVP_POWER_GET, emu->_power);
+        break;
+    case CMD_ADDREADPOINT:
+    case CMD_REMREADPOINT:
+    case CMD_CHECKRPINSRC:
+        idx = emu_source_index(emu_find(avps, n, AVP_SOURCE_NAME, 0));
+        len = (uint16_t) emu_antenna_index(emu_find(avps, n, AVP_READPOINT_NAME, 0));
+        if(idx < 0) { result = CAENRFID_InvalidSourceNamError; break; }
+        if(len >= EMU_ANTENNAS) { result = CAENRFID_BadReadPointError; break; }
+        if(cmd == CMD_ADDREADPOINT) emu->_src_antennas[idx] |= (uint16_t)(1 << len);
+        else if(cmd == CMD_REMREADPOINT) emu->_src_antennas[idx] &= (uint16_t) ~(1 << len);
+        else emu_put_avp_short(emu, AVP_BOOLEAN, (emu->_src_antennas[idx] >> len) & 1);
+        break;
+    case CMD_CHECKANTENNA:
+        emu_put_avp_long(emu, AVP_READPOINT_STATUS, STATUS_GOOD);
+        break;
+    case CMD_MATCHRFIMPEDANCE:
+        emu_put_avp(emu, AVP_POWER_VSWR, vswr, sizeof(vswr));
+        break;
+    case CMD_SETSRCCONF:
+        if(emu_find_value(avps, n, AVP_CONFIGPARAMETER, 0xFFFF) == CONFIG_READCYCLE)
+        {
+            emu->_read_cycle = emu_find_value(avps, n, AVP_CONFIGVALUE, emu->_read_cycle);
+        }
+        break;
+    case CMD_GETSRCCONF:
+        value = (emu_find_value(avps, n, AVP_CONFIGPARAMETER, 0xFFFF) == CONFIG_READCYCLE) ? emu->_read_cycle : 0;
+        emu_put_avp_long(emu, AVP_CONFIGVALUE, value);
+        break;
+    case CMD_SETRS232:
+        break;
+    case CMD_GROUPSELUNSEL:
+        //ISO18000-6B tags are not emulated, the operation is only checked
+        if(emu_source_index(emu_find(avps, n, AVP_SOURCE_NAME, 0)) < 0) { result = CAENRFID_InvalidSourceNamError; break; }
+        if(emu_find_value(avps, n, AVP_SELUNSEL_OP, 0xFFFF) > GROUP_UNSELECT_LOWER_THAN) result = CAENRFID_InvalidParameterError;
+        break;
+    case CMD_GETBUFFEREDDATA:
+        emu_buffered_data(emu, avps, n, start);
+        break;
+    case CMD_GETBUFFERSIZE:
+        emu_put_avp_long(emu, AVP_LONG_LENGTH, emu->_buf_count);
+        break;
+    case CMD_CLEARBUFFER:
+        emu->_buf_count = 0;
+        break;
+    case CMD_SETRFLINKPROFILE:
+        emu->_bitrate = (uint16_t) emu_find_value(avps, n, AVP_MODULATION, emu->_bitrate);
+        break;
+    case CMD_GETRFLINKPROFILE:
+        emu_put_avp_short(emu, AVP_MODULATION, emu->_bitrate);
+        break;
+    case CMD_SETFHMODE:
+        emu->_fhss = (uint16_t) emu_find_value(avps, n, AVP_BOOLEAN, emu->_fhss);
+        break;
+    case CMD_GETFHMODE:
+        emu_put_avp_short(emu, AVP_BOOLEAN, emu->_fhss);
+        break;
+    case CMD_SETCHANNEL:
+        emu->_channel = (uint16_t) emu_find_value(avps, n, AVP_RFCHANNEL, emu->_channel);
+        break;
+    case CMD_GETCHANNEL:
+        emu_put_avp_short(emu, AVP_RFCHANNEL, emu->_channel);
+        break;
+    case CMD_SETRFREGULATION:
+        emu->_regulation = (uint16_t) emu_find_value(avps, n, AVP_RFREGULATION, emu->_regulation);
+        break;
+    case CMD_GETRFREGULATION:
+        emu_put_avp_short(emu, AVP_RFREGULATION, emu->_regulation);
+        break;
+    case CMD_SETIO:
+        emu->_io = emu_find_value(avps, n, AVP_IOREGISTER, emu->_io);
+        break;
+    case CMD_GETIO:
+        emu_put_avp_long(emu, AVP_IOREGISTER, emu->_io);
+        break;
+    case CMD_SETIODIR:
+        emu->_iodir = emu_find_value(avps, n, AVP_IOREGISTER, emu->_iodir);
+        break;
+    case CMD_GETIODIR:
+        emu_put_avp_long(emu, AVP_IOREGISTER, emu->_iodir);
+        break;
+    case CMD_G2READ:
+    case CMD_G2WRITE:
+    case CMD_G2LOCK:
+    case CMD_G2KILL:
+    case CMD_G2PROGRAMID:
+    case CMD_G2CUSTOM:
+        result = emu_access(emu, cmd, avps, n);
+        break;
+    case CMD_INVENTORY:
+        result = emu_inventory(emu, avps, n, start);
+        if(result == CAENRFID_StatusOK && emu->_inv_framed)
+        {
+            //framed replies carry the command only, tags follow as bare AVPs
+            return;
+        }
+        break;
+    default:
+        result = CAENRFID_InvalidCommand;
+        break;
+    }
+    emu_end(emu, start, result);
+    if(emu_chance(emu, emu->DropRate))
+    {
+        emu->_out_wpos = start;
+    }
+    else if(emu_chance(emu, emu->CorruptRate))
+    {
+        emu->_out[start + 3] ^= 0xFF;
+    }
+}
+
+static void emu_reverse(CAENRFIDEmulator* emu, const uint32_t* starts, int16_t n)
+{
+    uint8_t tmp[2048];
+    uint32_t len, pos = 0;
+    int16_t i;
+
+    if(n < 2) return;
+    len = emu->_out_wpos - starts[0];
+    if(len > sizeof(tmp)) return;
+    for(i = n - 1; i >= 0; i--)
+    {
+        uint32_t end = (i == n - 1) ? emu->_out_wpos : starts[i + 1];
+        memcpy(&tmp[pos], &emu->_out[starts[i]], end - starts[i]);
+        pos += end - starts[i];
+    }
+    memcpy(&emu->_out[starts[0]], tmp, len);
+}
+
+void CAENRFID_EmulatorInit(CAENRFIDEmulator* emu)
+{
+    emu->_rng = emu->Seed ? emu->Seed : 0x2545F491;
+    emu->_time[0] = 0;
+    emu->_time[1] = 0;
+    emu->_power = 1000;
+    emu->_protocol = CAENRFID_EPC_C1G2;
+    emu->_io = 0;
+    emu->_iodir = 0;
+    emu->_bitrate = PR_ASK_M4_TX40RX250;
+    emu->_fhss = 0;
+    emu->_channel = 0;
+    emu->_regulation = ETSI_302208;
+    emu->_read_cycle = 1;
+    emu->_src_antennas[0] = 0x0F;
+    emu->_src_antennas[1] = 0;
+    emu->_src_antennas[2] = 0;
+    emu->_src_antennas[3] = 0;
+    emu->_inv_framed = false;
+    emu->_inv_abort = false;
+    emu->_inv_source[0] = 0;
+    emu->_inv_src = 0;
+    emu->_buf_head = 0;
+    emu->_buf_count = 0;
+    emu->_commands = 0;
+    emu->_in_len = 0;
+    emu->_out_rpos = 0;
+    emu->_out_wpos = 0;
+}
+
+uint32_t CAENRFID_EmulatorBufferRound(CAENRFIDEmulator* emu)
+{
+    uint32_t i, added = 0;
+
+    for(i = 0; i < emu->NumTags; i++)
+    {
+        if(emu->Tags[i].Killed || ((emu->_src_antennas[0] >> emu->Tags[i].Antenna) & 1) == 0) continue;
+        //a full buffer keeps the oldest reads
+        if(emu->_buf_count == CAENRFID_EMU_BUFFER_SIZE) break;
+        emu->_buf_tags[(emu->_buf_head + emu->_buf_count) % CAENRFID_EMU_BUFFER_SIZE] = i;
+        emu->_buf_count++;
+        added++;
+    }
+    return (added);
+}
+
+int16_t CAENRFID_EmulatorWrite(CAENRFIDEmulator* emu, const uint8_t* data, uint32_t len)
+{
+    uint32_t starts[16];
+    int16_t replies = 0;
+    uint16_t size;
+
+    if(emu->_in_len + len > sizeof(emu->_in)) return (-1);
+    memcpy(&emu->_in[emu->_in_len], data, len);
+    emu->_in_len += len;
+    emu_compact(emu);
+    while(emu->_in_len > 0)
+    {
+        if(emu->_in[0] == UART_ABORT)
+        {
+            if(emu->_inv_framed) emu->_inv_abort = true;
+            size = 1;
+        }
+        else
+        {
+            if(emu->_in_len < HEADER_LEN) break;
+            size = emu_get_short(&emu->_in[8]);
+            if(emu_get_short(emu->_in) != 0x8001 || size < HEADER_LEN)
+            {
+                //resynchronize on garbage
+                emu->_in_len = 0;
+                break;
+            }
+            if(emu->_in_len < size) break;
+            if(replies < (int16_t)(sizeof(starts) / sizeof(starts[0])))
+                starts[replies++] = emu->_out_wpos;
+            emu_command(emu, emu->_in, size);
+        }
+        memmove(emu->_in, &emu->_in[size], emu->_in_len - size);
+        emu->_in_len -= size;
+    }
+    if(emu->ReorderReplies && replies > 1) emu_reverse(emu, starts, replies);
+    if(replies > 0 && emu->delay != NULL) emu->delay(emu->LatencyUs);
+    return (0);
+}
+
+uint32_t CAENRFID_EmulatorRead(CAENRFIDEmulator* emu, uint8_t* data, uint32_t len)
+{
+    uint32_t avail;
+
+    if(emu->_out_rpos == emu->_out_wpos && emu->_inv_framed)
+    {
+        emu->_out_rpos = emu->_out_wpos = 0;
+        if(!emu->_inv_abort) emu_inventory_round(emu, 0);
+        if(emu->_inv_abort || (emu->_inv_rounds != 0 && --emu->_inv_rounds == 0))
+        {
+            emu_put_avp_short(emu, AVP_RESULT_CODE, CAENRFID_StatusOK);
+            emu->_inv_framed = false;
+        }
+    }
+    avail = emu->_out_wpos - emu->_out_rpos;
+    if(len > avail) len = avail;
+    memcpy(data, &emu->_out[emu->_out_rpos], len);
+    emu->_out_rpos += len;
+    return len;
+}
+
+static int16_t emu_connect(void* *port_handle, int16_t port_type, void* port_params)
+{
+    //the handle is the emulator set by CAENRFID_EmulatorAttach
+    (void) port_handle;
+    (void) port_type;
+    (void) port_params;
+    return (0);
+}
+
+static int16_t emu_disconnect(void* port_handle)
+{
+    (void) port_handle;
+    return (0);
+}
+
+static int16_t emu_tx(void* port_handle, uint8_t* data, uint32_t len)
+{
+    return CAENRFID_EmulatorWrite((CAENRFIDEmulator*) port_handle, data, len);
+}
+
+static int16_t emu_rx(void* port_handle, uint8_t* data, uint32_t len, uint32_t ms_timeout)
+{
+    CAENRFIDEmulator* emu = (CAENRFIDEmulator*) port_handle;
+    uint32_t got = 0, n;
+
+    (void) ms_timeout;
+    //the emulator answers synchronously: missing bytes mean a timeout
+    while(got < len)
+    {
+        n = CAENRFID_EmulatorRead(emu, &data[got], len - got);
+        if(n == 0) return (-1);
+        got += n;
+    }
+    return (0);
+}
+
+static int32_t emu_rx_some(void* port_handle, uint8_t* data, uint32_t maxlen, uint32_t ms_timeout)
+{
+    (void) ms_timeout;
+    return (int32_t) CAENRFID_EmulatorRead((CAENRFIDEmulator*) port_handle, data, maxlen);
+}
+
+static int16_t emu_clear_rx_data(void* port_handle)
+{
+    CAENRFIDEmulator* emu = (CAENRFIDEmulator*) port_handle;
+
+    if(!emu->_inv_framed) emu->_out_rpos = emu->_out_wpos = 0;
+    return (0);
+}
+
+static void emu_irqs(void)
+{
+}
+
+void CAENRFID_EmulatorAttach(CAENRFIDReader* reader, CAENRFIDEmulator* emu)
+{
+    reader->_port_handle = emu;
+    reader->connect = emu_connect;
+    reader->disconnect = emu_disconnect;
+    reader->tx = emu_tx;
+    reader->rx = emu_rx;
+    reader->rx_some = emu_rx_some;
+    reader->clear_rx_data = emu_clear_rx_data;
+    reader->enable_irqs = emu_irqs;
+    reader->disable_irqs = emu_irqs;
+}
@@ -0,0 +1,217 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2022, CAEN RFID S.R.L.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of CAEN RFID S.R.L. nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+
+#ifndef SRC_LIB_CAENRFIDEMULATOR_LIGHT_H_
+#define SRC_LIB_CAENRFIDEMULATOR_LIGHT_H_
+
+#include "CAENRFIDTypes_Light.h"
+
+#ifndef CAENRFID_EMU_USER_SIZE
+#define CAENRFID_EMU_USER_SIZE                  64
+#endif
+#ifndef CAENRFID_EMU_OUT_SIZE
+#define CAENRFID_EMU_OUT_SIZE                   0x20000
+#endif
+#ifndef CAENRFID_EMU_BUFFER_SIZE
+#define CAENRFID_EMU_BUFFER_SIZE                4096
+#endif
+#define CAENRFID_EMU_IN_SIZE                    0x1000
+#define CAENRFID_EMU_RESERVED_SIZE              8
+
+/*
+    Emulated tag
+*/
+typedef struct CAENRFIDEmuTag_s {
+    uint8_t             ID[MAX_ID_LENGTH];
+    uint16_t            Length;
+    uint8_t             TID[MAX_TID_SIZE];
+    uint16_t            TIDLen;
+    uint8_t             PC[PC_LENGTH];
+    uint8_t             XPC[XPC_LENGTH];
+    uint8_t             Reserved[CAENRFID_EMU_RESERVED_SIZE];
+    uint8_t             User[CAENRFID_EMU_USER_SIZE];
+    int16_t             RSSI;
+    uint16_t            Antenna;
+    bool                Killed;
+} CAENRFIDEmuTag;
+
+/*
+    Emulator Struct
+
+    User should initialize the following fields before calling
+    CAENRFID_EmulatorInit (all of them may be left to 0):
+    - Tags, NumTags    : the tag population seen by the emulated reader.
+    - Seed             : seed of the pseudo random generator, runs with the
+                         same seed and the same commands produce the same
+                         bytes.
+    - RSSIJitter       : maximum deviation applied to each tag RSSI.
+    - TagTimeUs        : reader time elapsing for each tag reported.
+    - LatencyUs, delay : if delay is set, it is called with LatencyUs before
+                         each reply is made available.
+    - DropRate         : probability, in thousandths, of a reply being lost.
+    - CorruptRate      : probability, in thousandths, of a reply carrying a
+                         wrong CmdID.
+    - TagErrorRate     : probability, in thousandths, of a tag access command
+                         failing with CAENRFID_TagNotPresentError.
+    - ReorderReplies   : if true, replies to commands received in the same
+                         tx call are sent back in reverse order.
+
+    User should NOT modify the fields starting with an underscore.
+*/
+typedef struct CAENRFIDEmulator_s {
+    CAENRFIDEmuTag*     Tags;
+    uint32_t            NumTags;
+    uint32_t            Seed;
+    uint16_t            RSSIJitter;
+    uint32_t            TagTimeUs;
+    uint32_t            LatencyUs;
+    void                (*delay)(uint32_t us);
+    uint16_t            DropRate;
+    uint16_t            CorruptRate;
+    uint16_t            TagErrorRate;
+    bool                ReorderReplies;
+
+    uint32_t            _rng;
+    uint32_t            _time[2];
+    uint32_t            _power;
+    uint32_t            _protocol;
+    uint32_t            _io;
+    uint32_t            _iodir;
+    uint16_t            _bitrate;
+    uint16_t            _fhss;
+    uint16_t            _channel;
+    uint16_t            _regulation;
+    uint32_t            _read_cycle;
+    uint16_t            _src_antennas[4];
+    uint16_t            _inv_flag;
+    uint32_t            _inv_rounds;
+    bool                _inv_framed;
+    bool                _inv_abort;
+    char                _inv_source[MAX_LOGICAL_SOURCE_NAME];
+    uint16_t            _inv_src;
+    uint16_t            _inv_bank;
+    uint16_t            _inv_mask_addr;
+    uint16_t            _inv_mask_len;
+    uint8_t             _inv_mask[MAX_ID_LENGTH];
+    uint32_t            _buf_tags[CAENRFID_EMU_BUFFER_SIZE];
+    uint32_t            _buf_head;
+    uint32_t            _buf_count;
+    uint32_t            _commands;
+    uint32_t            _in_len;
+    uint8_t             _in[CAENRFID_EMU_IN_SIZE];
+    uint32_t            _out_rpos;
+    uint32_t            _out_wpos;
+    uint8_t             _out[CAENRFID_EMU_OUT_SIZE];
+} CAENRFIDEmulator;
+
+/*
+    CAENRFID_EmulatorInit
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in],[out]  emu        : The emulator, with its configuration fields set.
+    -----------------------------------------------------------------------------
+    Returns:
+    -----------------------------------------------------------------------------
+    Description:
+        Resets the emulated reader to its power-on state.
+*/
+void CAENRFID_EmulatorInit(CAENRFIDEmulator* emu);
+
+/*
+    CAENRFID_EmulatorAttach
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in],[out]  reader     : The reader data structure to be bound to the emulator.
+        [in]        emu        : The emulator.
+    -----------------------------------------------------------------------------
+    Returns:
+    -----------------------------------------------------------------------------
+    Description:
+        Fills the reader callbacks so that every command issued through reader
+        is served by emu. CAENRFID_Connect must still be called afterwards,
+        its PortType and PortParams are ignored.
+*/
+void CAENRFID_EmulatorAttach(CAENRFIDReader* reader, CAENRFIDEmulator* emu);
+
+/*
+    CAENRFID_EmulatorBufferRound
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in],[out]  emu        : The emulator.
+    -----------------------------------------------------------------------------
+    Returns:
+        The number of reads added to the reader buffer.
+    -----------------------------------------------------------------------------
+    Description:
+        Runs an inventory round the emulated reader performs on its own on
+        the read points of Source_0, storing the tags detected in its buffer
+        of CAENRFID_EMU_BUFFER_SIZE reads, to be drained with
+        CAENRFID_GetBufferedData. Once the buffer is full new reads are lost.
+*/
+uint32_t CAENRFID_EmulatorBufferRound(CAENRFIDEmulator* emu);
+
+/*
+    CAENRFID_EmulatorWrite
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  emu            : The emulator.
+        [in]  data           : Bytes sent by the host to the emulated reader.
+        [in]  len            : The number of bytes in data.
+    -----------------------------------------------------------------------------
+    Returns:
+        (0) : Success
+       (-1) : Failure (input overflow)
+    -----------------------------------------------------------------------------
+    Description:
+        Feeds bytes to the emulated reader. Complete commands are executed and
+        their replies queued for CAENRFID_EmulatorRead.
+*/
+int16_t CAENRFID_EmulatorWrite(CAENRFIDEmulator* emu, const uint8_t* data, uint32_t len);
+
+/*
+    CAENRFID_EmulatorRead
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  emu            : The emulator.
+        [out] data           : The bytes sent by the emulated reader.
+        [in]  len            : The maximum number of bytes to be returned.
+    -----------------------------------------------------------------------------
+    Returns:
+        The number of bytes copied to data.
+    -----------------------------------------------------------------------------
+    Description:
+        Drains bytes sent by the emulated reader, running the next framed
+        inventory round if no byte is pending.
+*/
+uint32_t CAENRFID_EmulatorRead(CAENRFIDEmulator* emu, uint8_t* data, uint32_t len);
+
+#endif /* SRC_LIB_CAENRFIDEMULATOR_LIGHT_H_ */
@@ -1,1626 +1,3347 @@
-/* --COPYRIGHT--,BSD
- * Copyright (c) 2022, CAEN RFID S.R.L.
- * All rights reserved.
- *
- * Redistribution and use in source and binary forms, with or without
- * modification, are permitted provided that the following conditions
- * are met:
- *
- * *  Redistributions of source code must retain the above copyright
- *    notice, this list of conditions and the following disclaimer.
- *
- * *  Redistributions in binary form must reproduce the above copyright
- *    notice, this list of conditions and the following disclaimer in the
- *    documentation and/or other materials provided with the distribution.
- *
- * *  Neither the name of CAEN RFID S.R.L. nor the names of
- *    its contributors may be used to endorse or promote products derived
- *    from this software without specific prior written permission.
- *
- * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
- * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
- * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
- * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
- * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
- * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
- * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
- * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
- * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
- * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
- * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
- * --/COPYRIGHT--*/
-
-#include <stdlib.h>
-#include <string.h>
-#include "CAENRFIDTypes_Light.h"
-#include "IO_Light.h"
-
-
-static uint16_t _cmdID = 0;
-
-CAENRFIDErrorCodes CAENRFID_Connect(CAENRFIDReader* reader,
-                                    CAENRFIDPort PortType,
-                                    void* PortParams)
-{
-    //if(reader->connect(&reader->_port_handle, (int16_t) PortType, PortParams) != 0) return CAENRFID_PortError;
-   
-   return CAENRFID_StatusOK;
-}
-
-CAENRFIDErrorCodes CAENRFID_Disconnect(CAENRFIDReader* reader)
-{
-    if(reader->disconnect(reader->_port_handle) != 0) return CAENRFID_PortError;
-    return CAENRFID_StatusOK;
-}
-
-CAENRFIDErrorCodes CAENRFID_GetReadPoints(CAENRFIDReader* reader,
-                                          char** Antennas[],
-                                          int16_t* numAnt)
-{
-    (void) reader;
-    getAntNames(Antennas, numAnt);
-    return CAENRFID_StatusOK;
-}
-
-CAENRFIDErrorCodes CAENRFID_GetSourceNames(CAENRFIDReader* reader,
-                                           char** Sources[],
-                                           int16_t* numSrc)
-{
-    (void) reader;
-    getSrcNames(Sources, numSrc);
-    return CAENRFID_StatusOK;
-}
-
-CAENRFIDErrorCodes CAENRFID_GetFirmwareRelease(CAENRFIDReader* reader,
-                                               char *FWRel)
-{
-    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
-    uint16_t  cmd;
-    int16_t tmp;
-    uint16_t result_code;
-    IOBuffer_t rxtxbuf = {0};
-
-    cmd = CMD_GETFWRELEASE;
-    //build request
-    rxtxbuf.size  = HEADER_LEN;
-    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
-
-    if((rxtxbuf.memory = malloc(rxtxbuf.size)) == NULL) return CAENRFID_OutOfMemoryError;
-
-    addHeader(_cmdID++, &rxtxbuf, rxtxbuf.size);
-    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
-    //send command and get reply
-    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf)) != 0)
-    {
-        ret = (CAENRFIDErrorCodes) tmp;
-        goto exit_done;
-    }
-    //extract data
-    rxtxbuf.rpos = HEADER_LEN;
-    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_GETFWRELEASE, FWRel) < 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_RESULT_CODE,  &result_code) != 0) goto exit_done;
-    ret = (CAENRFIDErrorCodes) result_code;
-
-    exit_done:
-    if(rxtxbuf.memory) free(rxtxbuf.memory);
-    return (ret);
-}
-
-CAENRFIDErrorCodes CAENRFID_GetReaderInfo(CAENRFIDReader* reader,
-                                          char* Model,
-                                          char* SerialNum)
-{
-    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
-    uint16_t  cmd;
-    int16_t tmp, idx;
-    uint16_t result_code;
-    IOBuffer_t rxtxbuf = {0};
-    char rInfo[MAX_MODEL_LENGTH + 1 + MAX_SERIAL_LENGTH];
-
-    cmd = CMD_GETRDRINFO;
-    //build request
-    rxtxbuf.size  = HEADER_LEN;
-    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
-
-    if((rxtxbuf.memory = malloc(rxtxbuf.size)) == NULL) return CAENRFID_OutOfMemoryError;
-
-    addHeader(_cmdID++, &rxtxbuf, rxtxbuf.size);
-    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
-    //send command and get reply
-    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf)) != 0)
-    {
-        ret = (CAENRFIDErrorCodes) tmp;
-        goto exit_done;
-    }
-    //extract data
-    rxtxbuf.rpos = HEADER_LEN;
-    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd)  != 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_READERINFO, rInfo)  < 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code)  != 0) goto exit_done;
-    ret = (CAENRFIDErrorCodes)result_code;
-
-    if((idx = (int16_t)strcspn(rInfo, " ")) != 0)
-    {
-        strncpy(Model, rInfo, idx);
-        Model[idx] = 0;
-        strncpy(SerialNum, &rInfo[idx + 1], strlen(rInfo) - idx);
-
-    }
-
-    exit_done:
-    if(rxtxbuf.memory) free(rxtxbuf.memory);
-    return (ret);
-}
-
-CAENRFIDErrorCodes CAENRFID_SetProtocol(CAENRFIDReader* reader,
-                                        CAENRFIDProtocol Proto)
-{
-    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
-    uint16_t  cmd;
-    int16_t tmp;
-    uint16_t result_code;
-    IOBuffer_t rxtxbuf = {0};
-    uint32_t protocol = Proto;
-
-    cmd = CMD_SETPROTOCOL;
-    //build request
-    rxtxbuf.size  = HEADER_LEN;
-    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
-    rxtxbuf.size += sizeAVP(AVP_PROTOCOL_NAME, sizeof(protocol));
-
-    if((rxtxbuf.memory = malloc(rxtxbuf.size)) == NULL) return CAENRFID_OutOfMemoryError;
-
-    addHeader(_cmdID++, &rxtxbuf, rxtxbuf.size);
-    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
-    addAVP(&rxtxbuf, sizeof(protocol), AVP_PROTOCOL_NAME, &protocol);
-
-    //send command and get reply
-    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
-    {
-        ret = (CAENRFIDErrorCodes) tmp;
-        goto exit_done;
-    }
-    //extract data
-    rxtxbuf.rpos = HEADER_LEN;
-    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
-    ret = (CAENRFIDErrorCodes)result_code;
-
-    exit_done:
-    if(rxtxbuf.memory) free(rxtxbuf.memory);
-    return (ret);
-}
-
-CAENRFIDErrorCodes CAENRFID_GetProtocol(CAENRFIDReader* reader,
-                                        CAENRFIDProtocol *Proto)
-{
-    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
-    uint16_t  cmd;
-    int16_t tmp;
-    uint16_t result_code;
-    IOBuffer_t rxtxbuf = {0};
-    uint32_t protocol;
-
-    cmd = CMD_GETPROTOCOL;
-    //build request
-    rxtxbuf.size  = HEADER_LEN;
-    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
-
-    if((rxtxbuf.memory = malloc(rxtxbuf.size)) == NULL) return CAENRFID_OutOfMemoryError;
-
-    addHeader(_cmdID++, &rxtxbuf, rxtxbuf.size);
-    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
-    //send command and get reply
-    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf)) != 0)
-    {
-        ret = (CAENRFIDErrorCodes) tmp;
-        goto exit_done;
-    }
-    //extract data
-    rxtxbuf.rpos = HEADER_LEN;
-    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
-    if((tmp = getAVP(&rxtxbuf, AVP_PROTOCOL_NAME, &protocol)) < 0) goto exit_done;
-    else if(tmp == 0) *Proto = (CAENRFIDProtocol) protocol;
-    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
-    ret = (CAENRFIDErrorCodes)result_code;
-
-    exit_done:
-    if(rxtxbuf.memory) free(rxtxbuf.memory);
-    return (ret);
-}
-
-CAENRFIDErrorCodes CAENRFID_SetPower(CAENRFIDReader* reader,
-                                     uint32_t Power)
-{
-    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
-    uint16_t  cmd;
-    int16_t tmp;
-    uint16_t result_code;
-    IOBuffer_t rxtxbuf = {0};
-
-    cmd = CMD_SETPOWER;
-    //build request
-    rxtxbuf.size  = HEADER_LEN;
-    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
-    rxtxbuf.size += sizeAVP(AVP_POWER, sizeof(Power));
-
-    if((rxtxbuf.memory = malloc(rxtxbuf.size)) == NULL) return CAENRFID_OutOfMemoryError;
-
-    addHeader(_cmdID++, &rxtxbuf, rxtxbuf.size);
-    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
-    addAVP(&rxtxbuf, sizeof(Power), AVP_POWER, &Power);
-
-    //send command and get reply
-    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
-    {
-        ret = (CAENRFIDErrorCodes) tmp;
-        goto exit_done;
-    }
-    //extract data
-    rxtxbuf.rpos = HEADER_LEN;
-    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
-    ret = (CAENRFIDErrorCodes)result_code;
-
-    exit_done:
-    if(rxtxbuf.memory) free(rxtxbuf.memory);
-    return (ret);
-}
-
-CAENRFIDErrorCodes CAENRFID_GetPower(CAENRFIDReader* reader,
-                                     uint32_t *Power)
-{
-    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
-    uint16_t  cmd;
-    int16_t tmp;
-    uint16_t result_code;
-    IOBuffer_t rxtxbuf = {0};
-
-    cmd = CMD_GETPOWER;
-    //build request
-    rxtxbuf.size  = HEADER_LEN;
-    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
-
-    if((rxtxbuf.memory = malloc(rxtxbuf.size)) == NULL) return CAENRFID_OutOfMemoryError;
-
-    addHeader(_cmdID++, &rxtxbuf, rxtxbuf.size);
-    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
-    //send command and get reply
-    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf)) != 0)
-    {
-        ret = (CAENRFIDErrorCodes) tmp;
-        goto exit_done;
-    }
-    //extract data
-    rxtxbuf.rpos = HEADER_LEN;
-    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_POWER_GET, Power) < 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
-    ret = (CAENRFIDErrorCodes) result_code;
-
-    exit_done:
-    if(rxtxbuf.memory) free(rxtxbuf.memory);
-    return (ret);
-}
-
-CAENRFIDErrorCodes CAENRFID_AddReadPoint(CAENRFIDReader* reader,
-                                         char *SourceName,
-                                         char *ReadPoint)
-{
-    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
-    uint16_t  cmd;
-    int16_t tmp;
-    uint16_t result_code;
-    IOBuffer_t rxtxbuf = {0};
-
-    cmd = CMD_ADDREADPOINT;
-    //build request
-    rxtxbuf.size  = HEADER_LEN;
-    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
-    rxtxbuf.size += sizeAVP(AVP_SOURCE_NAME, strlen(SourceName) + 1);
-    rxtxbuf.size += sizeAVP(AVP_READPOINT_NAME, strlen(ReadPoint) + 1);
-
-    if((rxtxbuf.memory = malloc(rxtxbuf.size)) == NULL) return CAENRFID_OutOfMemoryError;
-
-    addHeader(_cmdID++, &rxtxbuf, rxtxbuf.size);
-    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
-    addAVP(&rxtxbuf, (uint16_t)strlen(SourceName) + 1, AVP_SOURCE_NAME, SourceName);
-    addAVP(&rxtxbuf, (uint16_t)strlen(ReadPoint) + 1, AVP_READPOINT_NAME, ReadPoint);
-    //send command and get reply
-    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf)) != 0)
-    {
-        ret = (CAENRFIDErrorCodes) tmp;
-        goto exit_done;
-    }
-    //extract data
-    rxtxbuf.rpos = HEADER_LEN;
-    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
-    ret = (CAENRFIDErrorCodes) result_code;
-
-    exit_done:
-    if(rxtxbuf.memory) free(rxtxbuf.memory);
-    return (ret);
-}
-
-CAENRFIDErrorCodes CAENRFID_RemoveReadPoint(CAENRFIDReader* reader,
-                                            char *SourceName,
-                                            char *ReadPoint)
-{
-    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
-    uint16_t  cmd;
-    int16_t tmp;
-    uint16_t result_code;
-    IOBuffer_t rxtxbuf = {0};
-
-    cmd = CMD_REMREADPOINT;
-    //build request
-    rxtxbuf.size  = HEADER_LEN;
-    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
-    rxtxbuf.size += sizeAVP(AVP_SOURCE_NAME, strlen(SourceName) + 1);
-    rxtxbuf.size += sizeAVP(AVP_READPOINT_NAME, strlen(ReadPoint) + 1);
-
-    if((rxtxbuf.memory = malloc(rxtxbuf.size)) == NULL) return CAENRFID_OutOfMemoryError;
-
-    addHeader(_cmdID++, &rxtxbuf, rxtxbuf.size);
-    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
-    addAVP(&rxtxbuf, (uint16_t)strlen(SourceName) + 1, AVP_SOURCE_NAME, SourceName);
-    addAVP(&rxtxbuf, (uint16_t)strlen(ReadPoint) + 1, AVP_READPOINT_NAME, ReadPoint);
-    //send command and get reply
-    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf)) != 0)
-    {
-        ret = (CAENRFIDErrorCodes) tmp;
-        goto exit_done;
-    }
-    //extract data
-    rxtxbuf.rpos = HEADER_LEN;
-    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
-    ret = (CAENRFIDErrorCodes)result_code;
-
-    exit_done:
-    if(rxtxbuf.memory) free(rxtxbuf.memory);
-    return (ret);
-}
-
-CAENRFIDErrorCodes CAENRFID_isReadPointPresent(CAENRFIDReader* reader,
-                                               char* ReadPoint,
-                                               char* SourceName,
-                                               uint16_t* isPresent)
-{
-    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
-    uint16_t  cmd;
-    int16_t tmp;
-    uint16_t result_code;
-    IOBuffer_t rxtxbuf = {0};
-
-    cmd = CMD_CHECKRPINSRC;
-    //build request
-    rxtxbuf.size  = HEADER_LEN;
-    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
-    rxtxbuf.size += sizeAVP(AVP_READPOINT_NAME, strlen(ReadPoint) + 1);
-    rxtxbuf.size += sizeAVP(AVP_SOURCE_NAME, strlen(SourceName) + 1);
-
-    if((rxtxbuf.memory = malloc(rxtxbuf.size)) == NULL) return CAENRFID_OutOfMemoryError;
-
-    addHeader(_cmdID++, &rxtxbuf, rxtxbuf.size);
-    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
-    addAVP(&rxtxbuf, (uint16_t)strlen(ReadPoint) + 1, AVP_READPOINT_NAME, ReadPoint);
-    addAVP(&rxtxbuf, (uint16_t)strlen(SourceName) + 1, AVP_SOURCE_NAME, SourceName);
-    //send command and get reply
-    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf)) != 0)
-    {
-        ret = (CAENRFIDErrorCodes) tmp;
-        goto exit_done;
-    }
-    //extract data
-    rxtxbuf.rpos = HEADER_LEN;
-    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_BOOLEAN, isPresent) < 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
-    ret = (CAENRFIDErrorCodes)result_code;
-
-    exit_done:
-    if(rxtxbuf.memory) free(rxtxbuf.memory);
-    return (ret);
-}
-
-CAENRFIDErrorCodes CAENRFID_GetReadPointStatus(CAENRFIDReader* reader,
-                                               char* ReadPoint,
-                                               CAENRFIDReadPointStatus* Status)
-{
-    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
-    uint16_t  cmd;
-    int16_t tmp;
-    uint16_t result_code;
-    IOBuffer_t rxtxbuf = {0};
-    uint32_t status;
-
-    cmd = CMD_CHECKANTENNA;
-    //build request
-    rxtxbuf.size  = HEADER_LEN;
-    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
-    rxtxbuf.size += sizeAVP(AVP_READPOINT_NAME, strlen(ReadPoint) + 1);
-
-    if((rxtxbuf.memory = malloc(rxtxbuf.size)) == NULL) return CAENRFID_OutOfMemoryError;
-
-    addHeader(_cmdID++, &rxtxbuf, rxtxbuf.size);
-    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
-    addAVP(&rxtxbuf, (uint16_t)strlen(ReadPoint) + 1, AVP_READPOINT_NAME, ReadPoint);
-    //send command and get reply
-    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf)) != 0)
-    {
-        ret = (CAENRFIDErrorCodes) tmp;
-        goto exit_done;
-    }
-    //extract data
-    rxtxbuf.rpos = HEADER_LEN;
-    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
-    if((tmp = getAVP(&rxtxbuf, AVP_READPOINT_STATUS, &status)) < 0) goto exit_done;
-    else if(tmp == 0) *Status = (CAENRFIDReadPointStatus) status;
-    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
-    ret = (CAENRFIDErrorCodes)result_code;
-
-    exit_done:
-    if(rxtxbuf.memory) free(rxtxbuf.memory);
-    return (ret);
-}
-
-CAENRFIDErrorCodes CAENRFID_MatchReadPointImpedance(CAENRFIDReader* reader,
-                                                    char* ReadPoint,
-                                                    float* value)
-{
-    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
-    uint16_t  cmd;
-    int16_t tmp;
-    uint16_t result_code;
-    IOBuffer_t rxtxbuf = { 0 };
-    uint32_t param = RPCMATCHRFALG, param_value = 0;
-
-    cmd = CMD_MATCHRFIMPEDANCE;
-    //build request
-    rxtxbuf.size = HEADER_LEN;
-    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
-    rxtxbuf.size += sizeAVP(AVP_READPOINT_NAME, strlen(ReadPoint) + 1);
-    rxtxbuf.size += sizeAVP(AVP_CONFIGPARAMETER, sizeof(param));
-    rxtxbuf.size += sizeAVP(AVP_CONFIGVALUE, sizeof(param_value));
-
-    if((rxtxbuf.memory = malloc(rxtxbuf.size)) == NULL) return CAENRFID_OutOfMemoryError;
-
-    addHeader(_cmdID++, &rxtxbuf, rxtxbuf.size);
-    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
-    addAVP(&rxtxbuf, (uint16_t)strlen(ReadPoint) + 1, AVP_READPOINT_NAME, ReadPoint);
-    addAVP(&rxtxbuf, sizeof(param), AVP_CONFIGPARAMETER, &param);
-    addAVP(&rxtxbuf, sizeof(param_value), AVP_CONFIGVALUE, &param_value);
-    //send command and get reply
-    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf)) != 0)
-    {
-        ret = (CAENRFIDErrorCodes)tmp;
-        goto exit_done;
-    }
-    //extract data
-    rxtxbuf.rpos = HEADER_LEN;
-    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_POWER_VSWR, value) < 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
-    ret = (CAENRFIDErrorCodes)result_code;
-
-exit_done:
-    if(rxtxbuf.memory) free(rxtxbuf.memory);
-    return (ret);
-}
-
-CAENRFIDErrorCodes CAENRFID_SetSourceConfiguration(CAENRFIDReader* reader,
-                                                   char* SourceName,
-                                                   CAENRFID_SOURCE_Parameter Parameter,
-                                                   uint32_t Value)
-{
-    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
-    uint16_t  cmd;
-    int16_t tmp;
-    uint16_t result_code;
-    IOBuffer_t rxtxbuf = {0};
-    uint32_t parameter = Parameter;
-
-    cmd = CMD_SETSRCCONF;
-    //build request
-    rxtxbuf.size  = HEADER_LEN;
-    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
-    rxtxbuf.size += sizeAVP(AVP_SOURCE_NAME, strlen(SourceName) + 1);
-    rxtxbuf.size += sizeAVP(AVP_CONFIGPARAMETER, sizeof(parameter));
-    rxtxbuf.size += sizeAVP(AVP_CONFIGVALUE, sizeof(Value));
-
-    if((rxtxbuf.memory = malloc(rxtxbuf.size)) == NULL) return CAENRFID_OutOfMemoryError;
-
-    addHeader(_cmdID++, &rxtxbuf, rxtxbuf.size);
-    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
-    addAVP(&rxtxbuf, (uint16_t)strlen(SourceName) + 1, AVP_SOURCE_NAME, SourceName);
-    addAVP(&rxtxbuf, sizeof(parameter), AVP_CONFIGPARAMETER, &parameter);
-    addAVP(&rxtxbuf, sizeof(Value), AVP_CONFIGVALUE, &Value);
-    //send command and get reply
-    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
-    {
-        ret = (CAENRFIDErrorCodes) tmp;
-        goto exit_done;
-    }
-    //extract data
-    rxtxbuf.rpos = HEADER_LEN;
-    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
-    ret = (CAENRFIDErrorCodes)result_code;
-
-    exit_done:
-    if(rxtxbuf.memory) free(rxtxbuf.memory);
-    return (ret);
-}
-
-CAENRFIDErrorCodes CAENRFID_GetSourceConfiguration(CAENRFIDReader* reader,
-                                                   char* SourceName,
-                                                   CAENRFID_SOURCE_Parameter Parameter,
-                                                   uint32_t* Value)
-{
-    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
-    uint16_t  cmd;
-    int16_t tmp;
-    uint16_t result_code;
-    IOBuffer_t rxtxbuf = {0};
-    uint32_t parameter = Parameter;
-
-    cmd = CMD_GETSRCCONF;
-    //build request
-    rxtxbuf.size  = HEADER_LEN;
-    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
-    rxtxbuf.size += sizeAVP(AVP_SOURCE_NAME, strlen(SourceName) + 1);
-    rxtxbuf.size += sizeAVP(AVP_CONFIGPARAMETER, sizeof(parameter));
-
-    if((rxtxbuf.memory = malloc(rxtxbuf.size)) == NULL) return CAENRFID_OutOfMemoryError;
-
-    addHeader(_cmdID++, &rxtxbuf, rxtxbuf.size);
-    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
-    addAVP(&rxtxbuf, (uint16_t)strlen(SourceName) + 1, AVP_SOURCE_NAME, SourceName);
-    addAVP(&rxtxbuf, sizeof(parameter), AVP_CONFIGPARAMETER, &parameter);
-    //send command and get reply
-    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
-    {
-        ret = (CAENRFIDErrorCodes) tmp;
-        goto exit_done;
-    }
-    //extract data
-    rxtxbuf.rpos = HEADER_LEN;
-    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_CONFIGVALUE, Value) < 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
-    ret = (CAENRFIDErrorCodes)result_code;
-
-    exit_done:
-    if(rxtxbuf.memory) free(rxtxbuf.memory);
-    return (ret);
-}
-
-CAENRFIDErrorCodes CAENRFID_SetRS232(CAENRFIDReader* reader,
-                                     uint32_t Baudrate,
-                                     uint32_t DataBits,
-                                     uint32_t StopBits,
-                                     CAENRFID_RS232_Parity Parity,
-                                     CAENRFID_RS232_FlowControl FlowControl)
-{
-    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
-    uint16_t  cmd;
-    int16_t tmp;
-    uint16_t result_code;
-    IOBuffer_t rxtxbuf = {0};
-    uint32_t parity = Parity, flowctrl = FlowControl;
-
-    cmd = CMD_SETRS232;
-    //build request
-    rxtxbuf.size  = HEADER_LEN;
-    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
-    rxtxbuf.size += sizeAVP(AVP_BAUDRATE, sizeof(Baudrate));
-    rxtxbuf.size += sizeAVP(AVP_DATABITS, sizeof(DataBits));
-    rxtxbuf.size += sizeAVP(AVP_STOPBITS, sizeof(StopBits));
-    rxtxbuf.size += sizeAVP(AVP_PARITY, sizeof(parity));
-    rxtxbuf.size += sizeAVP(AVP_FLOWCTRL, sizeof(flowctrl));
-
-    if((rxtxbuf.memory = malloc(rxtxbuf.size)) == NULL) return CAENRFID_OutOfMemoryError;
-
-    addHeader(_cmdID++, &rxtxbuf, rxtxbuf.size);
-    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
-    addAVP(&rxtxbuf, sizeof(Baudrate), AVP_BAUDRATE, &Baudrate);
-    addAVP(&rxtxbuf, sizeof(DataBits), AVP_DATABITS, &DataBits);
-    addAVP(&rxtxbuf, sizeof(StopBits), AVP_STOPBITS, &StopBits);
-    addAVP(&rxtxbuf, sizeof(parity), AVP_PARITY, &parity);
-    addAVP(&rxtxbuf, sizeof(flowctrl), AVP_FLOWCTRL, &flowctrl);
-    //send command and get reply
-    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
-    {
-        ret = (CAENRFIDErrorCodes) tmp;
-        goto exit_done;
-    }
-    //extract data
-    rxtxbuf.rpos = HEADER_LEN;
-    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
-    ret = (CAENRFIDErrorCodes)result_code;
-
-    exit_done:
-    if(rxtxbuf.memory) free(rxtxbuf.memory);
-    return (ret);
-}
-
-CAENRFIDErrorCodes CAENRFID_SetBitrate(CAENRFIDReader* reader,
-                                       CAENRFID_Bitrate Bitrate)
-{
-    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
-    uint16_t  cmd;
-    int16_t tmp;
-    uint16_t result_code;
-    IOBuffer_t rxtxbuf = {0};
-    uint16_t bitrate = Bitrate;
-
-    cmd = CMD_SETRFLINKPROFILE;
-    //build request
-    rxtxbuf.size  = HEADER_LEN;
-    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
-    rxtxbuf.size += sizeAVP(AVP_MODULATION, sizeof(bitrate));
-
-    if((rxtxbuf.memory = malloc(rxtxbuf.size)) == NULL) return CAENRFID_OutOfMemoryError;
-
-    addHeader(_cmdID++, &rxtxbuf, rxtxbuf.size);
-    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
-    addAVP(&rxtxbuf, sizeof(bitrate), AVP_MODULATION, &bitrate);
-
-    //send command and get reply
-    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
-    {
-        ret = (CAENRFIDErrorCodes) tmp;
-        goto exit_done;
-    }
-    //extract data
-    rxtxbuf.rpos = HEADER_LEN;
-    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
-    ret = (CAENRFIDErrorCodes)result_code;
-
-    exit_done:
-    if(rxtxbuf.memory) free(rxtxbuf.memory);
-    return (ret);
-}
-
-CAENRFIDErrorCodes CAENRFID_GetBitrate(CAENRFIDReader* reader,
-                                       CAENRFID_Bitrate* Bitrate)
-{
-    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
-    uint16_t  cmd;
-    int16_t tmp;
-    uint16_t result_code;
-    IOBuffer_t rxtxbuf = {0};
-    uint16_t bitrate;
-
-    cmd = CMD_GETRFLINKPROFILE;
-    //build request
-    rxtxbuf.size  = HEADER_LEN;
-    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
-
-    if((rxtxbuf.memory = malloc(rxtxbuf.size)) == NULL) return CAENRFID_OutOfMemoryError;
-
-    addHeader(_cmdID++, &rxtxbuf, rxtxbuf.size);
-    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
-
-    //send command and get reply
-    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
-    {
-        ret = (CAENRFIDErrorCodes) tmp;
-        goto exit_done;
-    }
-    //extract data
-    rxtxbuf.rpos = HEADER_LEN;
-    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
-    if((tmp = getAVP(&rxtxbuf, AVP_MODULATION, &bitrate)) < 0) goto exit_done;
-    else if(tmp == 0) *Bitrate = (CAENRFID_Bitrate) bitrate;
-    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
-    ret = (CAENRFIDErrorCodes)result_code;
-
-    exit_done:
-    if(rxtxbuf.memory) free(rxtxbuf.memory);
-    return (ret);
-}
-
-CAENRFIDErrorCodes CAENRFID_SetFHSSMode(CAENRFIDReader* reader,
-                                        uint16_t FHSSMode)
-{
-    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
-    uint16_t  cmd;
-    int16_t tmp;
-    uint16_t result_code;
-    IOBuffer_t rxtxbuf = {0};
-
-    cmd = CMD_SETFHMODE;
-    //build request
-    rxtxbuf.size  = HEADER_LEN;
-    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
-    rxtxbuf.size += sizeAVP(AVP_BOOLEAN, sizeof(FHSSMode));
-
-    if((rxtxbuf.memory = malloc(rxtxbuf.size)) == NULL) return CAENRFID_OutOfMemoryError;
-
-    addHeader(_cmdID++, &rxtxbuf, rxtxbuf.size);
-    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
-    addAVP(&rxtxbuf, sizeof(FHSSMode), AVP_BOOLEAN, &FHSSMode);
-
-    //send command and get reply
-    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
-    {
-        ret = (CAENRFIDErrorCodes) tmp;
-        goto exit_done;
-    }
-    //extract data
-    rxtxbuf.rpos = HEADER_LEN;
-    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
-    ret = (CAENRFIDErrorCodes)result_code;
-
-    exit_done:
-    if(rxtxbuf.memory) free(rxtxbuf.memory);
-    return (ret);
-}
-
-CAENRFIDErrorCodes CAENRFID_GetFHSSMode(CAENRFIDReader* reader,
-                                        uint16_t* FHSSMode)
-{
-    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
-    uint16_t  cmd;
-    int16_t tmp;
-    uint16_t result_code;
-    IOBuffer_t rxtxbuf = {0};
-
-    cmd = CMD_GETFHMODE;
-    //build request
-    rxtxbuf.size  = HEADER_LEN;
-    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
-
-    if((rxtxbuf.memory = malloc(rxtxbuf.size)) == NULL) return CAENRFID_OutOfMemoryError;
-
-    addHeader(_cmdID++, &rxtxbuf, rxtxbuf.size);
-    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
-
-    //send command and get reply
-    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
-    {
-        ret = (CAENRFIDErrorCodes) tmp;
-        goto exit_done;
-    }
-    //extract data
-    rxtxbuf.rpos = HEADER_LEN;
-    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_BOOLEAN, FHSSMode) < 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
-    ret = (CAENRFIDErrorCodes)result_code;
-
-    exit_done:
-    if(rxtxbuf.memory) free(rxtxbuf.memory);
-    return (ret);
-}
-
-CAENRFIDErrorCodes CAENRFID_SetRFChannel(CAENRFIDReader* reader,
-                                         uint16_t RFChannel)
-{
-    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
-    uint16_t  cmd;
-    int16_t tmp;
-    uint16_t result_code;
-    IOBuffer_t rxtxbuf = {0};
-
-    cmd = CMD_SETCHANNEL;
-    //build request
-    rxtxbuf.size  = HEADER_LEN;
-    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
-    rxtxbuf.size += sizeAVP(AVP_RFCHANNEL, sizeof(RFChannel));
-
-    if((rxtxbuf.memory = malloc(rxtxbuf.size)) == NULL) return CAENRFID_OutOfMemoryError;
-
-    addHeader(_cmdID++, &rxtxbuf, rxtxbuf.size);
-    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
-    addAVP(&rxtxbuf, sizeof(RFChannel), AVP_RFCHANNEL, &RFChannel);
-
-    //send command and get reply
-    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
-    {
-        ret = (CAENRFIDErrorCodes) tmp;
-        goto exit_done;
-    }
-    //extract data
-    rxtxbuf.rpos = HEADER_LEN;
-    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
-    ret = (CAENRFIDErrorCodes)result_code;
-
-    exit_done:
-    if(rxtxbuf.memory) free(rxtxbuf.memory);
-    return (ret);
-}
-
-CAENRFIDErrorCodes CAENRFID_GetRFChannel(CAENRFIDReader* reader,
-                                         uint16_t* RFChannel)
-{
-    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
-    uint16_t  cmd;
-    int16_t tmp;
-    uint16_t result_code;
-    IOBuffer_t rxtxbuf = {0};
-
-    cmd = CMD_GETCHANNEL;
-    //build request
-    rxtxbuf.size  = HEADER_LEN;
-    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
-
-    if((rxtxbuf.memory = malloc(rxtxbuf.size)) == NULL) return CAENRFID_OutOfMemoryError;
-
-    addHeader(_cmdID++, &rxtxbuf, rxtxbuf.size);
-    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
-
-    //send command and get reply
-    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
-    {
-        ret = (CAENRFIDErrorCodes) tmp;
-        goto exit_done;
-    }
-    //extract data
-    rxtxbuf.rpos = HEADER_LEN;
-    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_RFCHANNEL, RFChannel) < 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
-    ret = (CAENRFIDErrorCodes)result_code;
-
-    exit_done:
-    if(rxtxbuf.memory) free(rxtxbuf.memory);
-    return (ret);
-}
-
-CAENRFIDErrorCodes CAENRFID_SetRFRegulation(CAENRFIDReader* reader,
-                                            CAENRFIDRFRegulations RFRegulation)
-{
-    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
-    uint16_t  cmd;
-    int16_t tmp;
-    uint16_t result_code;
-    IOBuffer_t rxtxbuf = {0};
-    uint16_t regulation = RFRegulation;
-
-    cmd = CMD_SETRFREGULATION;
-    //build request
-    rxtxbuf.size  = HEADER_LEN;
-    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
-    rxtxbuf.size += sizeAVP(AVP_RFREGULATION, sizeof(regulation));
-
-    if((rxtxbuf.memory = malloc(rxtxbuf.size)) == NULL) return CAENRFID_OutOfMemoryError;
-
-    addHeader(_cmdID++, &rxtxbuf, rxtxbuf.size);
-    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
-    addAVP(&rxtxbuf, sizeof(regulation), AVP_RFREGULATION, &regulation);
-
-    //send command and get reply
-    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
-    {
-        ret = (CAENRFIDErrorCodes) tmp;
-        goto exit_done;
-    }
-    //extract data
-    rxtxbuf.rpos = HEADER_LEN;
-    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
-    ret = (CAENRFIDErrorCodes)result_code;
-
-    exit_done:
-    if(rxtxbuf.memory) free(rxtxbuf.memory);
-    return (ret);
-}
-
-CAENRFIDErrorCodes CAENRFID_GetRFRegulation(CAENRFIDReader* reader,
-                                            CAENRFIDRFRegulations *RFRegulation)
-{
-    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
-    uint16_t  cmd;
-    int16_t tmp;
-    uint16_t result_code;
-    IOBuffer_t rxtxbuf = {0};
-    uint16_t regulation;
-
-    cmd = CMD_GETRFREGULATION;
-    //build request
-    rxtxbuf.size  = HEADER_LEN;
-    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
-
-    if((rxtxbuf.memory = malloc(rxtxbuf.size)) == NULL) return CAENRFID_OutOfMemoryError;
-
-    addHeader(_cmdID++, &rxtxbuf, rxtxbuf.size);
-    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
-
-    //send command and get reply
-    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
-    {
-        ret = (CAENRFIDErrorCodes) tmp;
-        goto exit_done;
-    }
-    //extract data
-    rxtxbuf.rpos = HEADER_LEN;
-    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
-    if((tmp = getAVP(&rxtxbuf, AVP_RFREGULATION, &regulation)) < 0) goto exit_done;
-    else if(tmp == 0) *RFRegulation = (CAENRFIDRFRegulations) regulation;
-    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
-    ret = (CAENRFIDErrorCodes)result_code;
-
-    exit_done:
-    if(rxtxbuf.memory) free(rxtxbuf.memory);
-    return (ret);
-}
-
-CAENRFIDErrorCodes CAENRFID_SetIO(CAENRFIDReader* reader,
-                                  uint32_t IORegister)
-{
-    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
-    uint16_t  cmd;
-    int16_t tmp;
-    uint16_t result_code;
-    IOBuffer_t rxtxbuf = {0};
-
-    cmd = CMD_SETIO;
-    //build request
-    rxtxbuf.size  = HEADER_LEN;
-    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
-    rxtxbuf.size += sizeAVP(AVP_IOREGISTER, sizeof(IORegister));
-
-    if((rxtxbuf.memory = malloc(rxtxbuf.size)) == NULL) return CAENRFID_OutOfMemoryError;
-
-    addHeader(_cmdID++, &rxtxbuf, rxtxbuf.size);
-    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
-    addAVP(&rxtxbuf, sizeof(IORegister), AVP_IOREGISTER, &IORegister);
-
-    //send command and get reply
-    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
-    {
-        ret = (CAENRFIDErrorCodes) tmp;
-        goto exit_done;
-    }
-    //extract data
-    rxtxbuf.rpos = HEADER_LEN;
-    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
-    ret = (CAENRFIDErrorCodes)result_code;
-
-    exit_done:
-    if(rxtxbuf.memory) free(rxtxbuf.memory);
-    return (ret);
-}
-
-CAENRFIDErrorCodes CAENRFID_GetIO(CAENRFIDReader* reader,
-                                  uint32_t* IORegister)
-{
-    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
-    uint16_t  cmd;
-    int16_t tmp;
-    uint16_t result_code;
-    IOBuffer_t rxtxbuf = {0};
-
-    cmd = CMD_GETIO;
-    //build request
-    rxtxbuf.size  = HEADER_LEN;
-    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
-
-    if((rxtxbuf.memory = malloc(rxtxbuf.size)) == NULL) return CAENRFID_OutOfMemoryError;
-
-    addHeader(_cmdID++, &rxtxbuf, rxtxbuf.size);
-    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
-
-    //send command and get reply
-    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
-    {
-        ret = (CAENRFIDErrorCodes) tmp;
-        goto exit_done;
-    }
-    //extract data
-    rxtxbuf.rpos = HEADER_LEN;
-    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_IOREGISTER, IORegister) < 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
-    ret = (CAENRFIDErrorCodes)result_code;
-
-    exit_done:
-    if(rxtxbuf.memory) free(rxtxbuf.memory);
-    return (ret);
-}
-
-CAENRFIDErrorCodes CAENRFID_SetIODirection(CAENRFIDReader* reader,
-                                           uint32_t IODirection)
-{
-    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
-    uint16_t  cmd;
-    int16_t tmp;
-    uint16_t result_code;
-    IOBuffer_t rxtxbuf = {0};
-
-    cmd = CMD_SETIODIR;
-    //build request
-    rxtxbuf.size  = HEADER_LEN;
-    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
-    rxtxbuf.size += sizeAVP(AVP_IOREGISTER, sizeof(IODirection));
-
-    if((rxtxbuf.memory = malloc(rxtxbuf.size)) == NULL) return CAENRFID_OutOfMemoryError;
-
-    addHeader(_cmdID++, &rxtxbuf, rxtxbuf.size);
-    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
-    addAVP(&rxtxbuf, sizeof(IODirection), AVP_IOREGISTER, &IODirection);
-
-    //send command and get reply
-    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
-    {
-        ret = (CAENRFIDErrorCodes) tmp;
-        goto exit_done;
-    }
-    //extract data
-    rxtxbuf.rpos = HEADER_LEN;
-    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
-    ret = (CAENRFIDErrorCodes)result_code;
-
-    exit_done:
-    if(rxtxbuf.memory) free(rxtxbuf.memory);
-    return (ret);
-}
-
-CAENRFIDErrorCodes CAENRFID_GetIODirection(CAENRFIDReader* reader,
-                                           uint32_t* IODirection)
-{
-    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
-    uint16_t  cmd;
-    int16_t tmp;
-    uint16_t result_code;
-    IOBuffer_t rxtxbuf = {0};
-
-    cmd = CMD_GETIODIR;
-    //build request
-    rxtxbuf.size  = HEADER_LEN;
-    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
-
-    if((rxtxbuf.memory = malloc(rxtxbuf.size)) == NULL) return CAENRFID_OutOfMemoryError;
-
-    addHeader(_cmdID++, &rxtxbuf, rxtxbuf.size);
-    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
-
-    //send command and get reply
-    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
-    {
-        ret = (CAENRFIDErrorCodes) tmp;
-        goto exit_done;
-    }
-    //extract data
-    rxtxbuf.rpos = HEADER_LEN;
-    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_IOREGISTER, IODirection) < 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
-    ret = (CAENRFIDErrorCodes)result_code;
-
-    exit_done:
-    if(rxtxbuf.memory) free(rxtxbuf.memory);
-    return (ret);
-}
-
-CAENRFIDErrorCodes CAENRFID_ReadTagData_EPC_C1G2(CAENRFIDReader* reader,
-                                                 CAENRFIDTag* Tag,
-                                                 uint16_t Bank,
-                                                 uint16_t ByteAddress,
-                                                 uint16_t ByteLength,
-                                                 uint8_t* Data,
-                                                 uint32_t AccessPassword)
-{
-    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
-    uint16_t  cmd;
-    int16_t tmp;
-    uint16_t result_code;
-    IOBuffer_t rxtxbuf = {0};
-
-    cmd = CMD_G2READ;
-    //build request
-    rxtxbuf.size  = HEADER_LEN;
-    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
-    rxtxbuf.size += sizeAVP(AVP_SOURCE_NAME, strlen(Tag->LogicalSource) + 1);
-    rxtxbuf.size += sizeAVP(AVP_TAGIDLEN, sizeof(Tag->Length));
-    rxtxbuf.size += sizeAVP(AVP_TAGID, Tag->Length);
-    rxtxbuf.size += sizeAVP(AVP_MEMBANK, sizeof(Bank));
-    rxtxbuf.size += sizeAVP(AVP_TAGADDRESS, sizeof(ByteAddress));
-    rxtxbuf.size += sizeAVP(AVP_LENGTH, sizeof(ByteLength));
-    if(AccessPassword != 0)
-    {
-        rxtxbuf.size += sizeAVP(AVP_G2PWD, sizeof(AccessPassword));
-    }
-
-    if((rxtxbuf.memory = malloc(rxtxbuf.size)) == NULL) return CAENRFID_OutOfMemoryError;
-
-    addHeader(_cmdID++, &rxtxbuf, rxtxbuf.size);
-    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
-    addAVP(&rxtxbuf, (uint16_t)strlen(Tag->LogicalSource) + 1, AVP_SOURCE_NAME, Tag->LogicalSource);
-    addAVP(&rxtxbuf, sizeof(Tag->Length), AVP_TAGIDLEN, &Tag->Length);
-    addAVP(&rxtxbuf, Tag->Length, AVP_TAGID, Tag->ID);
-    addAVP(&rxtxbuf, sizeof(Bank), AVP_MEMBANK, &Bank);
-    addAVP(&rxtxbuf, sizeof(ByteAddress), AVP_TAGADDRESS, &ByteAddress);
-    addAVP(&rxtxbuf, sizeof(ByteLength), AVP_LENGTH, &ByteLength);
-    if(AccessPassword != 0)
-    {
-        addAVP(&rxtxbuf, sizeof(AccessPassword), AVP_G2PWD, &AccessPassword);
-    }
-    //send command and get reply
-    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf)) != 0)
-    {
-        ret = (CAENRFIDErrorCodes) tmp;
-        goto exit_done;
-    }
-    //extract data
-    rxtxbuf.rpos = HEADER_LEN;
-    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_TAG_VALUE, Data) < 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
-    ret = (CAENRFIDErrorCodes)result_code;
-
-    exit_done:
-    if(rxtxbuf.memory) free(rxtxbuf.memory);
-    return (ret);
-}
-
-CAENRFIDErrorCodes CAENRFID_WriteTagData_EPC_C1G2(CAENRFIDReader* reader,
-                                                  CAENRFIDTag* Tag,
-                                                  uint16_t Bank,
-                                                  uint16_t ByteAddress,
-                                                  uint16_t ByteLength,
-                                                  uint8_t* Data,
-                                                  uint32_t AccessPassword)
-{
-    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
-    uint16_t  cmd;
-    int16_t tmp;
-    uint16_t result_code;
-    IOBuffer_t rxtxbuf = {0};
-
-    cmd = CMD_G2WRITE;
-    //build request
-    rxtxbuf.size  = HEADER_LEN;
-    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
-    rxtxbuf.size += sizeAVP(AVP_SOURCE_NAME, strlen(Tag->LogicalSource) + 1);
-    rxtxbuf.size += sizeAVP(AVP_TAGIDLEN, sizeof(Tag->Length));
-    rxtxbuf.size += sizeAVP(AVP_TAGID, Tag->Length);
-    rxtxbuf.size += sizeAVP(AVP_MEMBANK, sizeof(Bank));
-    rxtxbuf.size += sizeAVP(AVP_TAGADDRESS, sizeof(ByteAddress));
-    rxtxbuf.size += sizeAVP(AVP_LENGTH, sizeof(ByteLength));
-    rxtxbuf.size += sizeAVP(AVP_TAG_VALUE, ByteLength);
-    if(AccessPassword != 0)
-    {
-        rxtxbuf.size += sizeAVP(AVP_G2PWD, sizeof(AccessPassword));
-    }
-
-    if((rxtxbuf.memory = malloc(rxtxbuf.size)) == NULL) return CAENRFID_OutOfMemoryError;
-
-    addHeader(_cmdID++, &rxtxbuf, rxtxbuf.size);
-    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
-    addAVP(&rxtxbuf, (uint16_t)strlen(Tag->LogicalSource) + 1, AVP_SOURCE_NAME, Tag->LogicalSource);
-    addAVP(&rxtxbuf, sizeof(Tag->Length), AVP_TAGIDLEN, &Tag->Length);
-    addAVP(&rxtxbuf, Tag->Length, AVP_TAGID, Tag->ID);
-    addAVP(&rxtxbuf, sizeof(Bank), AVP_MEMBANK, &Bank);
-    addAVP(&rxtxbuf, sizeof(ByteAddress), AVP_TAGADDRESS, &ByteAddress);
-    addAVP(&rxtxbuf, sizeof(ByteLength), AVP_LENGTH, &ByteLength);
-    addAVP(&rxtxbuf, ByteLength, AVP_TAG_VALUE, Data);
-    if(AccessPassword != 0)
-    {
-        addAVP(&rxtxbuf, sizeof(AccessPassword), AVP_G2PWD, &AccessPassword);
-    }
-    //send command and get reply
-    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf)) != 0)
-    {
-        ret = (CAENRFIDErrorCodes) tmp;
-        goto exit_done;
-    }
-    //extract data
-    rxtxbuf.rpos = HEADER_LEN;
-    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
-    ret = (CAENRFIDErrorCodes)result_code;
-
-    exit_done:
-    if(rxtxbuf.memory) free(rxtxbuf.memory);
-    return (ret);
-}
-
-CAENRFIDErrorCodes CAENRFID_LockTag_EPC_C1G2(CAENRFIDReader* reader,
-                                             CAENRFIDTag *Tag,
-                                             uint32_t Payload,
-                                             uint32_t AccessPassword)
-{
-    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
-    uint16_t  cmd;
-    int16_t tmp;
-    uint16_t result_code;
-    IOBuffer_t rxtxbuf = {0};
-
-    cmd = CMD_G2LOCK;
-    //build request
-    rxtxbuf.size  = HEADER_LEN;
-    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
-    rxtxbuf.size += sizeAVP(AVP_SOURCE_NAME, strlen(Tag->LogicalSource) + 1);
-    rxtxbuf.size += sizeAVP(AVP_TAGIDLEN, sizeof(Tag->Length));
-    rxtxbuf.size += sizeAVP(AVP_TAGID, Tag->Length);
-    rxtxbuf.size += sizeAVP(AVP_PAYLOAD, sizeof(Payload));
-    if(AccessPassword != 0)
-    {
-        rxtxbuf.size += sizeAVP(AVP_G2PWD, sizeof(AccessPassword));
-    }
-
-    if((rxtxbuf.memory = malloc(rxtxbuf.size)) == NULL) return CAENRFID_OutOfMemoryError;
-
-    addHeader(_cmdID++, &rxtxbuf, rxtxbuf.size);
-    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
-    addAVP(&rxtxbuf, (uint16_t)strlen(Tag->LogicalSource) + 1, AVP_SOURCE_NAME, Tag->LogicalSource);
-    addAVP(&rxtxbuf, sizeof(Tag->Length), AVP_TAGIDLEN, &Tag->Length);
-    addAVP(&rxtxbuf, Tag->Length, AVP_TAGID, Tag->ID);
-    addAVP(&rxtxbuf, sizeof(Payload), AVP_PAYLOAD, &Payload);
-    if(AccessPassword != 0)
-    {
-        addAVP(&rxtxbuf, sizeof(AccessPassword), AVP_G2PWD, &AccessPassword);
-    }
-    //send command and get reply
-    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf)) != 0)
-    {
-        ret = (CAENRFIDErrorCodes) tmp;
-        goto exit_done;
-    }
-    //extract data
-    rxtxbuf.rpos = HEADER_LEN;
-    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
-    ret = (CAENRFIDErrorCodes)result_code;
-
-    exit_done:
-    if(rxtxbuf.memory) free(rxtxbuf.memory);
-    return (ret);
-}
-
-CAENRFIDErrorCodes CAENRFID_KillTag_EPC_C1G2(CAENRFIDReader* reader,
-                                             CAENRFIDTag *Tag,
-                                             uint32_t Password)
-{
-    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
-    uint16_t  cmd;
-    int16_t tmp;
-    uint16_t result_code;
-    IOBuffer_t rxtxbuf = {0};
-
-    cmd = CMD_G2KILL;
-    //build request
-    rxtxbuf.size  = HEADER_LEN;
-    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
-    rxtxbuf.size += sizeAVP(AVP_SOURCE_NAME, strlen(Tag->LogicalSource) + 1);
-    rxtxbuf.size += sizeAVP(AVP_TAGIDLEN, sizeof(Tag->Length));
-    rxtxbuf.size += sizeAVP(AVP_TAGID, Tag->Length);
-    rxtxbuf.size += sizeAVP(AVP_G2PWD, sizeof(Password));
-
-    if((rxtxbuf.memory = malloc(rxtxbuf.size)) == NULL) return CAENRFID_OutOfMemoryError;
-
-    addHeader(_cmdID++, &rxtxbuf, rxtxbuf.size);
-    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
-    addAVP(&rxtxbuf, (uint16_t)strlen(Tag->LogicalSource) + 1, AVP_SOURCE_NAME, Tag->LogicalSource);
-    addAVP(&rxtxbuf, sizeof(Tag->Length), AVP_TAGIDLEN, &Tag->Length);
-    addAVP(&rxtxbuf, Tag->Length, AVP_TAGID, Tag->ID);
-    addAVP(&rxtxbuf, sizeof(Password), AVP_G2PWD, &Password);
-
-    //send command and get reply
-    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf)) != 0)
-    {
-        ret = (CAENRFIDErrorCodes) tmp;
-        goto exit_done;
-    }
-    //extract data
-    rxtxbuf.rpos = HEADER_LEN;
-    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
-    ret = (CAENRFIDErrorCodes)result_code;
-
-    exit_done:
-    if(rxtxbuf.memory) free(rxtxbuf.memory);
-    return (ret);
-}
-
-CAENRFIDErrorCodes CAENRFID_ProgramID_EPC_C1G2(CAENRFIDReader* reader,
-                                               CAENRFIDTag *Tag,
-                                               uint16_t nsi,
-                                               uint32_t AccessPassword)
-{
-    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
-    uint16_t  cmd;
-    int16_t tmp;
-    uint16_t result_code;
-    IOBuffer_t rxtxbuf = {0};
-
-    cmd = CMD_G2PROGRAMID;
-    //build request
-    rxtxbuf.size  = HEADER_LEN;
-    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
-    rxtxbuf.size += sizeAVP(AVP_SOURCE_NAME, strlen(Tag->LogicalSource) + 1);
-    rxtxbuf.size += sizeAVP(AVP_TAGIDLEN, sizeof(Tag->Length));
-    rxtxbuf.size += sizeAVP(AVP_TAGID, Tag->Length);
-    rxtxbuf.size += sizeAVP(AVP_G2NSI, sizeof(nsi));
-    if(AccessPassword != 0)
-    {
-        rxtxbuf.size += sizeAVP(AVP_G2PWD, sizeof(AccessPassword));
-    }
-
-    if((rxtxbuf.memory = malloc(rxtxbuf.size)) == NULL) return CAENRFID_OutOfMemoryError;
-
-    addHeader(_cmdID++, &rxtxbuf, rxtxbuf.size);
-    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
-    addAVP(&rxtxbuf, (uint16_t)strlen(Tag->LogicalSource) + 1, AVP_SOURCE_NAME, Tag->LogicalSource);
-    addAVP(&rxtxbuf, sizeof(Tag->Length), AVP_TAGIDLEN, &Tag->Length);
-    addAVP(&rxtxbuf, Tag->Length, AVP_TAGID, Tag->ID);
-    addAVP(&rxtxbuf, sizeof(nsi), AVP_G2NSI, &nsi);
-    if(AccessPassword != 0)
-    {
-        addAVP(&rxtxbuf, sizeof(AccessPassword), AVP_G2PWD, &AccessPassword);
-    }
-    //send command and get reply
-    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf)) != 0)
-    {
-        ret = (CAENRFIDErrorCodes) tmp;
-        goto exit_done;
-    }
-    //extract data
-    rxtxbuf.rpos = HEADER_LEN;
-    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
-    ret = (CAENRFIDErrorCodes)result_code;
-
-    exit_done:
-    if(rxtxbuf.memory) free(rxtxbuf.memory);
-    return (ret);
-}
-
-CAENRFIDErrorCodes CAENRFID_CustomCommand_EPC_C1G2(CAENRFIDReader* reader,
-                                                   CAENRFIDTag *Tag,
-                                                   uint8_t SubCmd,
-                                                   uint16_t TxLen,
-                                                   uint8_t *Data,
-                                                   uint16_t RxLen,
-                                                   uint32_t AccessPassword,
-                                                   uint8_t *TRData)
-{
-    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
-    uint16_t  cmd;
-    int16_t tmp;
-    uint16_t result_code;
-    IOBuffer_t rxtxbuf = { 0 };
-
-    cmd = CMD_G2CUSTOM;
-    //build request
-    rxtxbuf.size = HEADER_LEN;
-    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
-    if(Tag != NULL)
-    {
-        rxtxbuf.size += sizeAVP(AVP_SOURCE_NAME, strlen(Tag->LogicalSource) + 1);
-        rxtxbuf.size += sizeAVP(AVP_TAGIDLEN, sizeof(Tag->Length));
-        rxtxbuf.size += sizeAVP(AVP_TAGID, Tag->Length);
-    }
-    rxtxbuf.size += sizeAVP(AVP_SUBCMD, sizeof(SubCmd));
-    if(TxLen != 0)
-    {
-        rxtxbuf.size += sizeAVP(AVP_LENGTH, sizeof(TxLen));
-        rxtxbuf.size += sizeAVP(AVP_TAG_VALUE, TxLen);
-    }
-    rxtxbuf.size += sizeAVP(AVP_LENGTH, sizeof(RxLen));
-    if(AccessPassword != 0)
-    {
-        rxtxbuf.size += sizeAVP(AVP_G2PWD, sizeof(AccessPassword));
-    }
-
-    if((rxtxbuf.memory = malloc(rxtxbuf.size)) == NULL) return CAENRFID_OutOfMemoryError;
-
-    addHeader(_cmdID++, &rxtxbuf, rxtxbuf.size);
-    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
-    if(Tag != NULL)
-    {
-        addAVP(&rxtxbuf, (uint16_t)strlen(Tag->LogicalSource) + 1, AVP_SOURCE_NAME, Tag->LogicalSource);
-        addAVP(&rxtxbuf, sizeof(Tag->Length), AVP_TAGIDLEN, &Tag->Length);
-        addAVP(&rxtxbuf, Tag->Length, AVP_TAGID, Tag->ID);
-    }
-    addAVP(&rxtxbuf, 1, AVP_SUBCMD, &SubCmd);
-    if(TxLen != 0)
-    {
-        addAVP(&rxtxbuf, sizeof(TxLen), AVP_LENGTH, &TxLen);
-        addAVP(&rxtxbuf, TxLen, AVP_TAG_VALUE, Data);
-    }
-    addAVP(&rxtxbuf, sizeof(RxLen), AVP_LENGTH, &RxLen);
-    if(AccessPassword != 0)
-    {
-        addAVP(&rxtxbuf, sizeof(AccessPassword), AVP_G2PWD, &AccessPassword);
-    }
-    //send command and get reply
-    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf)) != 0)
-    {
-        ret = (CAENRFIDErrorCodes)tmp;
-        goto exit_done;
-    }
-    //extract data
-    rxtxbuf.rpos = HEADER_LEN;
-    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_TAG_VALUE, TRData) < 0) goto exit_done;
-    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
-    ret = (CAENRFIDErrorCodes)result_code;
-
-    exit_done:
-    if(rxtxbuf.memory) free(rxtxbuf.memory);
-    return (ret);
-}
-
-CAENRFIDErrorCodes CAENRFID_InventoryTag(CAENRFIDReader* reader,
-                                         char* SourceName,
-                                         uint16_t Bank,
-                                         uint16_t MaskBitAddress,
-                                         uint16_t MaskBitLength,
-                                         uint8_t* Mask,
-                                         uint16_t MaskLen,
-                                         uint16_t flag,
-                                         CAENRFIDTagList** TagList,
-                                         uint16_t* Size)
-{
-    CAENRFIDErrorCodes ret = CAENRFID_LibraryError;
-    uint16_t  cmd;
-    int16_t tmp, pos;
-    uint16_t result_code;
-    IOBuffer_t rxtxbuf = {0};
-    bool has_RSSI = false, has_compact = false, has_TID = false,
-         has_XPC = false, has_PC = false, has_event_trigger = false,
-         has_framed = false, has_continuous = false, has_mask = false;
-    CAENRFIDTagList* list_el = NULL;
-    uint16_t type = 0;
-
-    flag &= 0x017f;
-    if((flag & RSSI) == RSSI) has_RSSI =1;
-    if((flag & FRAMED) == FRAMED) has_framed = 1;
-    if((flag & CONTINUOS) == CONTINUOS) has_continuous = 1;
-    if((flag & COMPACT) == COMPACT) has_compact = 1;
-    if((flag & TID_READING) == TID_READING) has_TID = 1;
-    if((flag & EVENT_TRIGGER) == EVENT_TRIGGER) has_event_trigger = 1;
-    if((flag & XPC) == 0x40) has_XPC = 1;
-    if((flag & PC) == 0x100) has_PC = 1;
-
-    if(has_continuous != has_framed) return CAENRFID_InvalidParam;
-    if(has_event_trigger && !has_framed) return CAENRFID_InvalidParam;
-
-    if(MaskBitLength > 0 && Mask != NULL)
-    {
-        if(MaskBitLength/8 + ((MaskBitLength%8 != 0) ? 1 : 0) > MaskLen) return CAENRFID_InvalidParam;
-        has_mask = true;
-    }
-
-    cmd = CMD_INVENTORY;
-    //build request
-    rxtxbuf.size  = HEADER_LEN;
-    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
-    rxtxbuf.size += sizeAVP(AVP_SOURCE_NAME, strlen(SourceName) + 1);
-    if(has_mask)
-    {
-        rxtxbuf.size += sizeAVP(AVP_MEMBANK, sizeof(Bank));
-        rxtxbuf.size += sizeAVP(AVP_LENGTH, sizeof(MaskBitLength));
-        rxtxbuf.size += sizeAVP(AVP_TAGID, MaskLen);
-        rxtxbuf.size += sizeAVP(AVP_TAGADDRESS, sizeof(MaskBitAddress));
-    }
-    if(flag != 0)
-    {
-        rxtxbuf.size += sizeAVP(AVP_BITMASK, sizeof(flag));
-    }
-
-    if((rxtxbuf.memory = malloc(rxtxbuf.size)) == NULL) return CAENRFID_OutOfMemoryError;
-
-    addHeader(_cmdID++, &rxtxbuf, rxtxbuf.size);
-    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
-    addAVP(&rxtxbuf, (uint16_t)strlen(SourceName) + 1, AVP_SOURCE_NAME, SourceName);
-    if(has_mask)
-    {
-        addAVP(&rxtxbuf, sizeof(Bank), AVP_MEMBANK, &Bank);
-        addAVP(&rxtxbuf, sizeof(MaskBitLength), AVP_LENGTH, &MaskBitLength);
-        addAVP(&rxtxbuf, MaskLen, AVP_TAGID, Mask);
-        addAVP(&rxtxbuf, sizeof(MaskBitAddress), AVP_TAGADDRESS, &MaskBitAddress);
-    }
-    if(flag != 0)
-    {
-        addAVP(&rxtxbuf, sizeof(flag), AVP_BITMASK, &flag);
-    }
-    //send command and get reply
-    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf)) != 0)
-    {
-        ret = (CAENRFIDErrorCodes) tmp;
-        goto exit_done;
-    }
-    //extract data
-    rxtxbuf.rpos = HEADER_LEN;
-    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd)  != 0) goto exit_done;
-    if(!has_framed)
-    {
-        *Size = 0;
-        while(1)
-        {
-            if((list_el = malloc(sizeof(CAENRFIDTagList))) == NULL)
-            {
-                ret = CAENRFID_OutOfMemoryError;
-                break;
-            }
-           list_el->Next = *TagList;
-           memset(&list_el->Tag, 0, sizeof(list_el->Tag));
-           if(!has_compact)
-           {
-               if(getAVP(&rxtxbuf, AVP_SOURCE_NAME, list_el->Tag.LogicalSource) != 0) break;
-               if(getAVP(&rxtxbuf, AVP_READPOINT_NAME, list_el->Tag.ReadPoint) != 0) break;
-               if(getAVP(&rxtxbuf, AVP_TIMESTAMP, list_el->Tag.TimeStamp) != 0) break;
-               if(getAVP(&rxtxbuf, AVP_TAGTYPE, &type) != 0) break;
-               list_el->Tag.Type = (CAENRFIDProtocol) type;
-               if(getAVP(&rxtxbuf, AVP_TAGIDLEN, &(list_el->Tag.Length)) != 0) break;
-               if(getAVP(&rxtxbuf, AVP_TAGID, list_el->Tag.ID) != 0) break;
-           }
-           else
-           {
-               pos = rxtxbuf.rpos;
-               if(getAVP(&rxtxbuf, AVP_TAGID, list_el->Tag.ID) != 0) break;
-               list_el->Tag.Length = (rxtxbuf.rpos - pos) - AVP_HEADLEN;
-           }
-           if(has_RSSI)
-           {
-               if(getAVP(&rxtxbuf, AVP_RSSI, &(list_el->Tag.RSSI))  != 0) break;
-           }
-           if(has_TID)
-           {
-               if(getAVP(&rxtxbuf, AVP_LENGTH, &(list_el->Tag.TIDLen))  != 0) break;
-               if(list_el->Tag.TIDLen)
-               {
-                   if(getAVP(&rxtxbuf, AVP_TAG_VALUE, list_el->Tag.TID)  != 0) break;
-               }
-           }
-           if(has_XPC)
-           {
-               if(getAVP(&rxtxbuf, AVP_XPC, list_el->Tag.XPC)  != 0) break;
-           }
-           if(has_PC)
-           {
-               if(getAVP(&rxtxbuf, AVP_PC, list_el->Tag.PC)  != 0) break;
-           }
-           *TagList = list_el;
-           (*Size)++;
-        }
-        // if exited from previous loop, then last tag has not been linked to
-        // TagList yet and must be removed.
-        free(list_el);
-        if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
-        ret = (CAENRFIDErrorCodes)result_code;
-    }
-    else
-    {
-        reader->_inventory_params.has_RSSI = has_RSSI;
-        reader->_inventory_params.has_framed = has_framed;
-        reader->_inventory_params.has_continuous = has_continuous;
-        reader->_inventory_params.has_compact = has_compact;
-        reader->_inventory_params.has_TID = has_TID;
-        reader->_inventory_params.has_event_trigger = has_event_trigger;
-        reader->_inventory_params.has_XPC = has_XPC;
-        reader->_inventory_params.has_PC = has_PC;
-        ret = CAENRFID_StatusOK;
-    }
-
-    exit_done:
-    if(rxtxbuf.memory) free(rxtxbuf.memory);
-    return (ret);
-}
-
-CAENRFIDErrorCodes CAENRFID_GetFramedTag(CAENRFIDReader* reader,
-                                         bool* has_tag,
-                                         CAENRFIDTag* Tag,
-                                         bool* has_result_code)
-{
-    return (CAENRFIDErrorCodes) receiveFramedTag(reader, has_tag, Tag, has_result_code);
-}
-
-CAENRFIDErrorCodes CAENRFID_InventoryAbort(CAENRFIDReader* reader)
-{
-    return (CAENRFIDErrorCodes) sendAbort(reader);
-}
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2022, CAEN RFID S.R.L.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of CAEN RFID S.R.L. nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "CAENRFIDLib_Light.h"
+#include "IO_Light.h"
+#include "Match_Light.h"
+
+
+CAENRFIDErrorCodes CAENRFID_Connect(CAENRFIDReader* reader,
+                                    CAENRFIDPort PortType,
+                                    void* PortParams)
+{
+    //a NULL connect callback leaves the port to be opened by the application
+    if(reader->connect != NULL &&
+       reader->connect(&reader->_port_handle, (int16_t) PortType, PortParams) != 0) return CAENRFID_PortError;
+
+#ifndef CAENRFID_NO_HEAP
+    //the scratch buffer is allocated once here and reused by every command,
+    //a reader connected again without CAENRFID_Disconnect keeps its own
+    if(reader->_connected != CAENRFID_READER_CONNECTED)
+    {
+        if((reader->_buffer = malloc(CAENRFID_MAX_FRAME_LENGTH)) == NULL)
+        {
+            if(reader->connect != NULL) reader->disconnect(reader->_port_handle);
+            return CAENRFID_OutOfMemoryError;
+        }
+    }
+#endif
+    reader->_buffer_size = CAENRFID_MAX_FRAME_LENGTH;
+    reader->_connected = CAENRFID_READER_CONNECTED;
+    reader->_buffer_held = false;
+    reader->_rx_rpos = 0;
+    reader->_rx_wpos = 0;
+    reader->_cmdID = 0;
+    reader->_framed_decoder = NULL;
+    clearTemplates(reader);
+
+   return CAENRFID_StatusOK;
+}
+
+CAENRFIDErrorCodes CAENRFID_Disconnect(CAENRFIDReader* reader)
+{
+#ifndef CAENRFID_NO_HEAP
+    free(reader->_buffer);
+    reader->_buffer = NULL;
+#endif
+    reader->_buffer_size = 0;
+    reader->_connected = 0;
+    if(reader->disconnect(reader->_port_handle) != 0) return CAENRFID_PortError;
+    return CAENRFID_StatusOK;
+}
+
+CAENRFIDErrorCodes CAENRFID_GetReadPoints(CAENRFIDReader* reader,
+                                          char** Antennas[],
+                                          int16_t* numAnt)
+{
+    (void) reader;
+    getAntNames(Antennas, numAnt);
+    return CAENRFID_StatusOK;
+}
+
+CAENRFIDErrorCodes CAENRFID_GetSourceNames(CAENRFIDReader* reader,
+                                           char** Sources[],
+                                           int16_t* numSrc)
+{
+    (void) reader;
+    getSrcNames(Sources, numSrc);
+    return CAENRFID_StatusOK;
+}
+
+CAENRFIDErrorCodes CAENRFID_GetFirmwareRelease(CAENRFIDReader* reader,
+                                               char *FWRel)
+{
+    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
+    uint16_t  cmd;
+    int16_t tmp;
+    uint16_t result_code;
+    IOBuffer_t rxtxbuf = {0};
+    AVPIndex_t index;
+
+    cmd = CMD_GETFWRELEASE;
+    //build request
+    rxtxbuf.size  = HEADER_LEN;
+    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
+
+    if((tmp = attachBuffer(reader, &rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+
+    addHeader(reader->_cmdID++, &rxtxbuf, rxtxbuf.size);
+    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
+    //send command and get reply
+    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf)) != 0)
+    {
+        ret = (CAENRFIDErrorCodes) tmp;
+        goto exit_done;
+    }
+    //extract data
+    rxtxbuf.rpos = HEADER_LEN;
+    if(scanAVPs(&rxtxbuf, &index) != 0) goto exit_done;
+    if(findAVP(&index, AVP_COMMAND, &cmd) != 0) goto exit_done;
+    if(findAVP(&index, AVP_GETFWRELEASE, FWRel) < 0) goto exit_done;
+    if(findAVP(&index, AVP_RESULT_CODE,  &result_code) != 0) goto exit_done;
+    ret = (CAENRFIDErrorCodes) result_code;
+
+    exit_done:
+    return (ret);
+}
+
+CAENRFIDErrorCodes CAENRFID_GetReaderInfo(CAENRFIDReader* reader,
+                                          char* Model,
+                                          char* SerialNum)
+{
+    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
+    uint16_t  cmd;
+    int16_t tmp, idx;
+    uint16_t result_code;
+    IOBuffer_t rxtxbuf = {0};
+    AVPIndex_t index;
+    char rInfo[MAX_MODEL_LENGTH + 1 + MAX_SERIAL_LENGTH];
+
+    cmd = CMD_GETRDRINFO;
+    //build request
+    rxtxbuf.size  = HEADER_LEN;
+    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
+
+    if((tmp = attachBuffer(reader, &rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+
+    addHeader(reader->_cmdID++, &rxtxbuf, rxtxbuf.size);
+    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
+    //send command and get reply
+    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf)) != 0)
+    {
+        ret = (CAENRFIDErrorCodes) tmp;
+        goto exit_done;
+    }
+    //extract data
+    rxtxbuf.rpos = HEADER_LEN;
+    if(scanAVPs(&rxtxbuf, &index) != 0) goto exit_done;
+    if(findAVP(&index, AVP_COMMAND, &cmd)  != 0) goto exit_done;
+    if(findAVP(&index, AVP_READERINFO, rInfo)  < 0) goto exit_done;
+    if(findAVP(&index, AVP_RESULT_CODE, &result_code)  != 0) goto exit_done;
+    ret = (CAENRFIDErrorCodes)result_code;
+
+    if((idx = (int16_t)strcspn(rInfo, " ")) != 0)
+    {
+        strncpy(Model, rInfo, idx);
+        Model[idx] = 0;
+        strncpy(SerialNum, &rInfo[idx + 1], strlen(rInfo) - idx);
+
+    }
+
+    exit_done:
+    return (ret);
+}
+
+CAENRFIDErrorCodes CAENRFID_SetProtocol(CAENRFIDReader* reader,
+                                        CAENRFIDProtocol Proto)
+{
+    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
+    uint16_t  cmd;
+    int16_t tmp;
+    uint16_t result_code;
+    IOBuffer_t rxtxbuf = {0};
+    uint32_t protocol = Proto;
+
+    cmd = CMD_SETPROTOCOL;
+    //build request
+    rxtxbuf.size  = HEADER_LEN;
+    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
+    rxtxbuf.size += sizeAVP(AVP_PROTOCOL_NAME, sizeof(protocol));
+
+    if((tmp = attachBuffer(reader, &rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+
+    addHeader(reader->_cmdID++, &rxtxbuf, rxtxbuf.size);
+    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
+    addAVP(&rxtxbuf, sizeof(protocol), AVP_PROTOCOL_NAME, &protocol);
+
+    //send command and get reply
+    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
+    {
+        ret = (CAENRFIDErrorCodes) tmp;
+        goto exit_done;
+    }
+    //extract data
+    rxtxbuf.rpos = HEADER_LEN;
+    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
+    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
+    ret = (CAENRFIDErrorCodes)result_code;
+
+    exit_done:
+    return (ret);
+}
+
+CAENRFIDErrorCodes CAENRFID_GetProtocol(CAENRFIDReader* reader,
+                                        CAENRFIDProtocol *Proto)
+{
+    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
+    uint16_t  cmd;
+    int16_t tmp;
+    uint16_t result_code;
+    IOBuffer_t rxtxbuf = {0};
+    AVPIndex_t index;
+    uint32_t protocol;
+
+    cmd = CMD_GETPROTOCOL;
+    //build request
+    rxtxbuf.size  = HEADER_LEN;
+    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
+
+    if((tmp = attachBuffer(reader, &rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+
+    if(!getTemplate(reader, &rxtxbuf, cmd, NULL, 0))
+    {
+        addHeader(reader->_cmdID++, &rxtxbuf, rxtxbuf.size);
+        addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
+        putTemplate(reader, &rxtxbuf, cmd, NULL, 0);
+    }
+    //send command and get reply
+    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf)) != 0)
+    {
+        ret = (CAENRFIDErrorCodes) tmp;
+        goto exit_done;
+    }
+    //extract data
+    rxtxbuf.rpos = HEADER_LEN;
+    if(scanAVPs(&rxtxbuf, &index) != 0) goto exit_done;
+    if(findAVP(&index, AVP_COMMAND, &cmd) != 0) goto exit_done;
+    if((tmp = findAVP(&index, AVP_PROTOCOL_NAME, &protocol)) < 0) goto exit_done;
+    else if(tmp == 0) *Proto = (CAENRFIDProtocol) protocol;
+    if(findAVP(&index, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
+    ret = (CAENRFIDErrorCodes)result_code;
+
+    exit_done:
+    return (ret);
+}
+
+CAENRFIDErrorCodes CAENRFID_SetPower(CAENRFIDReader* reader,
+                                     uint32_t Power)
+{
+    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
+    uint16_t  cmd;
+    int16_t tmp;
+    uint16_t result_code;
+    IOBuffer_t rxtxbuf = {0};
+
+    cmd = CMD_SETPOWER;
+    //build request
+    rxtxbuf.size  = HEADER_LEN;
+    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
+    rxtxbuf.size += sizeAVP(AVP_POWER, sizeof(Power));
+
+    if((tmp = attachBuffer(reader, &rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+
+    addHeader(reader->_cmdID++, &rxtxbuf, rxtxbuf.size);
+    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
+    addAVP(&rxtxbuf, sizeof(Power), AVP_POWER, &Power);
+
+    //send command and get reply
+    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
+    {
+        ret = (CAENRFIDErrorCodes) tmp;
+        goto exit_done;
+    }
+    //extract data
+    rxtxbuf.rpos = HEADER_LEN;
+    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
+    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
+    ret = (CAENRFIDErrorCodes)result_code;
+
+    exit_done:
+    return (ret);
+}
+
+CAENRFIDErrorCodes CAENRFID_GetPower(CAENRFIDReader* reader,
+                                     uint32_t *Power)
+{
+    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
+    uint16_t  cmd;
+    int16_t tmp;
+    uint16_t result_code;
+    IOBuffer_t rxtxbuf = {0};
+    AVPIndex_t index;
+
+    cmd = CMD_GETPOWER;
+    //build request
+    rxtxbuf.size  = HEADER_LEN;
+    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
+
+    if((tmp = attachBuffer(reader, &rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+
+    if(!getTemplate(reader, &rxtxbuf, cmd, NULL, 0))
+    {
+        addHeader(reader->_cmdID++, &rxtxbuf, rxtxbuf.size);
+        addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
+        putTemplate(reader, &rxtxbuf, cmd, NULL, 0);
+    }
+    //send command and get reply
+    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf)) != 0)
+    {
+        ret = (CAENRFIDErrorCodes) tmp;
+        goto exit_done;
+    }
+    //extract data
+    rxtxbuf.rpos = HEADER_LEN;
+    if(scanAVPs(&rxtxbuf, &index) != 0) goto exit_done;
+    if(findAVP(&index, AVP_COMMAND, &cmd) != 0) goto exit_done;
+    if(findAVP(&index, AVP_POWER_GET, Power) < 0) goto exit_done;
+    if(findAVP(&index, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
+    ret = (CAENRFIDErrorCodes) result_code;
+
+    exit_done:
+    return (ret);
+}
+
+CAENRFIDErrorCodes CAENRFID_AddReadPoint(CAENRFIDReader* reader,
+                                         char *SourceName,
+                                         char *ReadPoint)
+{
+    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
+    uint16_t  cmd;
+    int16_t tmp;
+    uint16_t result_code;
+    IOBuffer_t rxtxbuf = {0};
+
+    cmd = CMD_ADDREADPOINT;
+    //build request
+    rxtxbuf.size  = HEADER_LEN;
+    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
+    rxtxbuf.size += sizeAVP(AVP_SOURCE_NAME, strlen(SourceName) + 1);
+    rxtxbuf.size += sizeAVP(AVP_READPOINT_NAME, strlen(ReadPoint) + 1);
+
+    if((tmp = attachBuffer(reader, &rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+
+    addHeader(reader->_cmdID++, &rxtxbuf, rxtxbuf.size);
+    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
+    addAVP(&rxtxbuf, (uint16_t)strlen(SourceName) + 1, AVP_SOURCE_NAME, SourceName);
+    addAVP(&rxtxbuf, (uint16_t)strlen(ReadPoint) + 1, AVP_READPOINT_NAME, ReadPoint);
+    //send command and get reply
+    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf)) != 0)
+    {
+        ret = (CAENRFIDErrorCodes) tmp;
+        goto exit_done;
+    }
+    //extract data
+    rxtxbuf.rpos = HEADER_LEN;
+    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
+    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
+    ret = (CAENRFIDErrorCodes) result_code;
+
+    exit_done:
+    return (ret);
+}
+
+CAENRFIDErrorCodes CAENRFID_RemoveReadPoint(CAENRFIDReader* reader,
+                                            char *SourceName,
+                                            char *ReadPoint)
+{
+    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
+    uint16_t  cmd;
+    int16_t tmp;
+    uint16_t result_code;
+    IOBuffer_t rxtxbuf = {0};
+
+    cmd = CMD_REMREADPOINT;
+    //build request
+    rxtxbuf.size  = HEADER_LEN;
+    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
+    rxtxbuf.size += sizeAVP(AVP_SOURCE_NAME, strlen(SourceName) + 1);
+    rxtxbuf.size += sizeAVP(AVP_READPOINT_NAME, strlen(ReadPoint) + 1);
+
+    if((tmp = attachBuffer(reader, &rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+
+    addHeader(reader->_cmdID++, &rxtxbuf, rxtxbuf.size);
+    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
+    addAVP(&rxtxbuf, (uint16_t)strlen(SourceName) + 1, AVP_SOURCE_NAME, SourceName);
+    addAVP(&rxtxbuf, (uint16_t)strlen(ReadPoint) + 1, AVP_READPOINT_NAME, ReadPoint);
+    //send command and get reply
+    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf)) != 0)
+    {
+        ret = (CAENRFIDErrorCodes) tmp;
+        goto exit_done;
+    }
+    //extract data
+    rxtxbuf.rpos = HEADER_LEN;
+    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
+    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
+    ret = (CAENRFIDErrorCodes)result_code;
+
+    exit_done:
+    return (ret);
+}
+
+CAENRFIDErrorCodes CAENRFID_isReadPointPresent(CAENRFIDReader* reader,
+                                               char* ReadPoint,
+                                               char* SourceName,
+                                               uint16_t* isPresent)
+{
+    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
+    uint16_t  cmd;
+    int16_t tmp;
+    uint16_t result_code;
+    IOBuffer_t rxtxbuf = {0};
+    AVPIndex_t index;
+
+    cmd = CMD_CHECKRPINSRC;
+    //build request
+    rxtxbuf.size  = HEADER_LEN;
+    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
+    rxtxbuf.size += sizeAVP(AVP_READPOINT_NAME, strlen(ReadPoint) + 1);
+    rxtxbuf.size += sizeAVP(AVP_SOURCE_NAME, strlen(SourceName) + 1);
+
+    if((tmp = attachBuffer(reader, &rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+
+    addHeader(reader->_cmdID++, &rxtxbuf, rxtxbuf.size);
+    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
+    addAVP(&rxtxbuf, (uint16_t)strlen(ReadPoint) + 1, AVP_READPOINT_NAME, ReadPoint);
+    addAVP(&rxtxbuf, (uint16_t)strlen(SourceName) + 1, AVP_SOURCE_NAME, SourceName);
+    //send command and get reply
+    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf)) != 0)
+    {
+        ret = (CAENRFIDErrorCodes) tmp;
+        goto exit_done;
+    }
+    //extract data
+    rxtxbuf.rpos = HEADER_LEN;
+    if(scanAVPs(&rxtxbuf, &index) != 0) goto exit_done;
+    if(findAVP(&index, AVP_COMMAND, &cmd) != 0) goto exit_done;
+    if(findAVP(&index, AVP_BOOLEAN, isPresent) < 0) goto exit_done;
+    if(findAVP(&index, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
+    ret = (CAENRFIDErrorCodes)result_code;
+
+    exit_done:
+    return (ret);
+}
+
+CAENRFIDErrorCodes CAENRFID_GetReadPointStatus(CAENRFIDReader* reader,
+                                               char* ReadPoint,
+                                               CAENRFIDReadPointStatus* Status)
+{
+    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
+    uint16_t  cmd;
+    int16_t tmp;
+    uint16_t result_code;
+    IOBuffer_t rxtxbuf = {0};
+    AVPIndex_t index;
+    uint32_t status;
+
+    cmd = CMD_CHECKANTENNA;
+    //build request
+    rxtxbuf.size  = HEADER_LEN;
+    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
+    rxtxbuf.size += sizeAVP(AVP_READPOINT_NAME, strlen(ReadPoint) + 1);
+
+    if((tmp = attachBuffer(reader, &rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+
+    if(!getTemplate(reader, &rxtxbuf, cmd, ReadPoint, (uint16_t)strlen(ReadPoint)))
+    {
+        addHeader(reader->_cmdID++, &rxtxbuf, rxtxbuf.size);
+        addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
+        addAVP(&rxtxbuf, (uint16_t)strlen(ReadPoint) + 1, AVP_READPOINT_NAME, ReadPoint);
+        putTemplate(reader, &rxtxbuf, cmd, ReadPoint, (uint16_t)strlen(ReadPoint));
+    }
+    //send command and get reply
+    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf)) != 0)
+    {
+        ret = (CAENRFIDErrorCodes) tmp;
+        goto exit_done;
+    }
+    //extract data
+    rxtxbuf.rpos = HEADER_LEN;
+    if(scanAVPs(&rxtxbuf, &index) != 0) goto exit_done;
+    if(findAVP(&index, AVP_COMMAND, &cmd) != 0) goto exit_done;
+    if((tmp = findAVP(&index, AVP_READPOINT_STATUS, &status)) < 0) goto exit_done;
+    else if(tmp == 0) *Status = (CAENRFIDReadPointStatus) status;
+    if(findAVP(&index, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
+    ret = (CAENRFIDErrorCodes)result_code;
+
+    exit_done:
+    return (ret);
+}
+
+CAENRFIDErrorCodes CAENRFID_MatchReadPointImpedance(CAENRFIDReader* reader,
+                                                    char* ReadPoint,
+                                                    float* value)
+{
+    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
+    uint16_t  cmd;
+    int16_t tmp;
+    uint16_t result_code;
+    IOBuffer_t rxtxbuf = { 0 };
+    AVPIndex_t index;
+    uint32_t param = RPCMATCHRFALG, param_value = 0;
+
+    cmd = CMD_MATCHRFIMPEDANCE;
+    //build request
+    rxtxbuf.size = HEADER_LEN;
+    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
+    rxtxbuf.size += sizeAVP(AVP_READPOINT_NAME, strlen(ReadPoint) + 1);
+    rxtxbuf.size += sizeAVP(AVP_CONFIGPARAMETER, sizeof(param));
+    rxtxbuf.size += sizeAVP(AVP_CONFIGVALUE, sizeof(param_value));
+
+    if((tmp = attachBuffer(reader, &rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+
+    addHeader(reader->_cmdID++, &rxtxbuf, rxtxbuf.size);
+    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
+    addAVP(&rxtxbuf, (uint16_t)strlen(ReadPoint) + 1, AVP_READPOINT_NAME, ReadPoint);
+    addAVP(&rxtxbuf, sizeof(param), AVP_CONFIGPARAMETER, &param);
+    addAVP(&rxtxbuf, sizeof(param_value), AVP_CONFIGVALUE, &param_value);
+    //send command and get reply
+    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf)) != 0)
+    {
+        ret = (CAENRFIDErrorCodes)tmp;
+        goto exit_done;
+    }
+    //extract data
+    rxtxbuf.rpos = HEADER_LEN;
+    if(scanAVPs(&rxtxbuf, &index) != 0) goto exit_done;
+    if(findAVP(&index, AVP_COMMAND, &cmd) != 0) goto exit_done;
+    if(findAVP(&index, AVP_POWER_VSWR, value) < 0) goto exit_done;
+    if(findAVP(&index, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
+    ret = (CAENRFIDErrorCodes)result_code;
+
+exit_done:
+    return (ret);
+}
+
+CAENRFIDErrorCodes CAENRFID_SetSourceConfiguration(CAENRFIDReader* reader,
+                                                   char* SourceName,
+                                                   CAENRFID_SOURCE_Parameter Parameter,
+                                                   uint32_t Value)
+{
+    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
+    uint16_t  cmd;
+    int16_t tmp;
+    uint16_t result_code;
+    IOBuffer_t rxtxbuf = {0};
+    uint32_t parameter = Parameter;
+
+    cmd = CMD_SETSRCCONF;
+    //build request
+    rxtxbuf.size  = HEADER_LEN;
+    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
+    rxtxbuf.size += sizeAVP(AVP_SOURCE_NAME, strlen(SourceName) + 1);
+    rxtxbuf.size += sizeAVP(AVP_CONFIGPARAMETER, sizeof(parameter));
+    rxtxbuf.size += sizeAVP(AVP_CONFIGVALUE, sizeof(Value));
+
+    if((tmp = attachBuffer(reader, &rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+
+    addHeader(reader->_cmdID++, &rxtxbuf, rxtxbuf.size);
+    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
+    addAVP(&rxtxbuf, (uint16_t)strlen(SourceName) + 1, AVP_SOURCE_NAME, SourceName);
+    addAVP(&rxtxbuf, sizeof(parameter), AVP_CONFIGPARAMETER, &parameter);
+    addAVP(&rxtxbuf, sizeof(Value), AVP_CONFIGVALUE, &Value);
+    //send command and get reply
+    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
+    {
+        ret = (CAENRFIDErrorCodes) tmp;
+        goto exit_done;
+    }
+    //extract data
+    rxtxbuf.rpos = HEADER_LEN;
+    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
+    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
+    ret = (CAENRFIDErrorCodes)result_code;
+
+    exit_done:
+    return (ret);
+}
+
+CAENRFIDErrorCodes CAENRFID_GetSourceConfiguration(CAENRFIDReader* reader,
+                                                   char* SourceName,
+                                                   CAENRFID_SOURCE_Parameter Parameter,
+                                                   uint32_t* Value)
+{
+    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
+    uint16_t  cmd;
+    int16_t tmp;
+    uint16_t result_code;
+    IOBuffer_t rxtxbuf = {0};
+    AVPIndex_t index;
+    uint32_t parameter = Parameter;
+
+    cmd = CMD_GETSRCCONF;
+    //build request
+    rxtxbuf.size  = HEADER_LEN;
+    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
+    rxtxbuf.size += sizeAVP(AVP_SOURCE_NAME, strlen(SourceName) + 1);
+    rxtxbuf.size += sizeAVP(AVP_CONFIGPARAMETER, sizeof(parameter));
+
+    if((tmp = attachBuffer(reader, &rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+
+    addHeader(reader->_cmdID++, &rxtxbuf, rxtxbuf.size);
+    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
+    addAVP(&rxtxbuf, (uint16_t)strlen(SourceName) + 1, AVP_SOURCE_NAME, SourceName);
+    addAVP(&rxtxbuf, sizeof(parameter), AVP_CONFIGPARAMETER, &parameter);
+    //send command and get reply
+    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
+    {
+        ret = (CAENRFIDErrorCodes) tmp;
+        goto exit_done;
+    }
+    //extract data
+    rxtxbuf.rpos = HEADER_LEN;
+    if(scanAVPs(&rxtxbuf, &index) != 0) goto exit_done;
+    if(findAVP(&index, AVP_COMMAND, &cmd) != 0) goto exit_done;
+    if(findAVP(&index, AVP_CONFIGVALUE, Value) < 0) goto exit_done;
+    if(findAVP(&index, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
+    ret = (CAENRFIDErrorCodes)result_code;
+
+    exit_done:
+    return (ret);
+}
+
+CAENRFIDErrorCodes CAENRFID_SetRS232(CAENRFIDReader* reader,
+                                     uint32_t Baudrate,
+                                     uint32_t DataBits,
+                                     uint32_t StopBits,
+                                     CAENRFID_RS232_Parity Parity,
+                                     CAENRFID_RS232_FlowControl FlowControl)
+{
+    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
+    uint16_t  cmd;
+    int16_t tmp;
+    uint16_t result_code;
+    IOBuffer_t rxtxbuf = {0};
+    uint32_t parity = Parity, flowctrl = FlowControl;
+
+    cmd = CMD_SETRS232;
+    //build request
+    rxtxbuf.size  = HEADER_LEN;
+    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
+    rxtxbuf.size += sizeAVP(AVP_BAUDRATE, sizeof(Baudrate));
+    rxtxbuf.size += sizeAVP(AVP_DATABITS, sizeof(DataBits));
+    rxtxbuf.size += sizeAVP(AVP_STOPBITS, sizeof(StopBits));
+    rxtxbuf.size += sizeAVP(AVP_PARITY, sizeof(parity));
+    rxtxbuf.size += sizeAVP(AVP_FLOWCTRL, sizeof(flowctrl));
+
+    if((tmp = attachBuffer(reader, &rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+
+    addHeader(reader->_cmdID++, &rxtxbuf, rxtxbuf.size);
+    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
+    addAVP(&rxtxbuf, sizeof(Baudrate), AVP_BAUDRATE, &Baudrate);
+    addAVP(&rxtxbuf, sizeof(DataBits), AVP_DATABITS, &DataBits);
+    addAVP(&rxtxbuf, sizeof(StopBits), AVP_STOPBITS, &StopBits);
+    addAVP(&rxtxbuf, sizeof(parity), AVP_PARITY, &parity);
+    addAVP(&rxtxbuf, sizeof(flowctrl), AVP_FLOWCTRL, &flowctrl);
+    //send command and get reply
+    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
+    {
+        ret = (CAENRFIDErrorCodes) tmp;
+        goto exit_done;
+    }
+    //extract data
+    rxtxbuf.rpos = HEADER_LEN;
+    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
+    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
+    ret = (CAENRFIDErrorCodes)result_code;
+
+    exit_done:
+    return (ret);
+}
+
+CAENRFIDErrorCodes CAENRFID_SetBitrate(CAENRFIDReader* reader,
+                                       CAENRFID_Bitrate Bitrate)
+{
+    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
+    uint16_t  cmd;
+    int16_t tmp;
+    uint16_t result_code;
+    IOBuffer_t rxtxbuf = {0};
+    uint16_t bitrate = Bitrate;
+
+    cmd = CMD_SETRFLINKPROFILE;
+    //build request
+    rxtxbuf.size  = HEADER_LEN;
+    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
+    rxtxbuf.size += sizeAVP(AVP_MODULATION, sizeof(bitrate));
+
+    if((tmp = attachBuffer(reader, &rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+
+    addHeader(reader->_cmdID++, &rxtxbuf, rxtxbuf.size);
+    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
+    addAVP(&rxtxbuf, sizeof(bitrate), AVP_MODULATION, &bitrate);
+
+    //send command and get reply
+    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
+    {
+        ret = (CAENRFIDErrorCodes) tmp;
+        goto exit_done;
+    }
+    //extract data
+    rxtxbuf.rpos = HEADER_LEN;
+    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
+    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
+    ret = (CAENRFIDErrorCodes)result_code;
+
+    exit_done:
+    return (ret);
+}
+
+CAENRFIDErrorCodes CAENRFID_GetBitrate(CAENRFIDReader* reader,
+                                       CAENRFID_Bitrate* Bitrate)
+{
+    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
+    uint16_t  cmd;
+    int16_t tmp;
+    uint16_t result_code;
+    IOBuffer_t rxtxbuf = {0};
+    AVPIndex_t index;
+    uint16_t bitrate;
+
+    cmd = CMD_GETRFLINKPROFILE;
+    //build request
+    rxtxbuf.size  = HEADER_LEN;
+    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
+
+    if((tmp = attachBuffer(reader, &rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+
+    if(!getTemplate(reader, &rxtxbuf, cmd, NULL, 0))
+    {
+        addHeader(reader->_cmdID++, &rxtxbuf, rxtxbuf.size);
+        addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
+        putTemplate(reader, &rxtxbuf, cmd, NULL, 0);
+    }
+
+    //send command and get reply
+    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
+    {
+        ret = (CAENRFIDErrorCodes) tmp;
+        goto exit_done;
+    }
+    //extract data
+    rxtxbuf.rpos = HEADER_LEN;
+    if(scanAVPs(&rxtxbuf, &index) != 0) goto exit_done;
+    if(findAVP(&index, AVP_COMMAND, &cmd) != 0) goto exit_done;
+    if((tmp = findAVP(&index, AVP_MODULATION, &bitrate)) < 0) goto exit_done;
+    else if(tmp == 0) *Bitrate = (CAENRFID_Bitrate) bitrate;
+    if(findAVP(&index, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
+    ret = (CAENRFIDErrorCodes)result_code;
+
+    exit_done:
+    return (ret);
+}
+
+CAENRFIDErrorCodes CAENRFID_SetFHSSMode(CAENRFIDReader* reader,
+                                        uint16_t FHSSMode)
+{
+    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
+    uint16_t  cmd;
+    int16_t tmp;
+    uint16_t result_code;
+    IOBuffer_t rxtxbuf = {0};
+
+    cmd = CMD_SETFHMODE;
+    //build request
+    rxtxbuf.size  = HEADER_LEN;
+    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
+    rxtxbuf.size += sizeAVP(AVP_BOOLEAN, sizeof(FHSSMode));
+
+    if((tmp = attachBuffer(reader, &rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+
+    addHeader(reader->_cmdID++, &rxtxbuf, rxtxbuf.size);
+    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
+    addAVP(&rxtxbuf, sizeof(FHSSMode), AVP_BOOLEAN, &FHSSMode);
+
+    //send command and get reply
+    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
+    {
+        ret = (CAENRFIDErrorCodes) tmp;
+        goto exit_done;
+    }
+    //extract data
+    rxtxbuf.rpos = HEADER_LEN;
+    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
+    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
+    ret = (CAENRFIDErrorCodes)result_code;
+
+    exit_done:
+    return (ret);
+}
+
+CAENRFIDErrorCodes CAENRFID_GetFHSSMode(CAENRFIDReader* reader,
+                                        uint16_t* FHSSMode)
+{
+    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
+    uint16_t  cmd;
+    int16_t tmp;
+    uint16_t result_code;
+    IOBuffer_t rxtxbuf = {0};
+    AVPIndex_t index;
+
+    cmd = CMD_GETFHMODE;
+    //build request
+    rxtxbuf.size  = HEADER_LEN;
+    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
+
+    if((tmp = attachBuffer(reader, &rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+
+    if(!getTemplate(reader, &rxtxbuf, cmd, NULL, 0))
+    {
+        addHeader(reader->_cmdID++, &rxtxbuf, rxtxbuf.size);
+        addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
+        putTemplate(reader, &rxtxbuf, cmd, NULL, 0);
+    }
+
+    //send command and get reply
+    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
+    {
+        ret = (CAENRFIDErrorCodes) tmp;
+        goto exit_done;
+    }
+    //extract data
+    rxtxbuf.rpos = HEADER_LEN;
+    if(scanAVPs(&rxtxbuf, &index) != 0) goto exit_done;
+    if(findAVP(&index, AVP_COMMAND, &cmd) != 0) goto exit_done;
+    if(findAVP(&index, AVP_BOOLEAN, FHSSMode) < 0) goto exit_done;
+    if(findAVP(&index, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
+    ret = (CAENRFIDErrorCodes)result_code;
+
+    exit_done:
+    return (ret);
+}
+
+CAENRFIDErrorCodes CAENRFID_SetRFChannel(CAENRFIDReader* reader,
+                                         uint16_t RFChannel)
+{
+    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
+    uint16_t  cmd;
+    int16_t tmp;
+    uint16_t result_code;
+    IOBuffer_t rxtxbuf = {0};
+
+    cmd = CMD_SETCHANNEL;
+    //build request
+    rxtxbuf.size  = HEADER_LEN;
+    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
+    rxtxbuf.size += sizeAVP(AVP_RFCHANNEL, sizeof(RFChannel));
+
+    if((tmp = attachBuffer(reader, &rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+
+    addHeader(reader->_cmdID++, &rxtxbuf, rxtxbuf.size);
+    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
+    addAVP(&rxtxbuf, sizeof(RFChannel), AVP_RFCHANNEL, &RFChannel);
+
+    //send command and get reply
+    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
+    {
+        ret = (CAENRFIDErrorCodes) tmp;
+        goto exit_done;
+    }
+    //extract data
+    rxtxbuf.rpos = HEADER_LEN;
+    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
+    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
+    ret = (CAENRFIDErrorCodes)result_code;
+
+    exit_done:
+    return (ret);
+}
+
+CAENRFIDErrorCodes CAENRFID_GetRFChannel(CAENRFIDReader* reader,
+                                         uint16_t* RFChannel)
+{
+    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
+    uint16_t  cmd;
+    int16_t tmp;
+    uint16_t result_code;
+    IOBuffer_t rxtxbuf = {0};
+    AVPIndex_t index;
+
+    cmd = CMD_GETCHANNEL;
+    //build request
+    rxtxbuf.size  = HEADER_LEN;
+    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
+
+    if((tmp = attachBuffer(reader, &rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+
+    if(!getTemplate(reader, &rxtxbuf, cmd, NULL, 0))
+    {
+        addHeader(reader->_cmdID++, &rxtxbuf, rxtxbuf.size);
+        addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
+        putTemplate(reader, &rxtxbuf, cmd, NULL, 0);
+    }
+
+    //send command and get reply
+    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
+    {
+        ret = (CAENRFIDErrorCodes) tmp;
+        goto exit_done;
+    }
+    //extract data
+    rxtxbuf.rpos = HEADER_LEN;
+    if(scanAVPs(&rxtxbuf, &index) != 0) goto exit_done;
+    if(findAVP(&index, AVP_COMMAND, &cmd) != 0) goto exit_done;
+    if(findAVP(&index, AVP_RFCHANNEL, RFChannel) < 0) goto exit_done;
+    if(findAVP(&index, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
+    ret = (CAENRFIDErrorCodes)result_code;
+
+    exit_done:
+    return (ret);
+}
+
+CAENRFIDErrorCodes CAENRFID_SetRFRegulation(CAENRFIDReader* reader,
+                                            CAENRFIDRFRegulations RFRegulation)
+{
+    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
+    uint16_t  cmd;
+    int16_t tmp;
+    uint16_t result_code;
+    IOBuffer_t rxtxbuf = {0};
+    uint16_t regulation = RFRegulation;
+
+    cmd = CMD_SETRFREGULATION;
+    //build request
+    rxtxbuf.size  = HEADER_LEN;
+    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
+    rxtxbuf.size += sizeAVP(AVP_RFREGULATION, sizeof(regulation));
+
+    if((tmp = attachBuffer(reader, &rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+
+    addHeader(reader->_cmdID++, &rxtxbuf, rxtxbuf.size);
+    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
+    addAVP(&rxtxbuf, sizeof(regulation), AVP_RFREGULATION, &regulation);
+
+    //send command and get reply
+    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
+    {
+        ret = (CAENRFIDErrorCodes) tmp;
+        goto exit_done;
+    }
+    //extract data
+    rxtxbuf.rpos = HEADER_LEN;
+    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
+    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
+    ret = (CAENRFIDErrorCodes)result_code;
+
+    exit_done:
+    return (ret);
+}
+
+CAENRFIDErrorCodes CAENRFID_GetRFRegulation(CAENRFIDReader* reader,
+                                            CAENRFIDRFRegulations *RFRegulation)
+{
+    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
+    uint16_t  cmd;
+    int16_t tmp;
+    uint16_t result_code;
+    IOBuffer_t rxtxbuf = {0};
+    AVPIndex_t index;
+    uint16_t regulation;
+
+    cmd = CMD_GETRFREGULATION;
+    //build request
+    rxtxbuf.size  = HEADER_LEN;
+    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
+
+    if((tmp = attachBuffer(reader, &rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+
+    if(!getTemplate(reader, &rxtxbuf, cmd, NULL, 0))
+    {
+        addHeader(reader->_cmdID++, &rxtxbuf, rxtxbuf.size);
+        addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
+        putTemplate(reader, &rxtxbuf, cmd, NULL, 0);
+    }
+
+    //send command and get reply
+    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
+    {
+        ret = (CAENRFIDErrorCodes) tmp;
+        goto exit_done;
+    }
+    //extract data
+    rxtxbuf.rpos = HEADER_LEN;
+    if(scanAVPs(&rxtxbuf, &index) != 0) goto exit_done;
+    if(findAVP(&index, AVP_COMMAND, &cmd) != 0) goto exit_done;
+    if((tmp = findAVP(&index, AVP_RFREGULATION, &regulation)) < 0) goto exit_done;
+    else if(tmp == 0) *RFRegulation = (CAENRFIDRFRegulations) regulation;
+    if(findAVP(&index, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
+    ret = (CAENRFIDErrorCodes)result_code;
+
+    exit_done:
+    return (ret);
+}
+
+CAENRFIDErrorCodes CAENRFID_SetIO(CAENRFIDReader* reader,
+                                  uint32_t IORegister)
+{
+    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
+    uint16_t  cmd;
+    int16_t tmp;
+    uint16_t result_code;
+    IOBuffer_t rxtxbuf = {0};
+
+    cmd = CMD_SETIO;
+    //build request
+    rxtxbuf.size  = HEADER_LEN;
+    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
+    rxtxbuf.size += sizeAVP(AVP_IOREGISTER, sizeof(IORegister));
+
+    if((tmp = attachBuffer(reader, &rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+
+    addHeader(reader->_cmdID++, &rxtxbuf, rxtxbuf.size);
+    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
+    addAVP(&rxtxbuf, sizeof(IORegister), AVP_IOREGISTER, &IORegister);
+
+    //send command and get reply
+    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
+    {
+        ret = (CAENRFIDErrorCodes) tmp;
+        goto exit_done;
+    }
+    //extract data
+    rxtxbuf.rpos = HEADER_LEN;
+    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
+    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
+    ret = (CAENRFIDErrorCodes)result_code;
+
+    exit_done:
+    return (ret);
+}
+
+CAENRFIDErrorCodes CAENRFID_GetIO(CAENRFIDReader* reader,
+                                  uint32_t* IORegister)
+{
+    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
+    uint16_t  cmd;
+    int16_t tmp;
+    uint16_t result_code;
+    IOBuffer_t rxtxbuf = {0};
+    AVPIndex_t index;
+
+    cmd = CMD_GETIO;
+    //build request
+    rxtxbuf.size  = HEADER_LEN;
+    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
+
+    if((tmp = attachBuffer(reader, &rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+
+    if(!getTemplate(reader, &rxtxbuf, cmd, NULL, 0))
+    {
+        addHeader(reader->_cmdID++, &rxtxbuf, rxtxbuf.size);
+        addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
+        putTemplate(reader, &rxtxbuf, cmd, NULL, 0);
+    }
+
+    //send command and get reply
+    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
+    {
+        ret = (CAENRFIDErrorCodes) tmp;
+        goto exit_done;
+    }
+    //extract data
+    rxtxbuf.rpos = HEADER_LEN;
+    if(scanAVPs(&rxtxbuf, &index) != 0) goto exit_done;
+    if(findAVP(&index, AVP_COMMAND, &cmd) != 0) goto exit_done;
+    if(findAVP(&index, AVP_IOREGISTER, IORegister) < 0) goto exit_done;
+    if(findAVP(&index, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
+    ret = (CAENRFIDErrorCodes)result_code;
+
+    exit_done:
+    return (ret);
+}
+
+CAENRFIDErrorCodes CAENRFID_SetIODirection(CAENRFIDReader* reader,
+                                           uint32_t IODirection)
+{
+    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
+    uint16_t  cmd;
+    int16_t tmp;
+    uint16_t result_code;
+    IOBuffer_t rxtxbuf = {0};
+
+    cmd = CMD_SETIODIR;
+    //build request
+    rxtxbuf.size  = HEADER_LEN;
+    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
+    rxtxbuf.size += sizeAVP(AVP_IOREGISTER, sizeof(IODirection));
+
+    if((tmp = attachBuffer(reader, &rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+
+    addHeader(reader->_cmdID++, &rxtxbuf, rxtxbuf.size);
+    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
+    addAVP(&rxtxbuf, sizeof(IODirection), AVP_IOREGISTER, &IODirection);
+
+    //send command and get reply
+    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
+    {
+        ret = (CAENRFIDErrorCodes) tmp;
+        goto exit_done;
+    }
+    //extract data
+    rxtxbuf.rpos = HEADER_LEN;
+    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
+    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
+    ret = (CAENRFIDErrorCodes)result_code;
+
+    exit_done:
+    return (ret);
+}
+
+CAENRFIDErrorCodes CAENRFID_GetIODirection(CAENRFIDReader* reader,
+                                           uint32_t* IODirection)
+{
+    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
+    uint16_t  cmd;
+    int16_t tmp;
+    uint16_t result_code;
+    IOBuffer_t rxtxbuf = {0};
+    AVPIndex_t index;
+
+    cmd = CMD_GETIODIR;
+    //build request
+    rxtxbuf.size  = HEADER_LEN;
+    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
+
+    if((tmp = attachBuffer(reader, &rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+
+    if(!getTemplate(reader, &rxtxbuf, cmd, NULL, 0))
+    {
+        addHeader(reader->_cmdID++, &rxtxbuf, rxtxbuf.size);
+        addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
+        putTemplate(reader, &rxtxbuf, cmd, NULL, 0);
+    }
+
+    //send command and get reply
+    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
+    {
+        ret = (CAENRFIDErrorCodes) tmp;
+        goto exit_done;
+    }
+    //extract data
+    rxtxbuf.rpos = HEADER_LEN;
+    if(scanAVPs(&rxtxbuf, &index) != 0) goto exit_done;
+    if(findAVP(&index, AVP_COMMAND, &cmd) != 0) goto exit_done;
+    if(findAVP(&index, AVP_IOREGISTER, IODirection) < 0) goto exit_done;
+    if(findAVP(&index, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
+    ret = (CAENRFIDErrorCodes)result_code;
+
+    exit_done:
+    return (ret);
+}
+
+CAENRFIDErrorCodes CAENRFID_TagHandleInit(CAENRFIDTagHandle* Handle,
+                                          const CAENRFIDTag* Tag,
+                                          uint32_t AccessPassword)
+{
+    IOBuffer_t buf = {0};
+    uint16_t len;
+
+    Handle->_address_len = 0;
+    Handle->_password_len = 0;
+    if(Tag != NULL)
+    {
+        if((Tag->Length > MAX_ID_LENGTH) ||
+           (memchr(Tag->LogicalSource, 0, MAX_LOGICAL_SOURCE_NAME) == NULL)) return CAENRFID_InvalidParam;
+        len = (uint16_t)strlen(Tag->LogicalSource) + 1;
+        buf.memory = Handle->_address;
+        buf.size = sizeof(Handle->_address);
+        addAVP(&buf, len, AVP_SOURCE_NAME, (void*) Tag->LogicalSource);
+        addAVP(&buf, sizeof(Tag->Length), AVP_TAGIDLEN, (void*) &Tag->Length);
+        addAVP(&buf, Tag->Length, AVP_TAGID, (void*) Tag->ID);
+        Handle->_address_len = buf.wpos;
+    }
+    if(AccessPassword != 0)
+    {
+        buf.memory = Handle->_password;
+        buf.size = sizeof(Handle->_password);
+        buf.wpos = 0;
+        addAVP(&buf, sizeof(AccessPassword), AVP_G2PWD, &AccessPassword);
+        Handle->_password_len = buf.wpos;
+    }
+    return CAENRFID_StatusOK;
+}
+
+static CAENRFIDErrorCodes encodeTagData(CAENRFIDReader* reader,
+                                        IOBuffer_t* rxtxbuf,
+                                        uint16_t cmd,
+                                        const CAENRFIDTagHandle* Handle,
+                                        uint16_t Bank,
+                                        uint16_t ByteAddress,
+                                        uint16_t ByteLength,
+                                        uint8_t* Data)
+{
+    int16_t tmp;
+
+    //build request, data are sent by CMD_G2WRITE only
+    rxtxbuf->size  = HEADER_LEN;
+    rxtxbuf->size += sizeAVP(AVP_COMMAND, sizeof(cmd));
+    rxtxbuf->size += Handle->_address_len;
+    rxtxbuf->size += sizeAVP(AVP_MEMBANK, sizeof(Bank));
+    rxtxbuf->size += sizeAVP(AVP_TAGADDRESS, sizeof(ByteAddress));
+    rxtxbuf->size += sizeAVP(AVP_LENGTH, sizeof(ByteLength));
+    if(cmd == CMD_G2WRITE)
+    {
+        rxtxbuf->size += sizeAVP(AVP_TAG_VALUE, ByteLength);
+    }
+    rxtxbuf->size += Handle->_password_len;
+
+    if((tmp = attachBuffer(reader, rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+
+    addHeader(reader->_cmdID++, rxtxbuf, rxtxbuf->size);
+    addAVP(rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
+    addBytes(rxtxbuf, Handle->_address, Handle->_address_len);
+    addAVP(rxtxbuf, sizeof(Bank), AVP_MEMBANK, &Bank);
+    addAVP(rxtxbuf, sizeof(ByteAddress), AVP_TAGADDRESS, &ByteAddress);
+    addAVP(rxtxbuf, sizeof(ByteLength), AVP_LENGTH, &ByteLength);
+    if(cmd == CMD_G2WRITE)
+    {
+        addAVP(rxtxbuf, ByteLength, AVP_TAG_VALUE, Data);
+    }
+    addBytes(rxtxbuf, Handle->_password, Handle->_password_len);
+    return CAENRFID_StatusOK;
+}
+
+static CAENRFIDErrorCodes decodeTagData(IOBuffer_t* rxtxbuf,
+                                        uint16_t cmd,
+                                        uint8_t* Data)
+{
+    AVPIndex_t index;
+    uint16_t result_code;
+
+    //extract data
+    rxtxbuf->rpos = HEADER_LEN;
+    if(scanAVPs(rxtxbuf, &index) != 0) return CAENRFID_CommunicationError;
+    if(findAVP(&index, AVP_COMMAND, &cmd) != 0) return CAENRFID_CommunicationError;
+    if(cmd == CMD_G2READ)
+    {
+        if(findAVP(&index, AVP_TAG_VALUE, Data) < 0) return CAENRFID_CommunicationError;
+    }
+    if(findAVP(&index, AVP_RESULT_CODE, &result_code) != 0) return CAENRFID_CommunicationError;
+    return (CAENRFIDErrorCodes)result_code;
+}
+
+CAENRFIDErrorCodes CAENRFID_ReadTagDataHandle_EPC_C1G2(CAENRFIDReader* reader,
+                                                       const CAENRFIDTagHandle* Handle,
+                                                       uint16_t Bank,
+                                                       uint16_t ByteAddress,
+                                                       uint16_t ByteLength,
+                                                       uint8_t* Data)
+{
+    CAENRFIDErrorCodes ret;
+    int16_t tmp;
+    IOBuffer_t rxtxbuf = {0};
+
+    ret = encodeTagData(reader, &rxtxbuf, CMD_G2READ, Handle, Bank,
+                        ByteAddress, ByteLength, NULL);
+    if(ret != CAENRFID_StatusOK) return (ret);
+    //send command and get reply
+    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+    return decodeTagData(&rxtxbuf, CMD_G2READ, Data);
+}
+
+CAENRFIDErrorCodes CAENRFID_ReadTagData_EPC_C1G2(CAENRFIDReader* reader,
+                                                 CAENRFIDTag* Tag,
+                                                 uint16_t Bank,
+                                                 uint16_t ByteAddress,
+                                                 uint16_t ByteLength,
+                                                 uint8_t* Data,
+                                                 uint32_t AccessPassword)
+{
+    CAENRFIDErrorCodes ret;
+    CAENRFIDTagHandle Handle;
+
+    if((ret = CAENRFID_TagHandleInit(&Handle, Tag, AccessPassword)) != CAENRFID_StatusOK) return (ret);
+    return CAENRFID_ReadTagDataHandle_EPC_C1G2(reader, &Handle, Bank, ByteAddress, ByteLength, Data);
+}
+
+CAENRFIDErrorCodes CAENRFID_WriteTagDataHandle_EPC_C1G2(CAENRFIDReader* reader,
+                                                        const CAENRFIDTagHandle* Handle,
+                                                        uint16_t Bank,
+                                                        uint16_t ByteAddress,
+                                                        uint16_t ByteLength,
+                                                        uint8_t* Data)
+{
+    CAENRFIDErrorCodes ret;
+    int16_t tmp;
+    IOBuffer_t rxtxbuf = {0};
+
+    ret = encodeTagData(reader, &rxtxbuf, CMD_G2WRITE, Handle, Bank,
+                        ByteAddress, ByteLength, Data);
+    if(ret != CAENRFID_StatusOK) return (ret);
+    //send command and get reply
+    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+    return decodeTagData(&rxtxbuf, CMD_G2WRITE, NULL);
+}
+
+CAENRFIDErrorCodes CAENRFID_WriteTagData_EPC_C1G2(CAENRFIDReader* reader,
+                                                  CAENRFIDTag* Tag,
+                                                  uint16_t Bank,
+                                                  uint16_t ByteAddress,
+                                                  uint16_t ByteLength,
+                                                  uint8_t* Data,
+                                                  uint32_t AccessPassword)
+{
+    CAENRFIDErrorCodes ret;
+    CAENRFIDTagHandle Handle;
+
+    if((ret = CAENRFID_TagHandleInit(&Handle, Tag, AccessPassword)) != CAENRFID_StatusOK) return (ret);
+    return CAENRFID_WriteTagDataHandle_EPC_C1G2(reader, &Handle, Bank, ByteAddress, ByteLength, Data);
+}
+
+static CAENRFIDErrorCodes tagCommand(CAENRFIDReader* reader,
+                                     const CAENRFIDTagHandle* Handle,
+                                     uint16_t cmd,
+                                     uint16_t wtype,
+                                     uint16_t len,
+                                     void* value,
+                                     bool password)
+{
+    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
+    int16_t tmp;
+    uint16_t result_code;
+    IOBuffer_t rxtxbuf = {0};
+
+    //build request: the tag address, one parameter and the access password
+    rxtxbuf.size  = HEADER_LEN;
+    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
+    rxtxbuf.size += Handle->_address_len;
+    rxtxbuf.size += sizeAVP(wtype, len);
+    if(password)
+    {
+        rxtxbuf.size += Handle->_password_len;
+    }
+
+    if((tmp = attachBuffer(reader, &rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+
+    addHeader(reader->_cmdID++, &rxtxbuf, rxtxbuf.size);
+    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
+    addBytes(&rxtxbuf, Handle->_address, Handle->_address_len);
+    addAVP(&rxtxbuf, len, wtype, value);
+    if(password)
+    {
+        addBytes(&rxtxbuf, Handle->_password, Handle->_password_len);
+    }
+    //send command and get reply
+    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf)) != 0)
+    {
+        ret = (CAENRFIDErrorCodes) tmp;
+        goto exit_done;
+    }
+    //extract data
+    rxtxbuf.rpos = HEADER_LEN;
+    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
+    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
+    ret = (CAENRFIDErrorCodes)result_code;
+
+    exit_done:
+    return (ret);
+}
+
+CAENRFIDErrorCodes CAENRFID_LockTagHandle_EPC_C1G2(CAENRFIDReader* reader,
+                                                   const CAENRFIDTagHandle* Handle,
+                                                   uint32_t Payload)
+{
+    return tagCommand(reader, Handle, CMD_G2LOCK, AVP_PAYLOAD, sizeof(Payload), &Payload, true);
+}
+
+CAENRFIDErrorCodes CAENRFID_LockTag_EPC_C1G2(CAENRFIDReader* reader,
+                                             CAENRFIDTag *Tag,
+                                             uint32_t Payload,
+                                             uint32_t AccessPassword)
+{
+    CAENRFIDErrorCodes ret;
+    CAENRFIDTagHandle Handle;
+
+    if((ret = CAENRFID_TagHandleInit(&Handle, Tag, AccessPassword)) != CAENRFID_StatusOK) return (ret);
+    return CAENRFID_LockTagHandle_EPC_C1G2(reader, &Handle, Payload);
+}
+
+CAENRFIDErrorCodes CAENRFID_KillTagHandle_EPC_C1G2(CAENRFIDReader* reader,
+                                                   const CAENRFIDTagHandle* Handle,
+                                                   uint32_t Password)
+{
+    //the kill password replaces the access one
+    return tagCommand(reader, Handle, CMD_G2KILL, AVP_G2PWD, sizeof(Password), &Password, false);
+}
+
+CAENRFIDErrorCodes CAENRFID_KillTag_EPC_C1G2(CAENRFIDReader* reader,
+                                             CAENRFIDTag *Tag,
+                                             uint32_t Password)
+{
+    CAENRFIDErrorCodes ret;
+    CAENRFIDTagHandle Handle;
+
+    if((ret = CAENRFID_TagHandleInit(&Handle, Tag, 0)) != CAENRFID_StatusOK) return (ret);
+    return CAENRFID_KillTagHandle_EPC_C1G2(reader, &Handle, Password);
+}
+
+CAENRFIDErrorCodes CAENRFID_ProgramIDHandle_EPC_C1G2(CAENRFIDReader* reader,
+                                                     const CAENRFIDTagHandle* Handle,
+                                                     uint16_t nsi)
+{
+    return tagCommand(reader, Handle, CMD_G2PROGRAMID, AVP_G2NSI, sizeof(nsi), &nsi, true);
+}
+
+CAENRFIDErrorCodes CAENRFID_ProgramID_EPC_C1G2(CAENRFIDReader* reader,
+                                               CAENRFIDTag *Tag,
+                                               uint16_t nsi,
+                                               uint32_t AccessPassword)
+{
+    CAENRFIDErrorCodes ret;
+    CAENRFIDTagHandle Handle;
+
+    if((ret = CAENRFID_TagHandleInit(&Handle, Tag, AccessPassword)) != CAENRFID_StatusOK) return (ret);
+    return CAENRFID_ProgramIDHandle_EPC_C1G2(reader, &Handle, nsi);
+}
+
+CAENRFIDErrorCodes CAENRFID_CustomCommandHandle_EPC_C1G2(CAENRFIDReader* reader,
+                                                         const CAENRFIDTagHandle* Handle,
+                                                         uint8_t SubCmd,
+                                                         uint16_t TxLen,
+                                                         uint8_t *Data,
+                                                         uint16_t RxLen,
+                                                         uint8_t *TRData)
+{
+    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
+    uint16_t  cmd;
+    int16_t tmp;
+    uint16_t result_code;
+    IOBuffer_t rxtxbuf = { 0 };
+    AVPIndex_t index;
+
+    cmd = CMD_G2CUSTOM;
+    //build request
+    rxtxbuf.size = HEADER_LEN;
+    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
+    rxtxbuf.size += Handle->_address_len;
+    rxtxbuf.size += sizeAVP(AVP_SUBCMD, sizeof(SubCmd));
+    if(TxLen != 0)
+    {
+        rxtxbuf.size += sizeAVP(AVP_LENGTH, sizeof(TxLen));
+        rxtxbuf.size += sizeAVP(AVP_TAG_VALUE, TxLen);
+    }
+    rxtxbuf.size += sizeAVP(AVP_LENGTH, sizeof(RxLen));
+    rxtxbuf.size += Handle->_password_len;
+
+    if((tmp = attachBuffer(reader, &rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+
+    addHeader(reader->_cmdID++, &rxtxbuf, rxtxbuf.size);
+    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
+    addBytes(&rxtxbuf, Handle->_address, Handle->_address_len);
+    addAVP(&rxtxbuf, 1, AVP_SUBCMD, &SubCmd);
+    if(TxLen != 0)
+    {
+        addAVP(&rxtxbuf, sizeof(TxLen), AVP_LENGTH, &TxLen);
+        addAVP(&rxtxbuf, TxLen, AVP_TAG_VALUE, Data);
+    }
+    addAVP(&rxtxbuf, sizeof(RxLen), AVP_LENGTH, &RxLen);
+    addBytes(&rxtxbuf, Handle->_password, Handle->_password_len);
+    //send command and get reply
+    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf)) != 0)
+    {
+        ret = (CAENRFIDErrorCodes)tmp;
+        goto exit_done;
+    }
+    //extract data
+    rxtxbuf.rpos = HEADER_LEN;
+    if(scanAVPs(&rxtxbuf, &index) != 0) goto exit_done;
+    if(findAVP(&index, AVP_COMMAND, &cmd) != 0) goto exit_done;
+    if(findAVP(&index, AVP_TAG_VALUE, TRData) < 0) goto exit_done;
+    if(findAVP(&index, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
+    ret = (CAENRFIDErrorCodes)result_code;
+
+    exit_done:
+    return (ret);
+}
+
+CAENRFIDErrorCodes CAENRFID_CustomCommand_EPC_C1G2(CAENRFIDReader* reader,
+                                                   CAENRFIDTag *Tag,
+                                                   uint8_t SubCmd,
+                                                   uint16_t TxLen,
+                                                   uint8_t *Data,
+                                                   uint16_t RxLen,
+                                                   uint32_t AccessPassword,
+                                                   uint8_t *TRData)
+{
+    CAENRFIDErrorCodes ret;
+    CAENRFIDTagHandle Handle;
+
+    if((ret = CAENRFID_TagHandleInit(&Handle, Tag, AccessPassword)) != CAENRFID_StatusOK) return (ret);
+    return CAENRFID_CustomCommandHandle_EPC_C1G2(reader, &Handle, SubCmd, TxLen, Data, RxLen, TRData);
+}
+
+CAENRFIDErrorCodes CAENRFID_GroupSelUnsel(CAENRFIDReader* reader,
+                                         char* SourceName,
+                                         CAENRFIDSelUnselOptions Code,
+                                         uint16_t Address,
+                                         uint8_t BitMask,
+                                         uint8_t* Data)
+{
+    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
+    uint16_t  cmd;
+    int16_t tmp;
+    uint16_t result_code;
+    IOBuffer_t rxtxbuf = {0};
+    uint16_t op = Code;
+    uint16_t bitmask = BitMask;
+
+    cmd = CMD_GROUPSELUNSEL;
+    //build request
+    rxtxbuf.size  = HEADER_LEN;
+    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
+    rxtxbuf.size += sizeAVP(AVP_SOURCE_NAME, strlen(SourceName) + 1);
+    rxtxbuf.size += sizeAVP(AVP_SELUNSEL_OP, sizeof(op));
+    rxtxbuf.size += sizeAVP(AVP_TAGADDRESS, sizeof(Address));
+    rxtxbuf.size += sizeAVP(AVP_BITMASK, sizeof(bitmask));
+    rxtxbuf.size += sizeAVP(AVP_TAG_VALUE, 8);
+
+    if((tmp = attachBuffer(reader, &rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+
+    addHeader(reader->_cmdID++, &rxtxbuf, rxtxbuf.size);
+    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
+    addAVP(&rxtxbuf, (uint16_t)strlen(SourceName) + 1, AVP_SOURCE_NAME, SourceName);
+    addAVP(&rxtxbuf, sizeof(op), AVP_SELUNSEL_OP, &op);
+    addAVP(&rxtxbuf, sizeof(Address), AVP_TAGADDRESS, &Address);
+    addAVP(&rxtxbuf, sizeof(bitmask), AVP_BITMASK, &bitmask);
+    addAVP(&rxtxbuf, 8, AVP_TAG_VALUE, Data);
+    //send command and get reply
+    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
+    {
+        ret = (CAENRFIDErrorCodes) tmp;
+        goto exit_done;
+    }
+    //extract data
+    rxtxbuf.rpos = HEADER_LEN;
+    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
+    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
+    ret = (CAENRFIDErrorCodes)result_code;
+
+    exit_done:
+    return (ret);
+}
+
+static CAENRFIDErrorCodes encodeInventory(CAENRFIDReader* reader,
+                                          IOBuffer_t* rxtxbuf,
+                                          CAENRFIDInventoryParams* params,
+                                          char* SourceName,
+                                          uint16_t Bank,
+                                          uint16_t MaskBitAddress,
+                                          uint16_t MaskBitLength,
+                                          uint8_t* Mask,
+                                          uint16_t MaskLen,
+                                          uint16_t flag)
+{
+    uint16_t  cmd;
+    int16_t tmp;
+    bool has_mask = false;
+#if CAENRFID_TEMPLATE_SLOTS > 0
+    uint8_t key[CAENRFID_TEMPLATE_LENGTH];
+    uint16_t key_len = 0;
+    uint16_t fields[5];
+    size_t src_len;
+#endif
+
+    flag &= 0x017f;
+    memset(params, 0, sizeof(*params));
+    if((flag & RSSI) == RSSI) params->has_RSSI =1;
+    if((flag & FRAMED) == FRAMED) params->has_framed = 1;
+    if((flag & CONTINUOS) == CONTINUOS) params->has_continuous = 1;
+    if((flag & COMPACT) == COMPACT) params->has_compact = 1;
+    if((flag & TID_READING) == TID_READING) params->has_TID = 1;
+    if((flag & EVENT_TRIGGER) == EVENT_TRIGGER) params->has_event_trigger = 1;
+    if((flag & XPC) == 0x40) params->has_XPC = 1;
+    if((flag & PC) == 0x100) params->has_PC = 1;
+
+    if(params->has_continuous != params->has_framed) return CAENRFID_InvalidParam;
+    if(params->has_event_trigger && !params->has_framed) return CAENRFID_InvalidParam;
+
+    if(MaskBitLength > 0 && Mask != NULL)
+    {
+        if(MaskBitLength/8 + ((MaskBitLength%8 != 0) ? 1 : 0) > MaskLen) return CAENRFID_InvalidParam;
+        has_mask = true;
+    }
+
+    cmd = CMD_INVENTORY;
+    //build request
+    rxtxbuf->size  = HEADER_LEN;
+    rxtxbuf->size += sizeAVP(AVP_COMMAND, sizeof(cmd));
+    rxtxbuf->size += sizeAVP(AVP_SOURCE_NAME, strlen(SourceName) + 1);
+    if(has_mask)
+    {
+        rxtxbuf->size += sizeAVP(AVP_MEMBANK, sizeof(Bank));
+        rxtxbuf->size += sizeAVP(AVP_LENGTH, sizeof(MaskBitLength));
+        rxtxbuf->size += sizeAVP(AVP_TAGID, MaskLen);
+        rxtxbuf->size += sizeAVP(AVP_TAGADDRESS, sizeof(MaskBitAddress));
+    }
+    if(flag != 0)
+    {
+        rxtxbuf->size += sizeAVP(AVP_BITMASK, sizeof(flag));
+    }
+
+    if((tmp = attachBuffer(reader, rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+
+#if CAENRFID_TEMPLATE_SLOTS > 0
+    //the frame only depends on the parameters packed in key
+    src_len = strlen(SourceName);
+    if(sizeof(fields) + src_len + (has_mask ? MaskLen : 0) <= sizeof(key))
+    {
+        fields[0] = flag;
+        fields[1] = has_mask ? Bank : 0;
+        fields[2] = has_mask ? MaskBitAddress : 0;
+        fields[3] = has_mask ? MaskBitLength : 0;
+        fields[4] = has_mask ? MaskLen : 0;
+        memcpy(key, fields, sizeof(fields));
+        memcpy(&key[sizeof(fields)], SourceName, src_len);
+        key_len = (uint16_t)(sizeof(fields) + src_len);
+        if(has_mask)
+        {
+            memcpy(&key[key_len], Mask, MaskLen);
+            key_len += MaskLen;
+        }
+        if(getTemplate(reader, rxtxbuf, cmd, key, key_len)) return CAENRFID_StatusOK;
+    }
+#endif
+    addHeader(reader->_cmdID++, rxtxbuf, rxtxbuf->size);
+    addAVP(rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
+    addAVP(rxtxbuf, (uint16_t)strlen(SourceName) + 1, AVP_SOURCE_NAME, SourceName);
+    if(has_mask)
+    {
+        addAVP(rxtxbuf, sizeof(Bank), AVP_MEMBANK, &Bank);
+        addAVP(rxtxbuf, sizeof(MaskBitLength), AVP_LENGTH, &MaskBitLength);
+        addAVP(rxtxbuf, MaskLen, AVP_TAGID, Mask);
+        addAVP(rxtxbuf, sizeof(MaskBitAddress), AVP_TAGADDRESS, &MaskBitAddress);
+    }
+    if(flag != 0)
+    {
+        addAVP(rxtxbuf, sizeof(flag), AVP_BITMASK, &flag);
+    }
+#if CAENRFID_TEMPLATE_SLOTS > 0
+    if(key_len != 0) putTemplate(reader, rxtxbuf, cmd, key, key_len);
+#endif
+    return CAENRFID_StatusOK;
+}
+
+static CAENRFIDErrorCodes sendInventory(CAENRFIDReader* reader,
+                                        IOBuffer_t* rxtxbuf,
+                                        CAENRFIDInventoryParams* params,
+                                        char* SourceName,
+                                        uint16_t Bank,
+                                        uint16_t MaskBitAddress,
+                                        uint16_t MaskBitLength,
+                                        uint8_t* Mask,
+                                        uint16_t MaskLen,
+                                        uint16_t flag)
+{
+    CAENRFIDErrorCodes ret;
+    uint16_t  cmd;
+    int16_t tmp;
+
+    ret = encodeInventory(reader, rxtxbuf, params, SourceName, Bank,
+                          MaskBitAddress, MaskBitLength, Mask, MaskLen, flag);
+    if(ret != CAENRFID_StatusOK) return (ret);
+    //send command and get reply
+    if((tmp = sendReceive(reader, rxtxbuf, rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+    //skip the command AVP, tags follow
+    rxtxbuf->rpos = HEADER_LEN;
+    if(getAVP(rxtxbuf, AVP_COMMAND, &cmd) != 0) return CAENRFID_LibraryError;
+    //a whole reply is validated once, before any tag is taken from it
+    if(!params->has_framed && (scanAVPs(rxtxbuf, NULL) != 0)) return CAENRFID_CommunicationError;
+    return CAENRFID_StatusOK;
+}
+
+#ifndef CAENRFID_NO_HEAP
+static CAENRFIDErrorCodes getTagList(IOBuffer_t* rxtxbuf,
+                                     CAENRFIDInventoryParams* params,
+                                     CAENRFIDTagList** TagList,
+                                     uint16_t* Size)
+{
+    CAENRFIDErrorCodes ret = CAENRFID_LibraryError;
+    CAENRFIDTagList* list_el = NULL;
+    uint16_t result_code;
+
+    *Size = 0;
+    while(1)
+    {
+        if((list_el = malloc(sizeof(CAENRFIDTagList))) == NULL)
+        {
+            ret = CAENRFID_OutOfMemoryError;
+            break;
+        }
+        list_el->Next = *TagList;
+        if(getScannedTag(rxtxbuf, params, &list_el->Tag) != 0) break;
+        *TagList = list_el;
+        (*Size)++;
+    }
+    // if exited from previous loop, then last tag has not been linked to
+    // TagList yet and must be removed.
+    free(list_el);
+    if(getAVP(rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) return (ret);
+    return (CAENRFIDErrorCodes)result_code;
+}
+#endif
+
+CAENRFIDErrorCodes CAENRFID_InventoryTag(CAENRFIDReader* reader,
+                                         char* SourceName,
+                                         uint16_t Bank,
+                                         uint16_t MaskBitAddress,
+                                         uint16_t MaskBitLength,
+                                         uint8_t* Mask,
+                                         uint16_t MaskLen,
+                                         uint16_t flag,
+                                         CAENRFIDTagList** TagList,
+                                         uint16_t* Size)
+{
+    CAENRFIDErrorCodes ret;
+    IOBuffer_t rxtxbuf = {0};
+    CAENRFIDInventoryParams params;
+
+#ifdef CAENRFID_NO_HEAP
+    //the tag list is heap allocated
+    (void) TagList;
+    (void) Size;
+    if((flag & FRAMED) == 0) return CAENRFID_OutOfMemoryError;
+#endif
+    ret = sendInventory(reader, &rxtxbuf, &params, SourceName, Bank,
+                        MaskBitAddress, MaskBitLength, Mask, MaskLen, flag);
+    if(ret != CAENRFID_StatusOK) return (ret);
+    if(!params.has_framed)
+    {
+#ifndef CAENRFID_NO_HEAP
+        ret = getTagList(&rxtxbuf, &params, TagList, Size);
+#endif
+    }
+    else
+    {
+        reader->_inventory_params = params;
+        selectFramedDecoder(reader);
+    }
+    return (ret);
+}
+
+CAENRFIDErrorCodes CAENRFID_InventoryTagArray(CAENRFIDReader* reader,
+                                              char* SourceName,
+                                              uint16_t Bank,
+                                              uint16_t MaskBitAddress,
+                                              uint16_t MaskBitLength,
+                                              uint8_t* Mask,
+                                              uint16_t MaskLen,
+                                              uint16_t flag,
+                                              CAENRFIDTag* Tags,
+                                              uint16_t MaxTags,
+                                              uint16_t* Size,
+                                              uint16_t* Found)
+{
+    CAENRFIDErrorCodes ret;
+    IOBuffer_t rxtxbuf = {0};
+    CAENRFIDInventoryParams params;
+    CAENRFIDTag discarded;
+    uint16_t result_code;
+
+    if((flag & (FRAMED | CONTINUOS | EVENT_TRIGGER)) != 0) return CAENRFID_InvalidParam;
+    *Size = 0;
+    *Found = 0;
+    ret = sendInventory(reader, &rxtxbuf, &params, SourceName, Bank,
+                        MaskBitAddress, MaskBitLength, Mask, MaskLen, flag);
+    if(ret != CAENRFID_StatusOK) return (ret);
+    //tags are stored in the order they are received, the ones
+    //exceeding MaxTags are parsed and counted but not stored
+    while(getScannedTag(&rxtxbuf, &params, (*Found < MaxTags) ? &Tags[*Found] : &discarded) == 0)
+    {
+        (*Found)++;
+    }
+    *Size = (*Found < MaxTags) ? *Found : MaxTags;
+    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) return CAENRFID_LibraryError;
+    return (CAENRFIDErrorCodes)result_code;
+}
+
+CAENRFIDErrorCodes CAENRFID_InventoryTagFrame(CAENRFIDReader* reader,
+                                              char* SourceName,
+                                              uint16_t Bank,
+                                              uint16_t MaskBitAddress,
+                                              uint16_t MaskBitLength,
+                                              uint8_t* Mask,
+                                              uint16_t MaskLen,
+                                              uint16_t flag,
+                                              CAENRFIDTagFrame* Frame)
+{
+    CAENRFIDErrorCodes ret;
+    IOBuffer_t rxtxbuf = {0};
+
+    if((flag & (FRAMED | CONTINUOS | EVENT_TRIGGER)) != 0) return CAENRFID_InvalidParam;
+    ret = sendInventory(reader, &rxtxbuf, &Frame->_params, SourceName, Bank,
+                        MaskBitAddress, MaskBitLength, Mask, MaskLen, flag);
+    if(ret != CAENRFID_StatusOK) return (ret);
+    //tags are parsed from the reader buffer, which is kept until release
+    Frame->_reader = reader;
+    Frame->_rpos = rxtxbuf.rpos;
+    Frame->_size = rxtxbuf.size;
+    reader->_buffer_held = true;
+    return CAENRFID_StatusOK;
+}
+
+CAENRFIDErrorCodes CAENRFID_TagFrameNext(CAENRFIDTagFrame* Frame,
+                                         CAENRFIDTagView* View)
+{
+    IOBuffer_t rxtxbuf = {0};
+    uint16_t result_code;
+
+    if((Frame->_reader == NULL) || !Frame->_reader->_buffer_held) return CAENRFID_InvalidParam;
+    rxtxbuf.memory = Frame->_reader->_buffer;
+    rxtxbuf.size = Frame->_size;
+    rxtxbuf.rpos = Frame->_rpos;
+    if(viewTag(&rxtxbuf, &Frame->_params, View) == 0)
+    {
+        Frame->_rpos = rxtxbuf.rpos;
+        return CAENRFID_StatusOK;
+    }
+    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) return CAENRFID_LibraryError;
+    if(result_code != CAENRFID_StatusOK) return (CAENRFIDErrorCodes)result_code;
+    return CAENRFID_EOF;
+}
+
+void CAENRFID_TagFrameRelease(CAENRFIDTagFrame* Frame)
+{
+    if(Frame->_reader != NULL) Frame->_reader->_buffer_held = false;
+    Frame->_reader = NULL;
+}
+
+CAENRFIDErrorCodes CAENRFID_InventoryTagStream(CAENRFIDReader* reader,
+                                               char* SourceName,
+                                               uint16_t Bank,
+                                               uint16_t MaskBitAddress,
+                                               uint16_t MaskBitLength,
+                                               uint8_t* Mask,
+                                               uint16_t MaskLen,
+                                               uint16_t flag,
+                                               const CAENRFIDInventoryCallbacks* Callbacks)
+{
+    CAENRFIDErrorCodes ret;
+    IOBuffer_t txbuf = {0};
+    CAENRFIDInventoryParams params;
+    CAENRFIDTag Tag;
+    bool has_tag, has_result_code, deliver = true;
+    int16_t tmp;
+
+    if((Callbacks == NULL) || (Callbacks->on_tag == NULL)) return CAENRFID_InvalidParam;
+    ret = encodeInventory(reader, &txbuf, &params, SourceName, Bank,
+                          MaskBitAddress, MaskBitLength, Mask, MaskLen, flag);
+    if(ret != CAENRFID_StatusOK) return (ret);
+    //only the reply header is received here, tags are parsed off the wire
+    //by receiveFramedTag whether the reply is framed or not
+    if((tmp = sendReceiveHead(reader, &txbuf)) != 0)
+    {
+        ret = (CAENRFIDErrorCodes) tmp;
+        if(Callbacks->on_error != NULL) Callbacks->on_error(Callbacks->ctx, ret);
+        return (ret);
+    }
+    reader->_inventory_params = params;
+    selectFramedDecoder(reader);
+    while(1)
+    {
+        tmp = receiveFramedTag(reader, &has_tag, &Tag, &has_result_code);
+        if(has_result_code)
+        {
+            ret = (CAENRFIDErrorCodes) tmp;
+            if(Callbacks->on_round_end != NULL) Callbacks->on_round_end(Callbacks->ctx, ret);
+            return (ret);
+        }
+        //a simple round is sent at once, only a framed one may pause
+        if((tmp == 0) && !has_tag && !params.has_framed) tmp = CAENRFID_CommunicationError;
+        if(tmp != 0)
+        {
+            ret = (CAENRFIDErrorCodes) tmp;
+            if(Callbacks->on_error != NULL) Callbacks->on_error(Callbacks->ctx, ret);
+            return (ret);
+        }
+        if(has_tag && deliver && !Callbacks->on_tag(Callbacks->ctx, &Tag))
+        {
+            //the reader still sends the result code once aborted
+            deliver = false;
+            if(params.has_framed && ((tmp = sendAbort(reader)) != 0))
+            {
+                ret = (CAENRFIDErrorCodes) tmp;
+                if(Callbacks->on_error != NULL) Callbacks->on_error(Callbacks->ctx, ret);
+                return (ret);
+            }
+        }
+    }
+}
+
+CAENRFIDErrorCodes CAENRFID_GetFramedTag(CAENRFIDReader* reader,
+                                         bool* has_tag,
+                                         CAENRFIDTag* Tag,
+                                         bool* has_result_code)
+{
+    return (CAENRFIDErrorCodes) receiveFramedTag(reader, has_tag, Tag, has_result_code);
+}
+
+CAENRFIDErrorCodes CAENRFID_InventoryAbort(CAENRFIDReader* reader)
+{
+    return (CAENRFIDErrorCodes) sendAbort(reader);
+}
+
+CAENRFIDErrorCodes CAENRFID_GetBufferSize(CAENRFIDReader* reader,
+                                          uint32_t* Size)
+{
+    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
+    uint16_t  cmd;
+    int16_t tmp;
+    uint16_t result_code;
+    IOBuffer_t rxtxbuf = {0};
+    AVPIndex_t index;
+
+    cmd = CMD_GETBUFFERSIZE;
+    //build request
+    rxtxbuf.size  = HEADER_LEN;
+    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
+
+    if((tmp = attachBuffer(reader, &rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+
+    addHeader(reader->_cmdID++, &rxtxbuf, rxtxbuf.size);
+    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
+    //send command and get reply
+    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
+    {
+        ret = (CAENRFIDErrorCodes) tmp;
+        goto exit_done;
+    }
+    //extract data
+    rxtxbuf.rpos = HEADER_LEN;
+    if(scanAVPs(&rxtxbuf, &index) != 0) goto exit_done;
+    if(findAVP(&index, AVP_COMMAND, &cmd) != 0) goto exit_done;
+    if(findAVP(&index, AVP_LONG_LENGTH, Size) < 0) goto exit_done;
+    if(findAVP(&index, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
+    ret = (CAENRFIDErrorCodes)result_code;
+
+    exit_done:
+    return (ret);
+}
+
+CAENRFIDErrorCodes CAENRFID_ClearBuffer(CAENRFIDReader* reader)
+{
+    CAENRFIDErrorCodes ret = CAENRFID_CommunicationError;
+    uint16_t  cmd;
+    int16_t tmp;
+    uint16_t result_code;
+    IOBuffer_t rxtxbuf = {0};
+
+    cmd = CMD_CLEARBUFFER;
+    //build request
+    rxtxbuf.size  = HEADER_LEN;
+    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
+
+    if((tmp = attachBuffer(reader, &rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+
+    addHeader(reader->_cmdID++, &rxtxbuf, rxtxbuf.size);
+    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
+    //send command and get reply
+    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf))!= 0)
+    {
+        ret = (CAENRFIDErrorCodes) tmp;
+        goto exit_done;
+    }
+    //extract data
+    rxtxbuf.rpos = HEADER_LEN;
+    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) goto exit_done;
+    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) goto exit_done;
+    ret = (CAENRFIDErrorCodes)result_code;
+
+    exit_done:
+    return (ret);
+}
+
+static uint16_t bufferedTagSize(const CAENRFIDInventoryParams* params)
+{
+    uint16_t size;
+
+    //largest encoding of a buffered tag, buffered reads are never compact
+    size  = sizeAVP(AVP_SOURCE_NAME, MAX_LOGICAL_SOURCE_NAME);
+    size += sizeAVP(AVP_READPOINT_NAME, MAX_READPOINT_NAME);
+    size += sizeAVP(AVP_TIMESTAMP, 2 * sizeof(uint32_t));
+    size += sizeAVP(AVP_TAGTYPE, sizeof(uint16_t));
+    size += sizeAVP(AVP_TAGIDLEN, sizeof(uint16_t));
+    size += sizeAVP(AVP_TAGID, MAX_ID_LENGTH);
+    if(params->has_RSSI) size += sizeAVP(AVP_RSSI, sizeof(int16_t));
+    if(params->has_TID)
+    {
+        size += sizeAVP(AVP_LENGTH, sizeof(uint16_t));
+        size += sizeAVP(AVP_TAG_VALUE, MAX_TID_SIZE);
+    }
+    if(params->has_XPC) size += sizeAVP(AVP_XPC, XPC_LENGTH);
+    if(params->has_PC) size += sizeAVP(AVP_PC, PC_LENGTH);
+    return (size);
+}
+
+CAENRFIDErrorCodes CAENRFID_GetBufferedData(CAENRFIDReader* reader,
+                                            uint16_t flag,
+                                            CAENRFIDTag* Tags,
+                                            uint16_t MaxTags,
+                                            uint16_t* Size)
+{
+    uint16_t  cmd;
+    int16_t tmp;
+    uint16_t result_code;
+    uint16_t count;
+    uint32_t room;
+    IOBuffer_t rxtxbuf = {0};
+    CAENRFIDInventoryParams params;
+
+    *Size = 0;
+    if((flag & ~(RSSI | TID_READING | XPC | PC)) != 0) return CAENRFID_InvalidParam;
+    memset(&params, 0, sizeof(params));
+    if((flag & RSSI) == RSSI) params.has_RSSI = 1;
+    if((flag & TID_READING) == TID_READING) params.has_TID = 1;
+    if((flag & XPC) == XPC) params.has_XPC = 1;
+    if((flag & PC) == PC) params.has_PC = 1;
+    //ask no more tags than Tags and the reader buffer can hold
+    room = reader->_buffer_size - HEADER_LEN - sizeAVP(AVP_COMMAND, sizeof(cmd)) - sizeAVP(AVP_RESULT_CODE, sizeof(result_code));
+    count = (uint16_t)((room / bufferedTagSize(&params) < MaxTags) ? room / bufferedTagSize(&params) : MaxTags);
+    if(count == 0) return CAENRFID_InvalidParam;
+
+    cmd = CMD_GETBUFFEREDDATA;
+    //build request
+    rxtxbuf.size  = HEADER_LEN;
+    rxtxbuf.size += sizeAVP(AVP_COMMAND, sizeof(cmd));
+    rxtxbuf.size += sizeAVP(AVP_LENGTH, sizeof(count));
+    if(flag != 0)
+    {
+        rxtxbuf.size += sizeAVP(AVP_BITMASK, sizeof(flag));
+    }
+
+    if((tmp = attachBuffer(reader, &rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+
+    addHeader(reader->_cmdID++, &rxtxbuf, rxtxbuf.size);
+    addAVP(&rxtxbuf, sizeof(cmd), AVP_COMMAND, &cmd);
+    addAVP(&rxtxbuf, sizeof(count), AVP_LENGTH, &count);
+    if(flag != 0)
+    {
+        addAVP(&rxtxbuf, sizeof(flag), AVP_BITMASK, &flag);
+    }
+    //send command and get reply
+    if((tmp = sendReceive(reader, &rxtxbuf, &rxtxbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+    rxtxbuf.rpos = HEADER_LEN;
+    if(getAVP(&rxtxbuf, AVP_COMMAND, &cmd) != 0) return CAENRFID_LibraryError;
+    if(scanAVPs(&rxtxbuf, NULL) != 0) return CAENRFID_CommunicationError;
+    //the reader sends at most count tags, the oldest ones
+    while((*Size < count) && (getScannedTag(&rxtxbuf, &params, &Tags[*Size]) == 0))
+    {
+        (*Size)++;
+    }
+    if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) return CAENRFID_CommunicationError;
+    return (CAENRFIDErrorCodes)result_code;
+}
+
+
+static uint8_t nameIndex(char** Names, int16_t n, const char* Name)
+{
+    int16_t i;
+
+    for(i = 0; i < n; i++)
+    {
+        if(strcmp(Names[i], Name) == 0) return (uint8_t)i;
+    }
+    return PACKED_TAG_NO_INDEX;
+}
+
+void CAENRFID_TagPoolInit(CAENRFIDTagPool* Pool,
+                          CAENRFIDPackedTag* Tags,
+                          uint32_t MaxTags,
+                          uint8_t* Data,
+                          uint32_t DataSize)
+{
+    Pool->Tags = Tags;
+    Pool->MaxTags = MaxTags;
+    Pool->Data = Data;
+    Pool->DataSize = DataSize;
+    Pool->NumTags = 0;
+    Pool->DataUsed = 0;
+}
+
+void CAENRFID_TagPoolClear(CAENRFIDTagPool* Pool)
+{
+    Pool->NumTags = 0;
+    Pool->DataUsed = 0;
+}
+
+CAENRFIDErrorCodes CAENRFID_TagPoolAdd(CAENRFIDTagPool* Pool,
+                                       const CAENRFIDTag* Tag)
+{
+    CAENRFIDPackedTag* packed;
+    uint8_t* data;
+    char** names;
+    int16_t n;
+    uint32_t len;
+    uint8_t flags = 0;
+
+    if((Tag->Length > MAX_ID_LENGTH) || (Tag->TIDLen > MAX_TID_SIZE)) return CAENRFID_InvalidParam;
+    //an all zero XPC or PC is not stored
+    for(n = 0; n < XPC_LENGTH; n++) if(Tag->XPC[n] != 0) flags |= PACKED_TAG_HAS_XPC;
+    for(n = 0; n < PC_LENGTH; n++) if(Tag->PC[n] != 0) flags |= PACKED_TAG_HAS_PC;
+    len = (uint32_t)Tag->Length + Tag->TIDLen;
+    if(flags & PACKED_TAG_HAS_XPC) len += XPC_LENGTH;
+    if(flags & PACKED_TAG_HAS_PC) len += PC_LENGTH;
+    if((Pool->NumTags >= Pool->MaxTags) || (len > Pool->DataSize - Pool->DataUsed)) return CAENRFID_OutOfMemoryError;
+
+    packed = &Pool->Tags[Pool->NumTags];
+    packed->TimeStamp[0] = Tag->TimeStamp[0];
+    packed->TimeStamp[1] = Tag->TimeStamp[1];
+    packed->Offset = Pool->DataUsed;
+    packed->RSSI = Tag->RSSI;
+    packed->IDLen = (uint8_t)Tag->Length;
+    packed->TIDLen = (uint8_t)Tag->TIDLen;
+    getSrcNames(&names, &n);
+    packed->Source = nameIndex(names, n, Tag->LogicalSource);
+    getAntNames(&names, &n);
+    packed->ReadPoint = nameIndex(names, n, Tag->ReadPoint);
+    packed->Type = (uint8_t)Tag->Type;
+    packed->Flags = flags;
+
+    data = &Pool->Data[Pool->DataUsed];
+    memcpy(data, Tag->ID, Tag->Length);
+    data += Tag->Length;
+    memcpy(data, Tag->TID, Tag->TIDLen);
+    data += Tag->TIDLen;
+    if(flags & PACKED_TAG_HAS_XPC)
+    {
+        memcpy(data, Tag->XPC, XPC_LENGTH);
+        data += XPC_LENGTH;
+    }
+    if(flags & PACKED_TAG_HAS_PC) memcpy(data, Tag->PC, PC_LENGTH);
+    Pool->DataUsed += len;
+    Pool->NumTags++;
+    return CAENRFID_StatusOK;
+}
+
+CAENRFIDErrorCodes CAENRFID_TagPoolGet(const CAENRFIDTagPool* Pool,
+                                       uint32_t Index,
+                                       CAENRFIDTag* Tag)
+{
+    const CAENRFIDPackedTag* packed;
+    const uint8_t* data;
+    char** names;
+    int16_t n;
+
+    if(Index >= Pool->NumTags) return CAENRFID_InvalidParam;
+    packed = &Pool->Tags[Index];
+    data = &Pool->Data[packed->Offset];
+    memset(Tag, 0, sizeof(CAENRFIDTag));
+    memcpy(Tag->ID, data, packed->IDLen);
+    Tag->Length = packed->IDLen;
+    data += packed->IDLen;
+    memcpy(Tag->TID, data, packed->TIDLen);
+    Tag->TIDLen = packed->TIDLen;
+    data += packed->TIDLen;
+    if(packed->Flags & PACKED_TAG_HAS_XPC)
+    {
+        memcpy(Tag->XPC, data, XPC_LENGTH);
+        data += XPC_LENGTH;
+    }
+    if(packed->Flags & PACKED_TAG_HAS_PC) memcpy(Tag->PC, data, PC_LENGTH);
+    getSrcNames(&names, &n);
+    if(packed->Source < n) strcpy(Tag->LogicalSource, names[packed->Source]);
+    getAntNames(&names, &n);
+    if(packed->ReadPoint < n) strcpy(Tag->ReadPoint, names[packed->ReadPoint]);
+    Tag->TimeStamp[0] = packed->TimeStamp[0];
+    Tag->TimeStamp[1] = packed->TimeStamp[1];
+    Tag->Type = (CAENRFIDProtocol)packed->Type;
+    Tag->RSSI = packed->RSSI;
+    return CAENRFID_StatusOK;
+}
+
+/*
+    Host side tag filtering
+*/
+static CAENRFIDErrorCodes filterCompile(MatchMask_t* m,
+                                        bool* never,
+                                        uint16_t Bank,
+                                        uint16_t MaskBitAddress,
+                                        uint16_t MaskBitLength,
+                                        uint8_t* Mask,
+                                        uint16_t MaskLen)
+{
+    if(((uint32_t)MaskLen * 8 < MaskBitLength) || ((Bank != EPC_CAEN) && (Bank != TID))) return CAENRFID_InvalidParam;
+    //a mask wider than any bank the host knows of matches nothing
+    *never = (matchCompile(m, MaskBitAddress, MaskBitLength, Mask) != 0);
+    //the CRC word of the EPC bank is not reported with the tag
+    if(!*never && (Bank == EPC_CAEN) && (m->len > 0) && (m->start < 2)) return CAENRFID_InvalidParam;
+    return CAENRFID_StatusOK;
+}
+
+static const uint8_t* tagBank(const CAENRFIDTag* Tag,
+                              uint16_t Bank,
+                              uint16_t First,
+                              uint8_t* image,
+                              uint16_t* Start,
+                              uint16_t* Length)
+{
+    uint16_t len;
+
+    if(Bank == TID)
+    {
+        *Start = 0;
+        *Length = (Tag->TIDLen < MAX_TID_SIZE) ? Tag->TIDLen : MAX_TID_SIZE;
+        return Tag->TID;
+    }
+    //EPC bank is CRC, PC then ID: the ID is used in place unless bytes
+    //from First on include the PC word
+    len = (Tag->Length < MAX_ID_LENGTH) ? Tag->Length : MAX_ID_LENGTH;
+    if(First >= 2 + PC_LENGTH)
+    {
+        *Start = 2 + PC_LENGTH;
+        *Length = len;
+        return Tag->ID;
+    }
+    memcpy(image, Tag->PC, PC_LENGTH);
+    memcpy(&image[PC_LENGTH], Tag->ID, len);
+    *Start = 2;
+    *Length = PC_LENGTH + len;
+    return image;
+}
+
+static bool filterTag(const CAENRFIDTag* Tag, uint16_t Bank, const MatchMask_t* m)
+{
+    uint8_t image[PC_LENGTH + MAX_ID_LENGTH];
+    const uint8_t* mem;
+    uint16_t start, len;
+
+    mem = tagBank(Tag, Bank, m->start, image, &start, &len);
+    return matchMasked(mem, start, len, m);
+}
+
+CAENRFIDErrorCodes CAENRFID_TagMatch(const CAENRFIDTag* Tag,
+                                     uint16_t Bank,
+                                     uint16_t MaskBitAddress,
+                                     uint16_t MaskBitLength,
+                                     uint8_t* Mask,
+                                     uint16_t MaskLen,
+                                     bool* Match)
+{
+    CAENRFIDErrorCodes ret;
+    MatchMask_t m;
+    bool never;
+
+    *Match = false;
+    ret = filterCompile(&m, &never, Bank, MaskBitAddress, MaskBitLength, Mask, MaskLen);
+    if(ret != CAENRFID_StatusOK) return (ret);
+    *Match = !never && filterTag(Tag, Bank, &m);
+    return CAENRFID_StatusOK;
+}
+
+CAENRFIDErrorCodes CAENRFID_FilterTags(CAENRFIDTag* Tags,
+                                       uint32_t NumTags,
+                                       uint16_t Bank,
+                                       uint16_t MaskBitAddress,
+                                       uint16_t MaskBitLength,
+                                       uint8_t* Mask,
+                                       uint16_t MaskLen,
+                                       uint32_t* Size)
+{
+    CAENRFIDErrorCodes ret;
+    MatchMask_t m;
+    bool never;
+    uint32_t i;
+
+    *Size = 0;
+    ret = filterCompile(&m, &never, Bank, MaskBitAddress, MaskBitLength, Mask, MaskLen);
+    if((ret != CAENRFID_StatusOK) || never) return (ret);
+    //matching tags are moved to the front, keeping their order
+    for(i = 0; i < NumTags; i++)
+    {
+        if(!filterTag(&Tags[i], Bank, &m)) continue;
+        if(i != *Size) Tags[*Size] = Tags[i];
+        (*Size)++;
+    }
+    return CAENRFID_StatusOK;
+}
+
+static bool selectTag(const CAENRFIDTag* Tag,
+                      const CAENRFIDSelectClause* Clauses,
+                      const MatchMask_t* m,
+                      const bool* never,
+                      uint16_t NumClauses)
+{
+    bool selected = false;
+    bool match;
+    uint16_t i;
+
+    //clauses are applied in order, as the reader does with a group of
+    //select/unselect commands
+    for(i = 0; i < NumClauses; i++)
+    {
+        match = !never[i] && filterTag(Tag, Clauses[i].Bank, &m[i]);
+        switch(Clauses[i].Op)
+        {
+        case GROUP_SELECT_EQUAL:       selected = selected || match;  break;
+        case GROUP_SELECT_NOT_EQUAL:   selected = selected || !match; break;
+        case GROUP_UNSELECT_EQUAL:     selected = selected && !match; break;
+        case GROUP_UNSELECT_NOT_EQUAL: selected = selected && match;  break;
+        default: break;
+        }
+    }
+    return (selected);
+}
+
+// true if the tag, found after Tags was full, was already found before;
+// without Overflow, or once it is full, every report is taken as new
+static bool selectOverflowSeen(CAENRFIDDedup* Overflow, const CAENRFIDTag* Tag)
+{
+    CAENRFIDDedupEvent event;
+    bool has_event;
+
+    if(Overflow == NULL) return false;
+    if(CAENRFID_DedupAdd(Overflow, Tag, 0, &event, &has_event) != CAENRFID_StatusOK) return false;
+    return !(has_event && (event.Type == CAENRFID_DEDUP_NEW));
+}
+
+CAENRFIDErrorCodes CAENRFID_InventoryTagSelect(CAENRFIDReader* reader,
+                                               char* SourceName,
+                                               const CAENRFIDSelectClause* Clauses,
+                                               uint16_t NumClauses,
+                                               uint16_t flag,
+                                               CAENRFIDTag* Tags,
+                                               uint16_t MaxTags,
+                                               CAENRFIDDedup* Overflow,
+                                               uint16_t* Size,
+                                               uint16_t* Found)
+{
+    CAENRFIDErrorCodes ret;
+    IOBuffer_t rxtxbuf = {0};
+    CAENRFIDInventoryParams params;
+    CAENRFIDTag discarded;
+    CAENRFIDTag* tag;
+    MatchMask_t m[CAENRFID_SELECT_MAX_CLAUSES];
+    bool never[CAENRFID_SELECT_MAX_CLAUSES];
+    bool all = false;
+    uint16_t result_code;
+    uint16_t i, j, first;
+
+    *Size = 0;
+    *Found = 0;
+    if((flag & (FRAMED | CONTINUOS | EVENT_TRIGGER)) != 0) return CAENRFID_InvalidParam;
+    if(NumClauses > CAENRFID_SELECT_MAX_CLAUSES) return CAENRFID_InvalidParam;
+    //a tag is counted once whatever the read point reporting it
+    if((Overflow != NULL) && (Overflow->Flags & DEDUP_BY_READPOINT)) return CAENRFID_InvalidParam;
+    for(i = 0; i < NumClauses; i++)
+    {
+        if(Clauses[i].Op > GROUP_SELECT_NOT_EQUAL &&
+           Clauses[i].Op != GROUP_UNSELECT_EQUAL &&
+           Clauses[i].Op != GROUP_UNSELECT_NOT_EQUAL) return CAENRFID_InvalidParam;
+        //TID clauses are evaluated on the TID reported with each tag
+        if((Clauses[i].Bank == TID) && ((flag & TID_READING) == 0)) return CAENRFID_InvalidParam;
+        ret = filterCompile(&m[i], &never[i], Clauses[i].Bank, Clauses[i].MaskBitAddress,
+                            Clauses[i].MaskBitLength, Clauses[i].Mask, Clauses[i].MaskLen);
+        if(ret != CAENRFID_StatusOK) return (ret);
+        //a not-equal or an empty select clause needs the whole population
+        if((Clauses[i].Op == GROUP_SELECT_NOT_EQUAL) ||
+           ((Clauses[i].Op == GROUP_SELECT_EQUAL) && (m[i].len == 0) && !never[i])) all = true;
+    }
+    //one round per select clause, with its mask sent to the reader, or a
+    //single unmasked round if any select clause needs every tag
+    for(i = 0; i < NumClauses; i++)
+    {
+        if(!all && ((Clauses[i].Op != GROUP_SELECT_EQUAL) || never[i])) continue;
+        if(all)
+        {
+            ret = sendInventory(reader, &rxtxbuf, &params, SourceName, 0, 0, 0, NULL, 0, flag);
+        }
+        else
+        {
+            ret = sendInventory(reader, &rxtxbuf, &params, SourceName, Clauses[i].Bank,
+                                Clauses[i].MaskBitAddress, Clauses[i].MaskBitLength,
+                                Clauses[i].Mask, Clauses[i].MaskLen, flag);
+        }
+        if(ret != CAENRFID_StatusOK) return (ret);
+        //tags already stored by an earlier round are not stored again,
+        //the ones exceeding MaxTags are counted once but not stored
+        first = *Size;
+        while(1)
+        {
+            tag = (*Size < MaxTags) ? &Tags[*Size] : &discarded;
+            if(getScannedTag(&rxtxbuf, &params, tag) != 0) break;
+            if(!selectTag(tag, Clauses, m, never, NumClauses)) continue;
+            for(j = 0; j < first; j++)
+            {
+                if((Tags[j].Length == tag->Length) && matchEqual(Tags[j].ID, tag->ID, tag->Length)) break;
+            }
+            if(j < first) continue;
+            if(*Size < MaxTags) (*Size)++;
+            else if(selectOverflowSeen(Overflow, tag)) continue;
+            (*Found)++;
+        }
+        if(getAVP(&rxtxbuf, AVP_RESULT_CODE, &result_code) != 0) return CAENRFID_LibraryError;
+        if(result_code != CAENRFID_StatusOK) return (CAENRFIDErrorCodes)result_code;
+        if(all) break;
+    }
+    return CAENRFID_StatusOK;
+}
+
+static uint8_t maskBit(const uint8_t* Mask, uint16_t i)
+{
+    return (Mask[i / 8] >> (7 - (i % 8))) & 1;
+}
+
+// longest run of bank bits fixed to the same value by every rule
+static void filterReaderMask(CAENRFIDFilter* Filter)
+{
+    const CAENRFIDFilterRule* r = Filter->Rules;
+    uint8_t broken[FILTER_MAX_MASK_LENGTH * 8];
+    uint32_t i, lo, hi, p, run, best = 0, best_start = 0;
+
+    Filter->ReaderBank = (Filter->NumRules > 0) ? r[0].Bank : EPC_CAEN;
+    Filter->ReaderMaskBitAddress = 0;
+    Filter->ReaderMaskBitLength = 0;
+    Filter->ReaderMaskLen = 0;
+    if(Filter->NumRules == 0) return;
+    lo = r[0].MaskBitAddress;
+    hi = (uint32_t)r[0].MaskBitAddress + r[0].MaskBitLength;
+    for(i = 1; i < Filter->NumRules; i++)
+    {
+        if(r[i].Bank != r[0].Bank) return;
+        if(r[i].MaskBitAddress > lo) lo = r[i].MaskBitAddress;
+        if((uint32_t)r[i].MaskBitAddress + r[i].MaskBitLength < hi) hi = (uint32_t)r[i].MaskBitAddress + r[i].MaskBitLength;
+    }
+    if(lo >= hi) return;
+    memset(broken, 0, hi - lo);
+    for(i = 1; i < Filter->NumRules; i++)
+    {
+        for(p = lo; p < hi; p++)
+        {
+            if(maskBit(r[i].Mask, p - r[i].MaskBitAddress) != maskBit(r[0].Mask, p - r[0].MaskBitAddress)) broken[p - lo] = 1;
+        }
+    }
+    for(p = lo, run = 0; p < hi; p++)
+    {
+        run = broken[p - lo] ? 0 : run + 1;
+        if(run > best)
+        {
+            best = run;
+            best_start = p + 1 - run;
+        }
+    }
+    if(best == 0) return;
+    Filter->ReaderMaskBitAddress = (uint16_t)best_start;
+    Filter->ReaderMaskBitLength = (uint16_t)best;
+    Filter->ReaderMaskLen = (uint16_t)((best + 7) / 8);
+    matchExtract(r[0].Mask, 0, (r[0].MaskBitLength + 7) / 8,
+                 (uint16_t)(best_start - r[0].MaskBitAddress), (uint16_t)best, Filter->ReaderMask);
+}
+
+static bool filterRules(const CAENRFIDFilter* Filter, const CAENRFIDTag* Tag)
+{
+    uint8_t image[PC_LENGTH + MAX_ID_LENGTH], bits[FILTER_MAX_MASK_LENGTH];
+    const CAENRFIDFilterGroup* group;
+    const CAENRFIDFilterRule* r;
+    const uint8_t* mem;
+    uint16_t start, len;
+    uint32_t h, slot, index, mask = Filter->NumSlots - 1;
+    uint8_t g;
+
+    for(g = 0; g < Filter->_num_groups; g++)
+    {
+        group = &Filter->_groups[g];
+        mem = tagBank(Tag, group->_Bank, group->_MaskBitAddress / 8, image, &start, &len);
+        if(matchExtract(mem, start, len, group->_MaskBitAddress, group->_MaskBitLength, bits) != 0) continue;
+        //the tag bits are hashed as the masks of the group were
+        h = matchHash(bits, (group->_MaskBitLength + 7) / 8, g);
+        for(slot = h & mask; (index = Filter->Slots[slot]) != FILTER_NO_RULE; slot = (slot + 1) & mask)
+        {
+            r = &Filter->Rules[index];
+            if((r->_hash == h) && (r->_group == g) && matchBitsEqual(bits, r->Mask, group->_MaskBitLength)) return true;
+        }
+    }
+    return false;
+}
+
+CAENRFIDErrorCodes CAENRFID_FilterCompile(CAENRFIDFilter* Filter,
+                                          CAENRFIDFilterRule* Rules,
+                                          uint32_t NumRules,
+                                          uint32_t* Slots,
+                                          uint32_t NumSlots)
+{
+    uint8_t value[FILTER_MAX_MASK_LENGTH];
+    CAENRFIDFilterGroup* group;
+    CAENRFIDFilterRule* r;
+    uint32_t i, slot, mask = NumSlots - 1;
+    uint8_t g;
+
+    if(((NumSlots & (NumSlots - 1)) != 0) || (NumSlots <= NumRules)) return CAENRFID_InvalidParam;
+    Filter->Rules = Rules;
+    Filter->NumRules = NumRules;
+    Filter->Slots = Slots;
+    Filter->NumSlots = NumSlots;
+    Filter->_num_groups = 0;
+    for(i = 0; i < NumSlots; i++) Slots[i] = FILTER_NO_RULE;
+    for(i = 0; i < NumRules; i++)
+    {
+        r = &Rules[i];
+        if(((r->Bank != EPC_CAEN) && (r->Bank != TID)) ||
+           ((uint32_t)r->MaskBitAddress + r->MaskBitLength > FILTER_MAX_MASK_LENGTH * 8) ||
+           ((r->Bank == EPC_CAEN) && (r->MaskBitLength > 0) && (r->MaskBitAddress < 16))) return CAENRFID_InvalidParam;
+        for(g = 0; g < Filter->_num_groups; g++)
+        {
+            group = &Filter->_groups[g];
+            if((group->_Bank == r->Bank) && (group->_MaskBitAddress == r->MaskBitAddress) &&
+               (group->_MaskBitLength == r->MaskBitLength)) break;
+        }
+        if(g == Filter->_num_groups)
+        {
+            if(g == CAENRFID_FILTER_MAX_GROUPS) return CAENRFID_OutOfMemoryError;
+            group = &Filter->_groups[g];
+            group->_Bank = r->Bank;
+            group->_MaskBitAddress = r->MaskBitAddress;
+            group->_MaskBitLength = r->MaskBitLength;
+            Filter->_num_groups++;
+        }
+        //unused bits of the last mask byte do not take part in the hash
+        matchExtract(r->Mask, 0, (r->MaskBitLength + 7) / 8, 0, r->MaskBitLength, value);
+        r->_group = g;
+        r->_hash = matchHash(value, (r->MaskBitLength + 7) / 8, g);
+        for(slot = r->_hash & mask; Slots[slot] != FILTER_NO_RULE; slot = (slot + 1) & mask);
+        Slots[slot] = i;
+    }
+    filterReaderMask(Filter);
+    return CAENRFID_StatusOK;
+}
+
+CAENRFIDErrorCodes CAENRFID_FilterMatch(const CAENRFIDFilter* Filter,
+                                        const CAENRFIDTag* Tag,
+                                        bool* Match)
+{
+    *Match = filterRules(Filter, Tag);
+    return CAENRFID_StatusOK;
+}
+
+CAENRFIDErrorCodes CAENRFID_FilterApply(const CAENRFIDFilter* Filter,
+                                        CAENRFIDTag* Tags,
+                                        uint32_t NumTags,
+                                        uint32_t* Size)
+{
+    uint32_t i;
+
+    *Size = 0;
+    for(i = 0; i < NumTags; i++)
+    {
+        if(!filterRules(Filter, &Tags[i])) continue;
+        if(i != *Size) Tags[*Size] = Tags[i];
+        (*Size)++;
+    }
+    return CAENRFID_StatusOK;
+}
+
+/*
+    Tag de-duplication
+*/
+static void dedupUnlink(CAENRFIDDedup* Dedup, CAENRFIDDedupEntry* e)
+{
+    if(e->_prev != DEDUP_NO_ENTRY) Dedup->Entries[e->_prev]._next = e->_next;
+    else Dedup->_oldest = e->_next;
+    if(e->_next != DEDUP_NO_ENTRY) Dedup->Entries[e->_next]._prev = e->_prev;
+    else Dedup->_newest = e->_prev;
+}
+
+static void dedupLinkNewest(CAENRFIDDedup* Dedup, uint32_t index)
+{
+    CAENRFIDDedupEntry* e = &Dedup->Entries[index];
+
+    e->_prev = Dedup->_newest;
+    e->_next = DEDUP_NO_ENTRY;
+    if(Dedup->_newest != DEDUP_NO_ENTRY) Dedup->Entries[Dedup->_newest]._next = index;
+    else Dedup->_oldest = index;
+    Dedup->_newest = index;
+}
+
+static void dedupEvent(const CAENRFIDDedupEntry* e, CAENRFIDDedupEventType Type,
+                       CAENRFIDDedupEvent* Event)
+{
+    Event->Type = Type;
+    memcpy(Event->ID, e->_ID, e->_Length);
+    Event->Length = e->_Length;
+    Event->ReadPoint = e->_ReadPoint;
+    Event->PrevReadPoint = e->_ReadPoint;
+    Event->FirstSeen = e->_first_seen;
+    Event->LastSeen = e->_last_seen;
+    Event->Reads = e->_reads;
+}
+
+CAENRFIDErrorCodes CAENRFID_DedupInit(CAENRFIDDedup* Dedup,
+                                      CAENRFIDDedupEntry* Entries,
+                                      uint32_t MaxEntries,
+                                      uint32_t* Slots,
+                                      uint32_t NumSlots,
+                                      uint16_t Flags,
+                                      uint32_t HoldOffMs,
+                                      uint32_t LostMs)
+{
+    uint32_t i;
+
+    //a free slot always exists, so that every probe ends
+    if((NumSlots & (NumSlots - 1)) != 0 || (NumSlots <= MaxEntries) ||
+       (MaxEntries >= DEDUP_NO_ENTRY)) return CAENRFID_InvalidParam;
+    Dedup->Entries = Entries;
+    Dedup->MaxEntries = MaxEntries;
+    Dedup->Slots = Slots;
+    Dedup->NumSlots = NumSlots;
+    Dedup->Flags = Flags;
+    Dedup->HoldOffMs = HoldOffMs;
+    Dedup->LostMs = LostMs;
+    Dedup->NumEntries = 0;
+    Dedup->Reads = 0;
+    Dedup->Suppressed = 0;
+    for(i = 0; i < NumSlots; i++) Slots[i] = DEDUP_NO_ENTRY;
+    //unused entries are chained through _next
+    for(i = 0; i < MaxEntries; i++) Entries[i]._next = (i + 1 < MaxEntries) ? i + 1 : DEDUP_NO_ENTRY;
+    Dedup->_free = (MaxEntries > 0) ? 0 : DEDUP_NO_ENTRY;
+    Dedup->_oldest = DEDUP_NO_ENTRY;
+    Dedup->_newest = DEDUP_NO_ENTRY;
+    return CAENRFID_StatusOK;
+}
+
+CAENRFIDErrorCodes CAENRFID_DedupAdd(CAENRFIDDedup* Dedup,
+                                     const CAENRFIDTag* Tag,
+                                     uint32_t Now,
+                                     CAENRFIDDedupEvent* Event,
+                                     bool* has_event)
+{
+    CAENRFIDDedupEntry* e;
+    char** names;
+    int16_t n;
+    uint32_t h, slot, index, mask = Dedup->NumSlots - 1;
+    uint8_t rp, key_rp;
+
+    *has_event = false;
+    if(Tag->Length > CAENRFID_DEDUP_ID_LENGTH) return CAENRFID_InvalidParam;
+    getAntNames(&names, &n);
+    rp = nameIndex(names, n, Tag->ReadPoint);
+    key_rp = (Dedup->Flags & DEDUP_BY_READPOINT) ? rp : 0;
+    h = matchHash(Tag->ID, Tag->Length, key_rp);
+    //linear probing, the stored hash avoids most ID comparisons
+    for(slot = h & mask; (index = Dedup->Slots[slot]) != DEDUP_NO_ENTRY; slot = (slot + 1) & mask)
+    {
+        e = &Dedup->Entries[index];
+        if((e->_hash == h) && (e->_Length == Tag->Length) &&
+           (!(Dedup->Flags & DEDUP_BY_READPOINT) || (e->_ReadPoint == rp)) &&
+           matchEqual(e->_ID, Tag->ID, Tag->Length))
+        {
+            Dedup->Reads++;
+            e->_last_seen = Now;
+            e->_reads++;
+            dedupUnlink(Dedup, e);
+            dedupLinkNewest(Dedup, index);
+            if((rp != e->_ReadPoint) && (rp != PACKED_TAG_NO_INDEX) &&
+               ((uint32_t)(Now - e->_reported) >= Dedup->HoldOffMs))
+            {
+                dedupEvent(e, CAENRFID_DEDUP_MOVED, Event);
+                Event->ReadPoint = rp;
+                e->_ReadPoint = rp;
+                e->_reported = Now;
+                *has_event = true;
+            }
+            else
+            {
+                Dedup->Suppressed++;
+            }
+            return CAENRFID_StatusOK;
+        }
+    }
+    if(Dedup->_free == DEDUP_NO_ENTRY) return CAENRFID_OutOfMemoryError;
+    Dedup->Reads++;
+    index = Dedup->_free;
+    e = &Dedup->Entries[index];
+    Dedup->_free = e->_next;
+    memcpy(e->_ID, Tag->ID, Tag->Length);
+    e->_Length = (uint8_t)Tag->Length;
+    e->_ReadPoint = rp;
+    e->_hash = h;
+    e->_first_seen = Now;
+    e->_last_seen = Now;
+    e->_reported = Now;
+    e->_reads = 1;
+    dedupLinkNewest(Dedup, index);
+    Dedup->Slots[slot] = index;
+    Dedup->NumEntries++;
+    dedupEvent(e, CAENRFID_DEDUP_NEW, Event);
+    *has_event = true;
+    return CAENRFID_StatusOK;
+}
+
+CAENRFIDErrorCodes CAENRFID_DedupExpire(CAENRFIDDedup* Dedup,
+                                        uint32_t Now,
+                                        CAENRFIDDedupEvent* Event,
+                                        bool* has_event)
+{
+    CAENRFIDDedupEntry* e;
+    uint32_t index, slot, next, home, mask = Dedup->NumSlots - 1;
+
+    *has_event = false;
+    //entries are kept ordered by last read, only the oldest may be lost
+    index = Dedup->_oldest;
+    if(index == DEDUP_NO_ENTRY) return CAENRFID_StatusOK;
+    e = &Dedup->Entries[index];
+    if((uint32_t)(Now - e->_last_seen) < Dedup->LostMs) return CAENRFID_StatusOK;
+    dedupEvent(e, CAENRFID_DEDUP_LOST, Event);
+    *has_event = true;
+
+    for(slot = e->_hash & mask; Dedup->Slots[slot] != index; slot = (slot + 1) & mask);
+    //backward shift deletion: the following entries of the probe sequence
+    //are moved up, so no tombstone is left behind
+    for(next = (slot + 1) & mask; Dedup->Slots[next] != DEDUP_NO_ENTRY; next = (next + 1) & mask)
+    {
+        home = Dedup->Entries[Dedup->Slots[next]]._hash & mask;
+        if(((next - home) & mask) >= ((next - slot) & mask))
+        {
+            Dedup->Slots[slot] = Dedup->Slots[next];
+            slot = next;
+        }
+    }
+    Dedup->Slots[slot] = DEDUP_NO_ENTRY;
+    dedupUnlink(Dedup, e);
+    e->_next = Dedup->_free;
+    Dedup->_free = index;
+    Dedup->NumEntries--;
+    return CAENRFID_StatusOK;
+}
+
+/*
+    Non-blocking mode
+*/
+enum {
+    ASYNC_IDLE = 0,
+    ASYNC_TX,
+    ASYNC_REPLY,
+    ASYNC_FRAMED,
+};
+
+static const uint8_t abortByte = UART_ABORT;
+
+static void asyncComplete(CAENRFIDAsync* async, CAENRFIDErrorCodes result,
+                          const uint8_t* frame, uint16_t len)
+{
+    //back to idle first, so that callbacks can start a new command
+    async->_state = ASYNC_IDLE;
+    if(async->_inventory)
+    {
+        if(async->inventory_end != NULL) async->inventory_end(async->ctx, result);
+    }
+    else
+    {
+        if(async->reply != NULL) async->reply(async->ctx, result, frame, len);
+    }
+}
+
+static void asyncReply(CAENRFIDAsync* async)
+{
+    CAENRFIDReader* reader = async->_reader;
+    IOBuffer_t rxbuf = {0};
+    CAENRFIDTag Tag;
+    uint16_t cmd, result_code;
+
+    rxbuf.memory = reader->_buffer;
+    rxbuf.size = async->_rx_len;
+    rxbuf.wpos = async->_rx_len;
+    if(!async->_inventory)
+    {
+        asyncComplete(async, CAENRFID_StatusOK, rxbuf.memory, rxbuf.size);
+        return;
+    }
+    rxbuf.rpos = HEADER_LEN;
+    if(getAVP(&rxbuf, AVP_COMMAND, &cmd) != 0)
+    {
+        asyncComplete(async, CAENRFID_LibraryError, NULL, 0);
+        return;
+    }
+    if(async->_params.has_framed)
+    {
+        //tags follow, parsed out of the reader receive buffer
+        async->_state = ASYNC_FRAMED;
+        reader->_rx_rpos = 0;
+        reader->_rx_wpos = 0;
+        return;
+    }
+    while(getTag(&rxbuf, &async->_params, &Tag) == 0)
+    {
+        if(async->tag != NULL) async->tag(async->ctx, &Tag);
+    }
+    if(getAVP(&rxbuf, AVP_RESULT_CODE, &result_code) != 0)
+    {
+        asyncComplete(async, CAENRFID_LibraryError, NULL, 0);
+        return;
+    }
+    asyncComplete(async, (CAENRFIDErrorCodes)result_code, NULL, 0);
+}
+
+static void asyncFramed(CAENRFIDAsync* async)
+{
+    CAENRFIDReader* reader = async->_reader;
+    IOBuffer_t rxbuf;
+    CAENRFIDTag Tag;
+    uint16_t result_code;
+
+    while(async->_state == ASYNC_FRAMED)
+    {
+        rxbuf.memory = &reader->_rx_buffer[reader->_rx_rpos];
+        rxbuf.size = reader->_rx_wpos - reader->_rx_rpos;
+        rxbuf.rpos = 0;
+        rxbuf.wpos = rxbuf.size;
+        if(getTag(&rxbuf, &async->_params, &Tag) == 0)
+        {
+            reader->_rx_rpos += rxbuf.rpos;
+            if(async->tag != NULL) async->tag(async->ctx, &Tag);
+        }
+        else if(getAVP(&rxbuf, AVP_RESULT_CODE, &result_code) == 0)
+        {
+            reader->_rx_rpos += rxbuf.rpos;
+            asyncComplete(async, (CAENRFIDErrorCodes)result_code, NULL, 0);
+        }
+        else if(rxbuf.size == sizeof(reader->_rx_buffer))
+        {
+            //a full buffer not holding a tag can't be parsed anymore
+            asyncComplete(async, CAENRFID_CommunicationError, NULL, 0);
+        }
+        else
+        {
+            break;
+        }
+    }
+}
+
+void CAENRFID_AsyncInit(CAENRFIDAsync* async, CAENRFIDReader* reader)
+{
+    memset(async, 0, sizeof(CAENRFIDAsync));
+    async->_reader = reader;
+    async->_state = ASYNC_IDLE;
+}
+
+static void asyncStart(CAENRFIDAsync* async, IOBuffer_t* txbuf, bool inventory)
+{
+    async->_cmdID = (uint16_t)((txbuf->memory[2] << 8) | txbuf->memory[3]);
+    async->_tx_pos = 0;
+    async->_tx_len = txbuf->size;
+    async->_rx_len = 0;
+    async->_rx_size = 0;
+    async->_inventory = inventory;
+    async->_state = ASYNC_TX;
+}
+
+CAENRFIDErrorCodes CAENRFID_AsyncInventoryTag(CAENRFIDAsync* async,
+                                              char* SourceName,
+                                              uint16_t Bank,
+                                              uint16_t MaskBitAddress,
+                                              uint16_t MaskBitLength,
+                                              uint8_t* Mask,
+                                              uint16_t MaskLen,
+                                              uint16_t flag)
+{
+    CAENRFIDErrorCodes ret;
+    IOBuffer_t txbuf = {0};
+
+    if(async->_state != ASYNC_IDLE) return CAENRFID_ReaderBusy;
+    ret = encodeInventory(async->_reader, &txbuf, &async->_params, SourceName, Bank,
+                          MaskBitAddress, MaskBitLength, Mask, MaskLen, flag);
+    if(ret != CAENRFID_StatusOK) return (ret);
+    asyncStart(async, &txbuf, true);
+    return CAENRFID_StatusOK;
+}
+
+CAENRFIDErrorCodes CAENRFID_AsyncSubmit(CAENRFIDAsync* async,
+                                        const uint8_t* Frame,
+                                        uint16_t Len)
+{
+    IOBuffer_t txbuf = {0};
+    int16_t tmp;
+
+    if(async->_state != ASYNC_IDLE) return CAENRFID_ReaderBusy;
+    if(Len < HEADER_LEN) return CAENRFID_InvalidParam;
+    txbuf.size = Len;
+    if((tmp = attachBuffer(async->_reader, &txbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+    memcpy(txbuf.memory, Frame, Len);
+    //the header is rewritten to carry the library CmdID
+    addHeader(async->_reader->_cmdID++, &txbuf, Len);
+    asyncStart(async, &txbuf, false);
+    return CAENRFID_StatusOK;
+}
+
+CAENRFIDErrorCodes CAENRFID_AsyncAbort(CAENRFIDAsync* async)
+{
+    if(async->_state != ASYNC_FRAMED) return CAENRFID_InvalidParam;
+    async->_abort = true;
+    return CAENRFID_StatusOK;
+}
+
+bool CAENRFID_AsyncWantRead(CAENRFIDAsync* async)
+{
+    return (async->_state == ASYNC_REPLY) || (async->_state == ASYNC_FRAMED);
+}
+
+bool CAENRFID_AsyncWantWrite(CAENRFIDAsync* async)
+{
+    return async->_abort || (async->_state == ASYNC_TX);
+}
+
+uint16_t CAENRFID_AsyncTxData(CAENRFIDAsync* async, const uint8_t** Data)
+{
+    if(async->_abort)
+    {
+        *Data = &abortByte;
+        return sizeof(abortByte);
+    }
+    if(async->_state != ASYNC_TX) return 0;
+    *Data = &async->_reader->_buffer[async->_tx_pos];
+    return async->_tx_len - async->_tx_pos;
+}
+
+void CAENRFID_AsyncTxDone(CAENRFIDAsync* async, uint16_t Len)
+{
+    if(Len == 0) return;
+    if(async->_abort)
+    {
+        async->_abort = false;
+        return;
+    }
+    if(async->_state != ASYNC_TX) return;
+    async->_tx_pos += Len;
+    if(async->_tx_pos >= async->_tx_len) async->_state = ASYNC_REPLY;
+}
+
+CAENRFIDErrorCodes CAENRFID_AsyncFeed(CAENRFIDAsync* async,
+                                      const uint8_t* Data,
+                                      uint32_t Len)
+{
+    CAENRFIDReader* reader = async->_reader;
+    uint16_t need, n, cmdID;
+    int16_t tmp;
+
+    while(Len > 0)
+    {
+        if(async->_state == ASYNC_REPLY)
+        {
+            //header first, then the length it announces
+            need = (async->_rx_len < HEADER_LEN) ? HEADER_LEN : async->_rx_size;
+            n = need - async->_rx_len;
+            if(n > Len) n = (uint16_t)Len;
+            memcpy(&reader->_buffer[async->_rx_len], Data, n);
+            async->_rx_len += n;
+            Data += n;
+            Len -= n;
+            if((async->_rx_len == HEADER_LEN) && (need == HEADER_LEN))
+            {
+                tmp = checkHeader(reader, reader->_buffer, &cmdID, &async->_rx_size);
+                if((tmp == 0) && (cmdID != async->_cmdID)) tmp = CAENRFID_CommunicationError;
+                if(tmp != 0)
+                {
+                    asyncComplete(async, (CAENRFIDErrorCodes)tmp, NULL, 0);
+                    return (CAENRFIDErrorCodes)tmp;
+                }
+            }
+            if(async->_rx_len == async->_rx_size) asyncReply(async);
+        }
+        else if(async->_state == ASYNC_FRAMED)
+        {
+            //make room at the end of the receive buffer
+            if(reader->_rx_wpos == sizeof(reader->_rx_buffer))
+            {
+                memmove(reader->_rx_buffer, &reader->_rx_buffer[reader->_rx_rpos],
+                        reader->_rx_wpos - reader->_rx_rpos);
+                reader->_rx_wpos -= reader->_rx_rpos;
+                reader->_rx_rpos = 0;
+            }
+            n = sizeof(reader->_rx_buffer) - reader->_rx_wpos;
+            if(n > Len) n = (uint16_t)Len;
+            memcpy(&reader->_rx_buffer[reader->_rx_wpos], Data, n);
+            reader->_rx_wpos += n;
+            Data += n;
+            Len -= n;
+            asyncFramed(async);
+        }
+        else
+        {
+            //no reply expected: discard
+            break;
+        }
+    }
+    return CAENRFID_StatusOK;
+}
+
+void CAENRFID_AsyncTimeout(CAENRFIDAsync* async)
+{
+    if(async->_state == ASYNC_IDLE) return;
+    async->_abort = false;
+    asyncComplete(async, CAENRFID_CommunicationTimeOut, NULL, 0);
+}
+
+/*
+    Pipelined commands
+*/
+enum {
+    SLOT_FREE = 0,
+    SLOT_INFLIGHT,
+    SLOT_DONE,
+};
+
+CAENRFIDErrorCodes CAENRFID_PipelineInit(CAENRFIDPipeline* pipe,
+                                         CAENRFIDReader* reader,
+                                         uint16_t Window)
+{
+    if((Window == 0) || (Window > CAENRFID_PIPELINE_DEPTH)) return CAENRFID_InvalidParam;
+    memset(pipe, 0, sizeof(CAENRFIDPipeline));
+    pipe->_reader = reader;
+    pipe->_window = Window;
+    return CAENRFID_StatusOK;
+}
+
+static CAENRFIDPipelineSlot* pipelineSlot(CAENRFIDPipeline* pipe)
+{
+    uint16_t i;
+
+    for(i = 0; i < pipe->_window; i++)
+    {
+        if(pipe->_slots[i].State == SLOT_FREE) return &pipe->_slots[i];
+    }
+    return NULL;
+}
+
+static CAENRFIDErrorCodes pipelineSend(CAENRFIDPipeline* pipe,
+                                       CAENRFIDPipelineSlot* slot,
+                                       IOBuffer_t* txbuf,
+                                       uint16_t* Handle)
+{
+    CAENRFIDReader* reader = pipe->_reader;
+    int16_t tmp;
+
+    //stale bytes can only be discarded while no reply is pending
+    if(pipe->_inflight == 0)
+    {
+        reader->clear_rx_data(reader->_port_handle);
+    }
+    if((tmp = sendFrame(reader, txbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+    slot->CmdID = (uint16_t)((txbuf->memory[2] << 8) | txbuf->memory[3]);
+    slot->State = SLOT_INFLIGHT;
+    pipe->_inflight++;
+    *Handle = (uint16_t)(slot - pipe->_slots);
+    return CAENRFID_StatusOK;
+}
+
+CAENRFIDErrorCodes CAENRFID_PipelineReadTagData(CAENRFIDPipeline* pipe,
+                                                CAENRFIDTag* Tag,
+                                                uint16_t Bank,
+                                                uint16_t ByteAddress,
+                                                uint16_t ByteLength,
+                                                uint8_t* Data,
+                                                uint32_t AccessPassword,
+                                                uint16_t* Handle)
+{
+    CAENRFIDErrorCodes ret;
+    CAENRFIDPipelineSlot* slot;
+    IOBuffer_t txbuf = {0};
+    CAENRFIDTagHandle TagHandle;
+
+    if((slot = pipelineSlot(pipe)) == NULL) return CAENRFID_ReaderBusy;
+    if((ret = CAENRFID_TagHandleInit(&TagHandle, Tag, AccessPassword)) != CAENRFID_StatusOK) return (ret);
+    ret = encodeTagData(pipe->_reader, &txbuf, CMD_G2READ, &TagHandle, Bank,
+                        ByteAddress, ByteLength, NULL);
+    if(ret != CAENRFID_StatusOK) return (ret);
+    slot->Command = CMD_G2READ;
+    slot->Data = Data;
+    return pipelineSend(pipe, slot, &txbuf, Handle);
+}
+
+CAENRFIDErrorCodes CAENRFID_PipelineWriteTagData(CAENRFIDPipeline* pipe,
+                                                 CAENRFIDTag* Tag,
+                                                 uint16_t Bank,
+                                                 uint16_t ByteAddress,
+                                                 uint16_t ByteLength,
+                                                 uint8_t* Data,
+                                                 uint32_t AccessPassword,
+                                                 uint16_t* Handle)
+{
+    CAENRFIDErrorCodes ret;
+    CAENRFIDPipelineSlot* slot;
+    IOBuffer_t txbuf = {0};
+    CAENRFIDTagHandle TagHandle;
+
+    if((slot = pipelineSlot(pipe)) == NULL) return CAENRFID_ReaderBusy;
+    if((ret = CAENRFID_TagHandleInit(&TagHandle, Tag, AccessPassword)) != CAENRFID_StatusOK) return (ret);
+    ret = encodeTagData(pipe->_reader, &txbuf, CMD_G2WRITE, &TagHandle, Bank,
+                        ByteAddress, ByteLength, Data);
+    if(ret != CAENRFID_StatusOK) return (ret);
+    slot->Command = CMD_G2WRITE;
+    slot->Data = NULL;
+    return pipelineSend(pipe, slot, &txbuf, Handle);
+}
+
+CAENRFIDErrorCodes CAENRFID_PipelineSubmit(CAENRFIDPipeline* pipe,
+                                           const uint8_t* Frame,
+                                           uint16_t Len,
+                                           uint8_t* Reply,
+                                           uint16_t ReplySize,
+                                           uint16_t* ReplyLen,
+                                           uint16_t* Handle)
+{
+    CAENRFIDPipelineSlot* slot;
+    IOBuffer_t txbuf = {0};
+    int16_t tmp;
+
+    if((slot = pipelineSlot(pipe)) == NULL) return CAENRFID_ReaderBusy;
+    if(Len < HEADER_LEN) return CAENRFID_InvalidParam;
+    txbuf.size = Len;
+    if((tmp = attachBuffer(pipe->_reader, &txbuf)) != 0) return (CAENRFIDErrorCodes) tmp;
+    memcpy(txbuf.memory, Frame, Len);
+    //the header is rewritten to carry the reader CmdID
+    addHeader(pipe->_reader->_cmdID++, &txbuf, Len);
+    slot->Command = 0;
+    slot->Data = Reply;
+    slot->Size = ReplySize;
+    slot->Len = ReplyLen;
+    return pipelineSend(pipe, slot, &txbuf, Handle);
+}
+
+static void pipelineFail(CAENRFIDPipeline* pipe, CAENRFIDErrorCodes Result)
+{
+    uint16_t i;
+
+    //replies can't be told apart anymore: every command in flight fails
+    for(i = 0; i < pipe->_window; i++)
+    {
+        if(pipe->_slots[i].State == SLOT_INFLIGHT)
+        {
+            pipe->_slots[i].State = SLOT_DONE;
+            pipe->_slots[i].Result = Result;
+        }
+    }
+    pipe->_inflight = 0;
+}
+
+static void pipelineReceive(CAENRFIDPipeline* pipe)
+{
+    CAENRFIDPipelineSlot* slot = NULL;
+    IOBuffer_t rxbuf = {0};
+    uint16_t CmdID, i;
+    int16_t tmp;
+
+    if((tmp = receiveFrame(pipe->_reader, &rxbuf, &CmdID)) != 0)
+    {
+        pipelineFail(pipe, (CAENRFIDErrorCodes) tmp);
+        return;
+    }
+    for(i = 0; i < pipe->_window; i++)
+    {
+        if((pipe->_slots[i].State == SLOT_INFLIGHT) && (pipe->_slots[i].CmdID == CmdID))
+        {
+            slot = &pipe->_slots[i];
+            break;
+        }
+    }
+    //a reply to no command in flight (e.g. a late one) is discarded
+    if(slot == NULL) return;
+    if(slot->Command != 0)
+    {
+        slot->Result = decodeTagData(&rxbuf, slot->Command, slot->Data);
+    }
+    else if(rxbuf.size > slot->Size)
+    {
+        slot->Result = CAENRFID_OutOfMemoryError;
+    }
+    else
+    {
+        memcpy(slot->Data, rxbuf.memory, rxbuf.size);
+        *slot->Len = rxbuf.size;
+        slot->Result = CAENRFID_StatusOK;
+    }
+    slot->State = SLOT_DONE;
+    pipe->_inflight--;
+}
+
+CAENRFIDErrorCodes CAENRFID_PipelineWait(CAENRFIDPipeline* pipe,
+                                         uint16_t* Handle,
+                                         CAENRFIDErrorCodes* Result)
+{
+    uint16_t i;
+
+    while(1)
+    {
+        for(i = 0; i < pipe->_window; i++)
+        {
+            if(pipe->_slots[i].State == SLOT_DONE)
+            {
+                pipe->_slots[i].State = SLOT_FREE;
+                *Handle = i;
+                *Result = pipe->_slots[i].Result;
+                return CAENRFID_StatusOK;
+            }
+        }
+        if(pipe->_inflight == 0) return CAENRFID_EOF;
+        pipelineReceive(pipe);
+    }
+}
+
+/*
+    Batch tag access
+*/
+static CAENRFIDErrorCodes tagDataBatch(CAENRFIDReader* reader,
+                                       uint16_t cmd,
+                                       CAENRFIDTag* Tags,
+                                       uint16_t NumTags,
+                                       uint16_t Bank,
+                                       uint16_t ByteAddress,
+                                       uint16_t ByteLength,
+                                       uint8_t* Data,
+                                       uint32_t AccessPassword,
+                                       CAENRFIDErrorCodes* Results)
+{
+    CAENRFIDErrorCodes ret = CAENRFID_StatusOK;
+    CAENRFIDPipeline pipe;
+    CAENRFIDPipelineSlot* slot;
+    CAENRFIDTag* tmpl = NULL;
+    CAENRFIDTagHandle TagHandle;
+    IOBuffer_t txbuf = {0};
+    uint16_t owner[CAENRFID_PIPELINE_DEPTH];
+    uint16_t buffer_size = reader->_buffer_size;
+    uint16_t reply_size, id_pos = 0, data_pos = 0;
+    uint16_t next = 0, Handle, i;
+    CAENRFIDErrorCodes result;
+
+    reply_size  = HEADER_LEN;
+    reply_size += sizeAVP(AVP_COMMAND, sizeof(cmd));
+    if(cmd == CMD_G2READ)
+    {
+        reply_size += sizeAVP(AVP_TAG_VALUE, ByteLength);
+    }
+    reply_size += sizeAVP(AVP_RESULT_CODE, sizeof(uint16_t));
+
+    CAENRFID_PipelineInit(&pipe, reader, CAENRFID_PIPELINE_DEPTH);
+    while(1)
+    {
+        while((next < NumTags) && (ret == CAENRFID_StatusOK) &&
+              ((slot = pipelineSlot(&pipe)) != NULL))
+        {
+            if((tmpl == NULL) || (Tags[next].Length != tmpl->Length) ||
+               (strcmp(Tags[next].LogicalSource, tmpl->LogicalSource) != 0))
+            {
+                //(re)build the frame template and keep it at the end of the
+                //reader buffer, out of reach of the replies received meanwhile
+                reader->_buffer_size = buffer_size;
+                ret = CAENRFID_TagHandleInit(&TagHandle, &Tags[next], AccessPassword);
+                if(ret != CAENRFID_StatusOK) break;
+                ret = encodeTagData(reader, &txbuf, cmd, &TagHandle, Bank,
+                                    ByteAddress, ByteLength,
+                                    &Data[(uint32_t)next * ByteLength]);
+                if((ret == CAENRFID_StatusOK) &&
+                   (txbuf.size + reply_size > buffer_size))
+                {
+                    ret = CAENRFID_OutOfMemoryError;
+                }
+                if(ret != CAENRFID_StatusOK) break;
+                memmove(&reader->_buffer[buffer_size - txbuf.size], txbuf.memory, txbuf.size);
+                txbuf.memory = &reader->_buffer[buffer_size - txbuf.size];
+                reader->_buffer_size = buffer_size - txbuf.size;
+                id_pos  = HEADER_LEN;
+                id_pos += sizeAVP(AVP_COMMAND, sizeof(cmd));
+                id_pos += sizeAVP(AVP_SOURCE_NAME, strlen(Tags[next].LogicalSource) + 1);
+                id_pos += sizeAVP(AVP_TAGIDLEN, sizeof(uint16_t));
+                id_pos += AVP_HEADLEN;
+                data_pos = txbuf.size - ByteLength;
+                if(AccessPassword != 0)
+                {
+                    data_pos -= sizeAVP(AVP_G2PWD, sizeof(AccessPassword));
+                }
+                tmpl = &Tags[next];
+            }
+            else
+            {
+                //only CmdID, tag ID and written data change between tags
+                txbuf.wpos = 0;
+                addHeader(reader->_cmdID++, &txbuf, txbuf.size);
+                memcpy(&txbuf.memory[id_pos], Tags[next].ID, Tags[next].Length);
+                if(cmd == CMD_G2WRITE)
+                {
+                    memcpy(&txbuf.memory[data_pos], &Data[(uint32_t)next * ByteLength], ByteLength);
+                }
+            }
+            slot->Command = cmd;
+            slot->Data = (cmd == CMD_G2READ) ? &Data[(uint32_t)next * ByteLength] : NULL;
+            if((ret = pipelineSend(&pipe, slot, &txbuf, &Handle)) != CAENRFID_StatusOK) break;
+            owner[Handle] = next++;
+        }
+        if(CAENRFID_PipelineWait(&pipe, &Handle, &result) != CAENRFID_StatusOK) break;
+        Results[owner[Handle]] = result;
+        if((result == CAENRFID_CommunicationError) && (ret == CAENRFID_StatusOK))
+        {
+            ret = CAENRFID_CommunicationError;
+        }
+    }
+    reader->_buffer_size = buffer_size;
+    //tags that could not be sent share the error that stopped the batch
+    for(i = next; i < NumTags; i++)
+    {
+        Results[i] = ret;
+    }
+    return (ret);
+}
+
+CAENRFIDErrorCodes CAENRFID_ReadTagDataBatch_EPC_C1G2(CAENRFIDReader* reader,
+                                                      CAENRFIDTag* Tags,
+                                                      uint16_t NumTags,
+                                                      uint16_t Bank,
+                                                      uint16_t ByteAddress,
+                                                      uint16_t ByteLength,
+                                                      uint8_t* Data,
+                                                      uint32_t AccessPassword,
+                                                      CAENRFIDErrorCodes* Results)
+{
+    return tagDataBatch(reader, CMD_G2READ, Tags, NumTags, Bank, ByteAddress,
+                        ByteLength, Data, AccessPassword, Results);
+}
+
+CAENRFIDErrorCodes CAENRFID_WriteTagDataBatch_EPC_C1G2(CAENRFIDReader* reader,
+                                                       CAENRFIDTag* Tags,
+                                                       uint16_t NumTags,
+                                                       uint16_t Bank,
+                                                       uint16_t ByteAddress,
+                                                       uint16_t ByteLength,
+                                                       uint8_t* Data,
+                                                       uint32_t AccessPassword,
+                                                       CAENRFIDErrorCodes* Results)
+{
+    return tagDataBatch(reader, CMD_G2WRITE, Tags, NumTags, Bank, ByteAddress,
+                        ByteLength, Data, AccessPassword, Results);
+}
\ No newline at end of file
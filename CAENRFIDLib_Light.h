@@ -1,803 +1,1981 @@
-/* --COPYRIGHT--,BSD
- * Copyright (c) 2022, CAEN RFID S.R.L.
- * All rights reserved.
- *
- * Redistribution and use in source and binary forms, with or without
- * modification, are permitted provided that the following conditions
- * are met:
- *
- * *  Redistributions of source code must retain the above copyright
- *    notice, this list of conditions and the following disclaimer.
- *
- * *  Redistributions in binary form must reproduce the above copyright
- *    notice, this list of conditions and the following disclaimer in the
- *    documentation and/or other materials provided with the distribution.
- *
- * *  Neither the name of CAEN RFID S.R.L. nor the names of
- *    its contributors may be used to endorse or promote products derived
- *    from this software without specific prior written permission.
- *
- * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
- * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
- * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
- * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
- * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
- * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
- * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
- * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
- * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
- * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
- * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
- * --/COPYRIGHT--*/
-
-#ifndef SRC_LIB_CAENRFIDLIB_LIGHT_H_
-#define SRC_LIB_CAENRFIDLIB_LIGHT_H_
-
-#include "CAENRFIDTypes_Light.h"
-
- /*
-    CAENRFID_Connect
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in],[out]  reader     : The reader data structure that identifies the device.
-        [in]        PortType   : The type of port used for connecting to the device.
-        [in]        PortParams : The port connection parameters.
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-        Description:
-        The function opens a connection to an attached device.
- */
-CAENRFIDErrorCodes CAENRFID_Connect(CAENRFIDReader* reader,
-                                    CAENRFIDPort PortType,
-                                    void* PortParams);
-
-/*
-    CAENRFID_Disconnect
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]   reader      : The reader data structure that identifies the device.
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        The function closes an open connection with an attached device.
-*/
-CAENRFIDErrorCodes CAENRFID_Disconnect(CAENRFIDReader* reader);
-
-/*
-    CAENRFID_GetReadPoints.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader         : The reader data structure that identifies the device.
-        [out] Antennas       : The names of the Antenna avalaible on the reader.
-        [out] numAnt         : The number of string in Antennas.
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        The function permits to know the name of the antennas available on the reader.
-        Names are formatted according to CAEN RFID communication protocol.
-*/
-CAENRFIDErrorCodes CAENRFID_GetReadPoints(CAENRFIDReader* reader,
-                                          char** Antennas[],
-                                          int16_t* numAnt);
-
-/*
-    CAENRFID_GetSourceNames.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  Handle         : The reader data structure that identifies the device.
-        [out] Sources        : The names of the logical source avalaible on the reader.
-        [out] numSrc         : The number of string in logical sources.
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        The function permits to know the name of the logical sources available on the reader.
-        Names are formatted according to CAEN RFID communication protocol.
-*/
-CAENRFIDErrorCodes CAENRFID_GetSourceNames(CAENRFIDReader* reader,
-                                           char** Sources[],
-                                           int16_t* numSrc);
-
-/*
-    CAENRFID_GetFirmwareRelease.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader         : The reader data structure that identifies the device.
-        [out] FWRel          : Returns the firmware release of the device.
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        Permits to read the firmware release loaded into the device.
-*/
-CAENRFIDErrorCodes CAENRFID_GetFirmwareRelease(CAENRFIDReader* reader,
-                                               char* FWRel);
-
-/*
-    CAENRFID_GetReaderInfo
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader         : The reader data structure that identifies the device.
-        [out] Model          :  Returns the model of the reader.
-        [out] SerialNum      : Returns the Serial number of the reader.
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        Permits to read the Model and the Serial number of the Reader.
-*/
-CAENRFIDErrorCodes CAENRFID_GetReaderInfo(CAENRFIDReader* reader,
-                                          char* Model,
-                                          char* SerialNum);
-
-/*
-    CAENRFID_SetProtocol.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader         : The reader data structure that identifies the device.
-        [in]  Proto          : The tag protocol to be set in the reader.
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        The function permits to change the tag protocol used by the reader.
-*/
-CAENRFIDErrorCodes CAENRFID_SetProtocol(CAENRFIDReader* reader,
-                                        CAENRFIDProtocol Proto);
-
-/*
-    CAENRFID_GetProtocol.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader         : The reader data structure that identifies the device.
-        [out] Proto          : The tag protocol to be set in the reader.
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        The function permits to know what tag protocol is used by the reader.
-*/
-CAENRFIDErrorCodes CAENRFID_GetProtocol(CAENRFIDReader* reader,
-                                        CAENRFIDProtocol* Proto);
-
-/*
-    CAENRFID_SetPower.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader         : The reader data structure that identifies the device.
-        [in]  Power          : RF field power expressed in mW.
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        The function permits to set the RF field power of the reader.
-*/
-CAENRFIDErrorCodes CAENRFID_SetPower(CAENRFIDReader* reader,
-                                     uint32_t Power);
-
-/*
-    CAENRFID_GetPower.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader         : The reader data structure that identifies the device.
-        [out] Power          : The RF field power of the reader expressed in mW.
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        The function returns the reader RF field power value.
-*/
-CAENRFIDErrorCodes CAENRFID_GetPower(CAENRFIDReader* reader,
-                                     uint32_t* Power);
-
-/*
-    CAENRFID_AddReadPoint.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader         : The reader data structure that identifies the device.
-        [in]  SourceName     : The name of the Logical Source.
-        [in]  ReadPoint      : The name of the Read Point.
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        The function permits to add a read point (antenna) to a logical source.
-*/
-CAENRFIDErrorCodes CAENRFID_AddReadPoint(CAENRFIDReader* reader,
-                                         char* SourceName,
-                                         char* ReadPoint);
-
-/*
-    CAENRFID_RemoveReadPoint.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader         : The reader data structure that identifies the device.
-        [in]  SourceName     : The name of the Logical Source.
-        [in]  ReadPoint      : The name of the Read Point.
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        The function permits to remove a read point (antenna) to a logical source.
-*/
-CAENRFIDErrorCodes CAENRFID_RemoveReadPoint(CAENRFIDReader* reader,
-                                            char* SourceName,
-                                            char* ReadPoint);
-
-/*
-    CAENRFID_isReadPointPresent.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader         : The reader data structure that identifies the device.
-        [in]  SourceName     : The name of the Logical Source.
-        [in]  ReadPoint      : The name of the Read Point.
-        [out] isPresent      : A flag indicating if the read point is associated
-                               to the specified source.
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        The function permits to check if a read point is associated to a
-        specified logical source. That is, whether the read point is used within
-        a read cycle performed in the source.
-*/
-CAENRFIDErrorCodes CAENRFID_isReadPointPresent(CAENRFIDReader* reader,
-                                               char* ReadPoint,
-                                               char* SourceName,
-                                               uint16_t* isPresent);
-
-/*
-    CAENRFID_GetReadPointStatus.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader         : The reader data structure that identifies the device.
-        [in]  ReadPoint      : The name of the Read Point.
-        [out] Status         : The status of the read point.
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        The function permits to check the status of a read point.
-*/
-CAENRFIDErrorCodes CAENRFID_GetReadPointStatus(CAENRFIDReader* reader,
-                                               char* ReadPoint,
-                                               CAENRFIDReadPointStatus* Status);
-
-/*
-    CAENRFID_MatchReadPointImpedance.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader         : The reader data structure that identifies the device.
-        [in]  ReadPoint      : The name of the ReadPoint to apply impedance automatching.
-        [out] value          : The result of the automatching result operation.
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        The function matches the antenna impedance passed in ReadPoint parameter.
-*/
-CAENRFIDErrorCodes CAENRFID_MatchReadPointImpedance(CAENRFIDReader* reader,
-                                                    char* ReadPoint,
-                                                    float* value);
-
-/*
-    CAENRFID_SetSourceConfiguration.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader         : The reader data structure that identifies the device.
-        [in]  SourceName     : The Name of the Logical Source.
-        [in]  Parameter      : The parameter of Logical Source to configure.
-        [in]  Value          : The the value of the parameter.
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        The function permits to configure the Logical Source.
-*/
-CAENRFIDErrorCodes CAENRFID_SetSourceConfiguration(CAENRFIDReader* reader, 
-                                                   char* SourceName,
-                                                   CAENRFID_SOURCE_Parameter Parameter,
-                                                   uint32_t Value);
-
-/*
-    CAENRFID_GetSourceConfiguration.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader         : The reader data structure that identifies the device.
-        [in]  SourceName     : The Name of the Logical Source.
-        [in]  Parameter      : The parameter of Logical Source to configure.
-        [out] Value          : The the value of the parameter.
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        The function permits to get the value of the Logical Source configuration.
-*/
-CAENRFIDErrorCodes CAENRFID_GetSourceConfiguration(CAENRFIDReader* reader,
-                                                   char* SourceName,
-                                                   CAENRFID_SOURCE_Parameter Parameter,
-                                                   uint32_t* Value);
-
-/*
-    CAENRFID_SetRS232.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader         : The reader data structure that identifies the device.
-        [in]  Baudrate       : The baudrate value.
-        [in]  DataBits       : The databit value.
-        [in]  StopBits       : The stopbit value.
-        [in]  Parity         : The parity value.
-        [in]  FlowControl    : The flowcontrol value.
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        The function permits to configure the serial communication of the reader.
-*/
-CAENRFIDErrorCodes CAENRFID_SetRS232(CAENRFIDReader* reader,
-                                     uint32_t Baudrate,
-                                     uint32_t DataBits,
-                                     uint32_t StopBits,
-                                     CAENRFID_RS232_Parity Parity,
-                                     CAENRFID_RS232_FlowControl FlowControl);
-
-/*
-    CAENRFID_SetBitRate.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader         : The reader data structure that identifies the device.
-        [in]  Bitrate        : link-profile setting.
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        The function permits to choose the modulation (the bitrate of the
-        transmission and reception).
-*/
-CAENRFIDErrorCodes CAENRFID_SetBitrate(CAENRFIDReader* reader,
-                                       CAENRFID_Bitrate Bitrate);
-
-/*
-    CAENRFID_GetBitRate.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader         : The reader data structure that identifies the device.
-        [out] Bitrate        : Modulation setting.
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        The function permits to retrieve the modulation (the bitrate of the
-        transmission and reception).
-*/
-CAENRFIDErrorCodes CAENRFID_GetBitrate(CAENRFIDReader* reader,
-                                       CAENRFID_Bitrate* Bitrate);
-
-/*
-    CAENRFID_SetFHSSMode.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader         : The reader data structure that identifies the device.
-        [in]  FHSSMode       : A zero value to disable FHSS, non-zero value
-                               to enable FHSS.
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        The function permits to enable/disable the frequency hopping mode of
-        the reader.
-*/
-CAENRFIDErrorCodes CAENRFID_SetFHSSMode(CAENRFIDReader* reader,
-                                        uint16_t FHSSMode);
-
-/*
-    CAENRFID_GetFHSSMode.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader         : The reader data structure that identifies the device.
-        [out] FHSSMode       : A zero value if the FHSS is disabled, non-zero value
-                               if it is enabled.
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        The function indicates the activation of the frequency hopping mode of
-        the reader.
-*/
-CAENRFIDErrorCodes CAENRFID_GetFHSSMode(CAENRFIDReader* reader,
-                                        uint16_t* FHSSMode);
-
-/*
-    CAENRFID_SetRFChannel.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader         : The reader data structure that identifies the device.
-        [in]  RFChannel      : The RF Channel
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        The function permits to set the RF Channel.
-*/
-CAENRFIDErrorCodes CAENRFID_SetRFChannel(CAENRFIDReader* reader, 
-                                         uint16_t RFChannel);
-
-/*
-    CAENRFID_GetRFChannel.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader         : The reader data structure that identifies the device.
-        [out] RFChannel      : The RF Channel
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        The function permits to retrieve the RF Channel.
-*/
-CAENRFIDErrorCodes CAENRFID_GetRFChannel(CAENRFIDReader* reader, 
-                                         uint16_t* RFChannel);
-
-/*
-    CAENRFID_SetRFRegulation.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader         : The reader data structure that identifies the device.
-        [in]  RFRegulation   : The RF Regulation
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        The function permits to set the RF Regulation.
-*/
-CAENRFIDErrorCodes CAENRFID_SetRFRegulation(CAENRFIDReader* reader, 
-                                            CAENRFIDRFRegulations RFRegulation);
-
-/*
-    CAENRFID_GetRFRegulation.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader         : The reader data structure that identifies the device.
-        [out] RFRegulation   : The RF Regulation
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        The function permits to retrieve the RF Regulation.
-*/
-CAENRFIDErrorCodes CAENRFID_GetRFRegulation(CAENRFIDReader* reader, 
-                                            CAENRFIDRFRegulations* RFRegulation);
-
-/*
-    CAENRFID_SetIO.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader         : The reader data structure that identifies the device.
-        [in]  IORegister     : The IO Register value.
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        The function permits to write the IO register.
-*/
-CAENRFIDErrorCodes CAENRFID_SetIO(CAENRFIDReader* reader,
-                                  uint32_t IORegister);
-
-/*
-    CAENRFID_GetIO.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader         : The reader data structure that identifies the device.
-        [out] IORegister     : The current IO Register.
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        The function permits to read the IO register.
-*/
-CAENRFIDErrorCodes CAENRFID_GetIO(CAENRFIDReader* reader,
-                                  uint32_t* IORegister);
-
-/*
-    CAENRFID_SetIODirection.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader         : The reader data structure that identifies the device.
-        [in]  IODirection    : The IO Direction value.
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        The function permits to set the IO Direction for the IORegister.
-*/
-CAENRFIDErrorCodes CAENRFID_SetIODirection(CAENRFIDReader* reader,
-                                           uint32_t IODirection);
-
-/*
-    CAENRFID_GetIODirection.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader         : The reader data structure that identifies the device.
-        [out] IODirection    : The current IO Direction.
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        The function permits to read the IO direction of IORegister.
-*/
-CAENRFIDErrorCodes CAENRFID_GetIODirection(CAENRFIDReader* reader,
-                                           uint32_t* IODirection);
-
-/*
-    CAENRFID_ReadTagData_EPC_C1G2.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader         : The reader data structure that identifies the device.
-        [in]  Tag            : The tag to be read.
-        [in]  Bank           : The memory Bank of EPC C1G2 Tag
-        [in]  ByteAddress    : The byte address of the memory to read.
-        [in]  ByteLength     : The number of bytes to read.
-        [out] Data           : The data read from the tag's memory.
-        [in]  AccessPassword : The tag Access password. If 0, no password is used.
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        This function allows to read ByteLength bytes from the bank memory,
-        specified by Bank, of a specific tag identified by the
-        Tag at the address specified by ByteAddress.
-*/
-CAENRFIDErrorCodes CAENRFID_ReadTagData_EPC_C1G2(CAENRFIDReader* reader,
-                                                 CAENRFIDTag* Tag, 
-                                                 uint16_t Bank,
-                                                 uint16_t ByteAddress,
-                                                 uint16_t ByteLength,
-                                                 uint8_t* Data,
-                                                 uint32_t AccessPassword);
-
-/*
-    CAENRFID_WriteTagData_EPC_C1G2.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader         : The reader data structure that identifies the device.
-        [in]  Tag            : The tag to be written.
-        [in]  Bank           : The memory Bank of EPC C1G2 Tag
-        [in]  ByteAddress    : The byte address of the memory to write.
-        [in]  ByteLength     : The number of bytes to write.
-        [in]  Data           : The data to write in the tag's memory.
-        [in]  AccessPassword : The tag Access password. If 0, no password is used.
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        This function allows to write ByteLength bytes to the bank memory,
-        specified by Bank, of a specific tag identified by the
-        Tag at the address specified by ByteAddress.
-*/
-CAENRFIDErrorCodes CAENRFID_WriteTagData_EPC_C1G2(CAENRFIDReader* reader,
-                                                  CAENRFIDTag* Tag,
-                                                  uint16_t Bank,
-                                                  uint16_t ByteAddress,
-                                                  uint16_t ByteLength,
-                                                  uint8_t* Data,
-                                                  uint32_t AccessPassword);
-
-/*
-    CAENRFID_LockTag_EPC_C1G2.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader         : The reader data structure that identifies the device.
-        [in]  Tag            : The tag.
-        [in]  Payload        : The payload of the tag's memory.
-        [in]  AccessPassword : The tag Access Password. If 0, no password is used.
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        This function allows to secure lock the memory of a
-        specific tag identified by the Tag.
-*/
-CAENRFIDErrorCodes CAENRFID_LockTag_EPC_C1G2(CAENRFIDReader* reader,
-                                             CAENRFIDTag *Tag,
-                                             uint32_t Payload,
-                                             uint32_t AccessPassword);
-
-/*
-    CAENRFID_KillTag_EPC_C1G2.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader         : The reader data structure that identifies the device.
-        [in]  Tag            : The tag to kill.
-        [in]  Password       : The tag Kill Password.
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        The function permits to kill an EPC Class 1 Gen 2 tag.
-*/
-CAENRFIDErrorCodes CAENRFID_KillTag_EPC_C1G2(CAENRFIDReader* reader,
-                                             CAENRFIDTag *Tag,
-                                             uint32_t Password);
-
-/*
-    CAENRFID_ProgramID_EPC_C1G2.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader         : The reader data structure that identifies the device.
-        [in]  Tag            : Contains the tag EPC C1G2 ID to be programmed.
-        [in]  nsi            : The NSI value for the EPC C1G2.
-        [in]  AccessPassword : The tag Access Password. If 0, no password is used.
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        The function permits to program the EPC Code of an EPC Class 1 Gen 2 tag.
-*/
-CAENRFIDErrorCodes CAENRFID_ProgramID_EPC_C1G2(CAENRFIDReader* reader,
-                                               CAENRFIDTag *Tag,
-                                               uint16_t nsi,
-                                               uint32_t AccessPassword);
-
-/*
-    CAENRFID_CustomCommand_EPC_C1G2.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader         : The reader data structure that identifies the device.
-        [in]  Tag            : The tag.
-        [in]  SubCmd         : The subcommand.
-        [in]  TxLen          : The number of bytes to send to the tag.
-        [in]  Data           : The data to be sent to the tag.
-        [in]  RxLen          : The number of bytes to be received from the tag.
-        [in]  AccessPassword : The tag Access Password. If 0, no password is used.
-        [out] TRData         : The data received from the tag.
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        Special function to implement custom commands.
-*/
-CAENRFIDErrorCodes CAENRFID_CustomCommand_EPC_C1G2(CAENRFIDReader* reader,
-                                                   CAENRFIDTag *Tag,
-                                                   uint8_t SubCmd,
-                                                   uint16_t TxLen,
-                                                   uint8_t *Data,
-                                                   uint16_t RxLen,
-                                                   uint32_t AccessPassword,
-                                                   uint8_t *TRData);
-
-/*
-    CAENRFID_InventoryTag.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader         : The reader data structure that identifies the device.
-        [in]  SourceName     : The name that identifies the Logical Source.
-        [in]  Bank           : The bank where apply the mask.
-        [in]  MaskBitAddress : The position in bit from where starting to compare the mask 
-                               to the choosen bank.
-        [in]  MaskBitLength  : The length in bit of the significative part of the Mask.
-        [in]  Mask           : The array containing the Mask.
-        [in]  MaskLen        : The number of bytes passed in Mask.
-        [in]  flag           : A bitmask that indicates the mode of inventory and the 
-                               retrieving of RSSI, TID, XPC and PC values.
-        [out] TagList        : A List containing the tags read (only for
-                               an inventory of type NOT framed and NOT continuous).
-        [out] Size           : Returns the number of tags in the list (only for
-                               an inventory of type NOT framed and NOT continuous).
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        This function is used to perform a simple inventory round or to start a cycle
-        of continuous plus framed inventory rounds. The inventory is performed on 
-        all antennas belonging to the logical source SourceName and will apply 
-        the mask parameters to the founded tags, returning only those tags whose 
-        relative bank matches the mask.
-
-        If the continuous and framed mode of inventory is NOT selected in the flag
-        parameter, the TagList list contains the IDs of the detected tags, together
-        with other information  related to the single ID such as the antenna on which
-        the ID was detected and the format of the ID itself (see CAENRFIDTag struct 
-        for the details).
-
-        If the continuos and framed mode of inventory is selected in flag, the
-        reader performs a number of inventory rounds dependant on the value 
-        of the CONFIG_READCYCLE parameter of the logical source SourceName (see 
-        function CAENRFID_SetSourceConfiguration). 
-        In this case TagList and Size parameters are ignored, user should call the 
-        CAENRFID_GetFramedTag function to retrieve tags detected during an inventory
-        of such type, as well as to detect its ending.
-*/
-CAENRFIDErrorCodes CAENRFID_InventoryTag(CAENRFIDReader* reader,
-                                         char* SourceName,
-                                         uint16_t Bank,
-                                         uint16_t MaskBitAddress,
-                                         uint16_t MaskBitLength,
-                                         uint8_t* Mask,
-                                         uint16_t MaskLen,
-                                         uint16_t flag,
-                                         CAENRFIDTagList** TagList,
-                                         uint16_t* Size);
-
-/*
-    CAENRFID_GetFramedTag.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader          : The reader data structure that identifies the device.
-        [out] has_tag         : Contains information about whether a tag was detected
-                                and received from the reader or not.
-        [out] Tag             : The detected tag, if present.
-        [out] has_result_code : Contains information about whether the inventory 
-                                rounds ended and a result code was returned by the 
-                                reader or not.
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        This function is used to receive a tag Tag detected by the reader during
-        a framed plus continuous inventory. The function also detects the ending
-        of such an inventory. 
-        The framed plus continuous inventory must be started using the 
-        CAENRFID_InventoryTag function.
-*/
-CAENRFIDErrorCodes CAENRFID_GetFramedTag(CAENRFIDReader* reader,
-                                         bool* has_tag,
-                                         CAENRFIDTag* Tag, 
-                                         bool* has_result_code);
-
-/*
-    CAENRFID_InventoryAbort.
-    -----------------------------------------------------------------------------
-    Parameters:
-        [in]  reader         : The reader data structure that identifies the device.
-    -----------------------------------------------------------------------------
-    Returns:
-        An error code about the execution of the function.
-    -----------------------------------------------------------------------------
-    Description:
-        This function tries to stop an ongoing framed plus continuous inventory.
-        To detect the ending of such inventory the user should use the 
-        CAENRFID_GetFramedTag function.
-*/
-CAENRFIDErrorCodes CAENRFID_InventoryAbort(CAENRFIDReader* reader);
-
-#endif /* SRC_LIB_CAENRFIDLIB_LIGHT_H_ */
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2022, CAEN RFID S.R.L.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of CAEN RFID S.R.L. nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+
+#ifndef SRC_LIB_CAENRFIDLIB_LIGHT_H_
+#define SRC_LIB_CAENRFIDLIB_LIGHT_H_
+
+#include "CAENRFIDTypes_Light.h"
+
+/*
+    Threading
+    -----------------------------------------------------------------------------
+    The library keeps no global mutable state: all the state of a reader is
+    held by its CAENRFIDReader (and CAENRFIDAsync) struct. Hence:
+    - different readers can be used concurrently from different threads,
+      without any locking;
+    - a reader must be used by one thread at a time. If it is shared, calls
+      must be serialized by the user. The only exception is
+      CAENRFID_InventoryAbort, which can be called while another thread waits
+      in CAENRFID_GetFramedTag, provided the reader tx callback may be called
+      while rx is running;
+    - the user provided callbacks of a reader are called only from the thread
+      calling the library on that reader.
+*/
+
+ /*
+    CAENRFID_Connect
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in],[out]  reader     : The reader data structure that identifies the device.
+        [in]        PortType   : The type of port used for connecting to the device.
+        [in]        PortParams : The port connection parameters.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+        Description:
+        The function opens a connection to an attached device, calling the
+        reader connect callback with PortType and PortParams (e.g. a
+        CAENRFIDSerialParams when the reader is bound to a tty by
+        CAENRFID_SerialAttach, a CAENRFIDTCPParams when it is bound to a
+        TCP connection by CAENRFID_TCPAttach). If the connect callback is
+        NULL no port is opened, as in previous releases.
+        It also sets up the reader scratch buffer (CAENRFID_MAX_FRAME_LENGTH
+        bytes) used by every following command, so it must be called before
+        any other function of the library.
+ */
+CAENRFIDErrorCodes CAENRFID_Connect(CAENRFIDReader* reader,
+                                    CAENRFIDPort PortType,
+                                    void* PortParams);
+
+/*
+    CAENRFID_Disconnect
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]   reader      : The reader data structure that identifies the device.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        The function closes an open connection with an attached device and
+        releases the reader scratch buffer.
+*/
+CAENRFIDErrorCodes CAENRFID_Disconnect(CAENRFIDReader* reader);
+
+/*
+    CAENRFID_GetReadPoints.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [out] Antennas       : The names of the Antenna avalaible on the reader.
+        [out] numAnt         : The number of string in Antennas.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        The function permits to know the name of the antennas available on the reader.
+        Names are formatted according to CAEN RFID communication protocol.
+*/
+CAENRFIDErrorCodes CAENRFID_GetReadPoints(CAENRFIDReader* reader,
+                                          char** Antennas[],
+                                          int16_t* numAnt);
+
+/*
+    CAENRFID_GetSourceNames.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  Handle         : The reader data structure that identifies the device.
+        [out] Sources        : The names of the logical source avalaible on the reader.
+        [out] numSrc         : The number of string in logical sources.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        The function permits to know the name of the logical sources available on the reader.
+        Names are formatted according to CAEN RFID communication protocol.
+*/
+CAENRFIDErrorCodes CAENRFID_GetSourceNames(CAENRFIDReader* reader,
+                                           char** Sources[],
+                                           int16_t* numSrc);
+
+/*
+    CAENRFID_GetFirmwareRelease.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [out] FWRel          : Returns the firmware release of the device.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        Permits to read the firmware release loaded into the device.
+*/
+CAENRFIDErrorCodes CAENRFID_GetFirmwareRelease(CAENRFIDReader* reader,
+                                               char* FWRel);
+
+/*
+    CAENRFID_GetReaderInfo
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [out] Model          :  Returns the model of the reader.
+        [out] SerialNum      : Returns the Serial number of the reader.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        Permits to read the Model and the Serial number of the Reader.
+*/
+CAENRFIDErrorCodes CAENRFID_GetReaderInfo(CAENRFIDReader* reader,
+                                          char* Model,
+                                          char* SerialNum);
+
+/*
+    CAENRFID_SetProtocol.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  Proto          : The tag protocol to be set in the reader.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        The function permits to change the tag protocol used by the reader.
+*/
+CAENRFIDErrorCodes CAENRFID_SetProtocol(CAENRFIDReader* reader,
+                                        CAENRFIDProtocol Proto);
+
+/*
+    CAENRFID_GetProtocol.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [out] Proto          : The tag protocol to be set in the reader.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        The function permits to know what tag protocol is used by the reader.
+*/
+CAENRFIDErrorCodes CAENRFID_GetProtocol(CAENRFIDReader* reader,
+                                        CAENRFIDProtocol* Proto);
+
+/*
+    CAENRFID_SetPower.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  Power          : RF field power expressed in mW.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        The function permits to set the RF field power of the reader.
+*/
+CAENRFIDErrorCodes CAENRFID_SetPower(CAENRFIDReader* reader,
+                                     uint32_t Power);
+
+/*
+    CAENRFID_GetPower.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [out] Power          : The RF field power of the reader expressed in mW.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        The function returns the reader RF field power value.
+*/
+CAENRFIDErrorCodes CAENRFID_GetPower(CAENRFIDReader* reader,
+                                     uint32_t* Power);
+
+/*
+    CAENRFID_AddReadPoint.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  SourceName     : The name of the Logical Source.
+        [in]  ReadPoint      : The name of the Read Point.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        The function permits to add a read point (antenna) to a logical source.
+*/
+CAENRFIDErrorCodes CAENRFID_AddReadPoint(CAENRFIDReader* reader,
+                                         char* SourceName,
+                                         char* ReadPoint);
+
+/*
+    CAENRFID_RemoveReadPoint.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  SourceName     : The name of the Logical Source.
+        [in]  ReadPoint      : The name of the Read Point.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        The function permits to remove a read point (antenna) to a logical source.
+*/
+CAENRFIDErrorCodes CAENRFID_RemoveReadPoint(CAENRFIDReader* reader,
+                                            char* SourceName,
+                                            char* ReadPoint);
+
+/*
+    CAENRFID_isReadPointPresent.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  SourceName     : The name of the Logical Source.
+        [in]  ReadPoint      : The name of the Read Point.
+        [out] isPresent      : A flag indicating if the read point is associated
+                               to the specified source.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        The function permits to check if a read point is associated to a
+        specified logical source. That is, whether the read point is used within
+        a read cycle performed in the source.
+*/
+CAENRFIDErrorCodes CAENRFID_isReadPointPresent(CAENRFIDReader* reader,
+                                               char* ReadPoint,
+                                               char* SourceName,
+                                               uint16_t* isPresent);
+
+/*
+    CAENRFID_GetReadPointStatus.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  ReadPoint      : The name of the Read Point.
+        [out] Status         : The status of the read point.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        The function permits to check the status of a read point.
+*/
+CAENRFIDErrorCodes CAENRFID_GetReadPointStatus(CAENRFIDReader* reader,
+                                               char* ReadPoint,
+                                               CAENRFIDReadPointStatus* Status);
+
+/*
+    CAENRFID_MatchReadPointImpedance.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  ReadPoint      : The name of the ReadPoint to apply impedance automatching.
+        [out] value          : The result of the automatching result operation.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        The function matches the antenna impedance passed in ReadPoint parameter.
+*/
+CAENRFIDErrorCodes CAENRFID_MatchReadPointImpedance(CAENRFIDReader* reader,
+                                                    char* ReadPoint,
+                                                    float* value);
+
+/*
+    CAENRFID_SetSourceConfiguration.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  SourceName     : The Name of the Logical Source.
+        [in]  Parameter      : The parameter of Logical Source to configure.
+        [in]  Value          : The the value of the parameter.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        The function permits to configure the Logical Source.
+*/
+CAENRFIDErrorCodes CAENRFID_SetSourceConfiguration(CAENRFIDReader* reader, 
+                                                   char* SourceName,
+                                                   CAENRFID_SOURCE_Parameter Parameter,
+                                                   uint32_t Value);
+
+/*
+    CAENRFID_GetSourceConfiguration.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  SourceName     : The Name of the Logical Source.
+        [in]  Parameter      : The parameter of Logical Source to configure.
+        [out] Value          : The the value of the parameter.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        The function permits to get the value of the Logical Source configuration.
+*/
+CAENRFIDErrorCodes CAENRFID_GetSourceConfiguration(CAENRFIDReader* reader,
+                                                   char* SourceName,
+                                                   CAENRFID_SOURCE_Parameter Parameter,
+                                                   uint32_t* Value);
+
+/*
+    CAENRFID_SetRS232.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  Baudrate       : The baudrate value.
+        [in]  DataBits       : The databit value.
+        [in]  StopBits       : The stopbit value.
+        [in]  Parity         : The parity value.
+        [in]  FlowControl    : The flowcontrol value.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        The function permits to configure the serial communication of the reader.
+*/
+CAENRFIDErrorCodes CAENRFID_SetRS232(CAENRFIDReader* reader,
+                                     uint32_t Baudrate,
+                                     uint32_t DataBits,
+                                     uint32_t StopBits,
+                                     CAENRFID_RS232_Parity Parity,
+                                     CAENRFID_RS232_FlowControl FlowControl);
+
+/*
+    CAENRFID_SetBitRate.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  Bitrate        : link-profile setting.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        The function permits to choose the modulation (the bitrate of the
+        transmission and reception).
+*/
+CAENRFIDErrorCodes CAENRFID_SetBitrate(CAENRFIDReader* reader,
+                                       CAENRFID_Bitrate Bitrate);
+
+/*
+    CAENRFID_GetBitRate.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [out] Bitrate        : Modulation setting.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        The function permits to retrieve the modulation (the bitrate of the
+        transmission and reception).
+*/
+CAENRFIDErrorCodes CAENRFID_GetBitrate(CAENRFIDReader* reader,
+                                       CAENRFID_Bitrate* Bitrate);
+
+/*
+    CAENRFID_SetFHSSMode.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  FHSSMode       : A zero value to disable FHSS, non-zero value
+                               to enable FHSS.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        The function permits to enable/disable the frequency hopping mode of
+        the reader.
+*/
+CAENRFIDErrorCodes CAENRFID_SetFHSSMode(CAENRFIDReader* reader,
+                                        uint16_t FHSSMode);
+
+/*
+    CAENRFID_GetFHSSMode.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [out] FHSSMode       : A zero value if the FHSS is disabled, non-zero value
+                               if it is enabled.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        The function indicates the activation of the frequency hopping mode of
+        the reader.
+*/
+CAENRFIDErrorCodes CAENRFID_GetFHSSMode(CAENRFIDReader* reader,
+                                        uint16_t* FHSSMode);
+
+/*
+    CAENRFID_SetRFChannel.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  RFChannel      : The RF Channel
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        The function permits to set the RF Channel.
+*/
+CAENRFIDErrorCodes CAENRFID_SetRFChannel(CAENRFIDReader* reader, 
+                                         uint16_t RFChannel);
+
+/*
+    CAENRFID_GetRFChannel.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [out] RFChannel      : The RF Channel
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        The function permits to retrieve the RF Channel.
+*/
+CAENRFIDErrorCodes CAENRFID_GetRFChannel(CAENRFIDReader* reader, 
+                                         uint16_t* RFChannel);
+
+/*
+    CAENRFID_SetRFRegulation.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  RFRegulation   : The RF Regulation
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        The function permits to set the RF Regulation.
+*/
+CAENRFIDErrorCodes CAENRFID_SetRFRegulation(CAENRFIDReader* reader, 
+                                            CAENRFIDRFRegulations RFRegulation);
+
+/*
+    CAENRFID_GetRFRegulation.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [out] RFRegulation   : The RF Regulation
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        The function permits to retrieve the RF Regulation.
+*/
+CAENRFIDErrorCodes CAENRFID_GetRFRegulation(CAENRFIDReader* reader, 
+                                            CAENRFIDRFRegulations* RFRegulation);
+
+/*
+    CAENRFID_SetIO.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  IORegister     : The IO Register value.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        The function permits to write the IO register.
+*/
+CAENRFIDErrorCodes CAENRFID_SetIO(CAENRFIDReader* reader,
+                                  uint32_t IORegister);
+
+/*
+    CAENRFID_GetIO.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [out] IORegister     : The current IO Register.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        The function permits to read the IO register.
+*/
+CAENRFIDErrorCodes CAENRFID_GetIO(CAENRFIDReader* reader,
+                                  uint32_t* IORegister);
+
+/*
+    CAENRFID_SetIODirection.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  IODirection    : The IO Direction value.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        The function permits to set the IO Direction for the IORegister.
+*/
+CAENRFIDErrorCodes CAENRFID_SetIODirection(CAENRFIDReader* reader,
+                                           uint32_t IODirection);
+
+/*
+    CAENRFID_GetIODirection.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [out] IODirection    : The current IO Direction.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        The function permits to read the IO direction of IORegister.
+*/
+CAENRFIDErrorCodes CAENRFID_GetIODirection(CAENRFIDReader* reader,
+                                           uint32_t* IODirection);
+
+/*
+    CAENRFID_ReadTagData_EPC_C1G2.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  Tag            : The tag to be read.
+        [in]  Bank           : The memory Bank of EPC C1G2 Tag
+        [in]  ByteAddress    : The byte address of the memory to read.
+        [in]  ByteLength     : The number of bytes to read.
+        [out] Data           : The data read from the tag's memory.
+        [in]  AccessPassword : The tag Access password. If 0, no password is used.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        This function allows to read ByteLength bytes from the bank memory,
+        specified by Bank, of a specific tag identified by the
+        Tag at the address specified by ByteAddress.
+*/
+CAENRFIDErrorCodes CAENRFID_ReadTagData_EPC_C1G2(CAENRFIDReader* reader,
+                                                 CAENRFIDTag* Tag, 
+                                                 uint16_t Bank,
+                                                 uint16_t ByteAddress,
+                                                 uint16_t ByteLength,
+                                                 uint8_t* Data,
+                                                 uint32_t AccessPassword);
+
+/*
+    CAENRFID_WriteTagData_EPC_C1G2.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  Tag            : The tag to be written.
+        [in]  Bank           : The memory Bank of EPC C1G2 Tag
+        [in]  ByteAddress    : The byte address of the memory to write.
+        [in]  ByteLength     : The number of bytes to write.
+        [in]  Data           : The data to write in the tag's memory.
+        [in]  AccessPassword : The tag Access password. If 0, no password is used.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        This function allows to write ByteLength bytes to the bank memory,
+        specified by Bank, of a specific tag identified by the
+        Tag at the address specified by ByteAddress.
+*/
+CAENRFIDErrorCodes CAENRFID_WriteTagData_EPC_C1G2(CAENRFIDReader* reader,
+                                                  CAENRFIDTag* Tag,
+                                                  uint16_t Bank,
+                                                  uint16_t ByteAddress,
+                                                  uint16_t ByteLength,
+                                                  uint8_t* Data,
+                                                  uint32_t AccessPassword);
+
+/*
+    CAENRFID_ReadTagDataBatch_EPC_C1G2.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  Tags           : The tags to be read (e.g. an inventory result).
+        [in]  NumTags        : The number of tags in Tags.
+        [in]  Bank           : The memory Bank of EPC C1G2 Tag
+        [in]  ByteAddress    : The byte address of the memory to read.
+        [in]  ByteLength     : The number of bytes to read from each tag.
+        [out] Data           : NumTags * ByteLength bytes, the data read from
+                               Tags[i] are stored at Data[i * ByteLength].
+        [in]  AccessPassword : The tag Access password. If 0, no password is used.
+        [out] Results        : NumTags entries, the result of the read of each tag.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function: CAENRFID_StatusOK
+        unless the batch was stopped, in which case the tags not read report
+        the same error in Results.
+    -----------------------------------------------------------------------------
+    Description:
+        This function reads the same memory area of many tags. The command
+        frame is encoded once and only patched with the ID of each tag (and
+        rebuilt when the logical source or the ID length changes); up to
+        CAENRFID_PIPELINE_DEPTH reads are kept in flight (see CAENRFIDPipeline).
+        The reader buffer must hold both the command and its reply, otherwise
+        CAENRFID_OutOfMemoryError is returned.
+*/
+CAENRFIDErrorCodes CAENRFID_ReadTagDataBatch_EPC_C1G2(CAENRFIDReader* reader,
+                                                      CAENRFIDTag* Tags,
+                                                      uint16_t NumTags,
+                                                      uint16_t Bank,
+                                                      uint16_t ByteAddress,
+                                                      uint16_t ByteLength,
+                                                      uint8_t* Data,
+                                                      uint32_t AccessPassword,
+                                                      CAENRFIDErrorCodes* Results);
+
+/*
+    CAENRFID_WriteTagDataBatch_EPC_C1G2.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  Tags           : The tags to be written (e.g. an inventory result).
+        [in]  NumTags        : The number of tags in Tags.
+        [in]  Bank           : The memory Bank of EPC C1G2 Tag
+        [in]  ByteAddress    : The byte address of the memory to write.
+        [in]  ByteLength     : The number of bytes to write in each tag.
+        [in]  Data           : NumTags * ByteLength bytes, Data[i * ByteLength]
+                               is written in Tags[i].
+        [in]  AccessPassword : The tag Access password. If 0, no password is used.
+        [out] Results        : NumTags entries, the result of the write of each tag.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function, see
+        CAENRFID_ReadTagDataBatch_EPC_C1G2.
+    -----------------------------------------------------------------------------
+    Description:
+        This function writes the same memory area of many tags, see
+        CAENRFID_ReadTagDataBatch_EPC_C1G2.
+*/
+CAENRFIDErrorCodes CAENRFID_WriteTagDataBatch_EPC_C1G2(CAENRFIDReader* reader,
+                                                       CAENRFIDTag* Tags,
+                                                       uint16_t NumTags,
+                                                       uint16_t Bank,
+                                                       uint16_t ByteAddress,
+                                                       uint16_t ByteLength,
+                                                       uint8_t* Data,
+                                                       uint32_t AccessPassword,
+                                                       CAENRFIDErrorCodes* Results);
+
+/*
+    CAENRFID_LockTag_EPC_C1G2.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  Tag            : The tag.
+        [in]  Payload        : The payload of the tag's memory.
+        [in]  AccessPassword : The tag Access Password. If 0, no password is used.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        This function allows to secure lock the memory of a
+        specific tag identified by the Tag.
+*/
+CAENRFIDErrorCodes CAENRFID_LockTag_EPC_C1G2(CAENRFIDReader* reader,
+                                             CAENRFIDTag *Tag,
+                                             uint32_t Payload,
+                                             uint32_t AccessPassword);
+
+/*
+    CAENRFID_KillTag_EPC_C1G2.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  Tag            : The tag to kill.
+        [in]  Password       : The tag Kill Password.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        The function permits to kill an EPC Class 1 Gen 2 tag.
+*/
+CAENRFIDErrorCodes CAENRFID_KillTag_EPC_C1G2(CAENRFIDReader* reader,
+                                             CAENRFIDTag *Tag,
+                                             uint32_t Password);
+
+/*
+    CAENRFID_ProgramID_EPC_C1G2.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  Tag            : Contains the tag EPC C1G2 ID to be programmed.
+        [in]  nsi            : The NSI value for the EPC C1G2.
+        [in]  AccessPassword : The tag Access Password. If 0, no password is used.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        The function permits to program the EPC Code of an EPC Class 1 Gen 2 tag.
+*/
+CAENRFIDErrorCodes CAENRFID_ProgramID_EPC_C1G2(CAENRFIDReader* reader,
+                                               CAENRFIDTag *Tag,
+                                               uint16_t nsi,
+                                               uint32_t AccessPassword);
+
+/*
+    CAENRFID_CustomCommand_EPC_C1G2.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  Tag            : The tag.
+        [in]  SubCmd         : The subcommand.
+        [in]  TxLen          : The number of bytes to send to the tag.
+        [in]  Data           : The data to be sent to the tag.
+        [in]  RxLen          : The number of bytes to be received from the tag.
+        [in]  AccessPassword : The tag Access Password. If 0, no password is used.
+        [out] TRData         : The data received from the tag.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        Special function to implement custom commands.
+*/
+CAENRFIDErrorCodes CAENRFID_CustomCommand_EPC_C1G2(CAENRFIDReader* reader,
+                                                   CAENRFIDTag *Tag,
+                                                   uint8_t SubCmd,
+                                                   uint16_t TxLen,
+                                                   uint8_t *Data,
+                                                   uint16_t RxLen,
+                                                   uint32_t AccessPassword,
+                                                   uint8_t *TRData);
+
+/*
+    CAENRFID_TagHandleInit.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [out] Handle         : The handle to be built.
+        [in]  Tag            : The tag to be addressed, NULL for custom commands
+                               not addressing a tag.
+        [in]  AccessPassword : The tag Access password. If 0, no password is used.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        This function encodes once the attributes every access command sends
+        to address Tag, so that the *Handle_EPC_C1G2 functions only copy them
+        into their frame. It is worth when several commands are issued to the
+        same tag, e.g. on an encoding station; the functions taking a
+        CAENRFIDTag build a handle on each call.
+        CAENRFID_InvalidParam is returned if the ID or the logical source
+        name of Tag are too long.
+*/
+CAENRFIDErrorCodes CAENRFID_TagHandleInit(CAENRFIDTagHandle* Handle,
+                                          const CAENRFIDTag* Tag,
+                                          uint32_t AccessPassword);
+
+/*
+    CAENRFID_ReadTagDataHandle_EPC_C1G2.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  Handle         : The tag, see CAENRFID_TagHandleInit.
+        [in]  Bank           : The memory Bank of EPC C1G2 Tag
+        [in]  ByteAddress    : The byte address of the memory to read.
+        [in]  ByteLength     : The number of bytes to read.
+        [out] Data           : The data read from the tag's memory.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        Same as CAENRFID_ReadTagData_EPC_C1G2, the tag and the access
+        password being given by Handle.
+*/
+CAENRFIDErrorCodes CAENRFID_ReadTagDataHandle_EPC_C1G2(CAENRFIDReader* reader,
+                                                       const CAENRFIDTagHandle* Handle,
+                                                       uint16_t Bank,
+                                                       uint16_t ByteAddress,
+                                                       uint16_t ByteLength,
+                                                       uint8_t* Data);
+
+/*
+    CAENRFID_WriteTagDataHandle_EPC_C1G2.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  Handle         : The tag, see CAENRFID_TagHandleInit.
+        [in]  Bank           : The memory Bank of EPC C1G2 Tag
+        [in]  ByteAddress    : The byte address of the memory to write.
+        [in]  ByteLength     : The number of bytes to write.
+        [in]  Data           : The data to write in the tag's memory.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        Same as CAENRFID_WriteTagData_EPC_C1G2, the tag and the access
+        password being given by Handle.
+*/
+CAENRFIDErrorCodes CAENRFID_WriteTagDataHandle_EPC_C1G2(CAENRFIDReader* reader,
+                                                        const CAENRFIDTagHandle* Handle,
+                                                        uint16_t Bank,
+                                                        uint16_t ByteAddress,
+                                                        uint16_t ByteLength,
+                                                        uint8_t* Data);
+
+/*
+    CAENRFID_LockTagHandle_EPC_C1G2.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  Handle         : The tag, see CAENRFID_TagHandleInit.
+        [in]  Payload        : The payload of the tag's memory.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        Same as CAENRFID_LockTag_EPC_C1G2, the tag and the access password
+        being given by Handle.
+*/
+CAENRFIDErrorCodes CAENRFID_LockTagHandle_EPC_C1G2(CAENRFIDReader* reader,
+                                                   const CAENRFIDTagHandle* Handle,
+                                                   uint32_t Payload);
+
+/*
+    CAENRFID_KillTagHandle_EPC_C1G2.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  Handle         : The tag, see CAENRFID_TagHandleInit.
+        [in]  Password       : The tag Kill Password.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        Same as CAENRFID_KillTag_EPC_C1G2, the tag being given by Handle.
+        The access password of Handle is not sent.
+*/
+CAENRFIDErrorCodes CAENRFID_KillTagHandle_EPC_C1G2(CAENRFIDReader* reader,
+                                                   const CAENRFIDTagHandle* Handle,
+                                                   uint32_t Password);
+
+/*
+    CAENRFID_ProgramIDHandle_EPC_C1G2.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  Handle         : Contains the tag EPC C1G2 ID to be programmed,
+                               see CAENRFID_TagHandleInit.
+        [in]  nsi            : The NSI value for the EPC C1G2.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        Same as CAENRFID_ProgramID_EPC_C1G2, the ID and the access password
+        being given by Handle. Handle then addresses the tag by its new ID.
+*/
+CAENRFIDErrorCodes CAENRFID_ProgramIDHandle_EPC_C1G2(CAENRFIDReader* reader,
+                                                     const CAENRFIDTagHandle* Handle,
+                                                     uint16_t nsi);
+
+/*
+    CAENRFID_CustomCommandHandle_EPC_C1G2.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  Handle         : The tag, see CAENRFID_TagHandleInit.
+        [in]  SubCmd         : The subcommand.
+        [in]  TxLen          : The number of bytes to send to the tag.
+        [in]  Data           : The data to be sent to the tag.
+        [in]  RxLen          : The number of bytes to be received from the tag.
+        [out] TRData         : The data received from the tag.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        Same as CAENRFID_CustomCommand_EPC_C1G2, the tag and the access
+        password being given by Handle.
+*/
+CAENRFIDErrorCodes CAENRFID_CustomCommandHandle_EPC_C1G2(CAENRFIDReader* reader,
+                                                         const CAENRFIDTagHandle* Handle,
+                                                         uint8_t SubCmd,
+                                                         uint16_t TxLen,
+                                                         uint8_t *Data,
+                                                         uint16_t RxLen,
+                                                         uint8_t *TRData);
+
+/*
+    CAENRFID_GroupSelUnsel.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  SourceName     : The name that identifies the Logical Source.
+        [in]  Code           : The select/unselect operation.
+        [in]  Address        : The tag memory address the Data are compared to.
+        [in]  BitMask        : A bitmask of the bytes of Data to be compared.
+        [in]  Data           : The 8 bytes compared to the tag memory.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        This function sends the group select/unselect command to the reader.
+        The command applies to ISO18000-6B tags only and it is obsolete: EPC
+        C1G2 tags can be selected with several masks by means of
+        CAENRFID_InventoryTagSelect.
+*/
+CAENRFIDErrorCodes CAENRFID_GroupSelUnsel(CAENRFIDReader* reader,
+                                         char* SourceName,
+                                         CAENRFIDSelUnselOptions Code,
+                                         uint16_t Address,
+                                         uint8_t BitMask,
+                                         uint8_t* Data);
+
+/*
+    CAENRFID_InventoryTag.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  SourceName     : The name that identifies the Logical Source.
+        [in]  Bank           : The bank where apply the mask.
+        [in]  MaskBitAddress : The position in bit from where starting to compare the mask 
+                               to the choosen bank.
+        [in]  MaskBitLength  : The length in bit of the significative part of the Mask.
+        [in]  Mask           : The array containing the Mask.
+        [in]  MaskLen        : The number of bytes passed in Mask.
+        [in]  flag           : A bitmask that indicates the mode of inventory and the 
+                               retrieving of RSSI, TID, XPC and PC values.
+        [out] TagList        : A List containing the tags read (only for
+                               an inventory of type NOT framed and NOT continuous).
+        [out] Size           : Returns the number of tags in the list (only for
+                               an inventory of type NOT framed and NOT continuous).
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        This function is used to perform a simple inventory round or to start a cycle
+        of continuous plus framed inventory rounds. The inventory is performed on 
+        all antennas belonging to the logical source SourceName and will apply 
+        the mask parameters to the founded tags, returning only those tags whose 
+        relative bank matches the mask.
+
+        If the continuous and framed mode of inventory is NOT selected in the flag
+        parameter, the TagList list contains the IDs of the detected tags, together
+        with other information  related to the single ID such as the antenna on which
+        the ID was detected and the format of the ID itself (see CAENRFIDTag struct 
+        for the details).
+
+        If the continuos and framed mode of inventory is selected in flag, the
+        reader performs a number of inventory rounds dependant on the value 
+        of the CONFIG_READCYCLE parameter of the logical source SourceName (see 
+        function CAENRFID_SetSourceConfiguration). 
+        In this case TagList and Size parameters are ignored, user should call the 
+        CAENRFID_GetFramedTag function to retrieve tags detected during an inventory
+        of such type, as well as to detect its ending.
+
+        When the library is built with CAENRFID_NO_HEAP, TagList cannot be
+        allocated and a NOT framed inventory returns CAENRFID_OutOfMemoryError:
+        use CAENRFID_InventoryTagArray instead.
+*/
+CAENRFIDErrorCodes CAENRFID_InventoryTag(CAENRFIDReader* reader,
+                                         char* SourceName,
+                                         uint16_t Bank,
+                                         uint16_t MaskBitAddress,
+                                         uint16_t MaskBitLength,
+                                         uint8_t* Mask,
+                                         uint16_t MaskLen,
+                                         uint16_t flag,
+                                         CAENRFIDTagList** TagList,
+                                         uint16_t* Size);
+
+/*
+    CAENRFID_InventoryTagArray.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  SourceName     : The name that identifies the Logical Source.
+        [in]  Bank           : The bank where apply the mask.
+        [in]  MaskBitAddress : The position in bit from where starting to compare the mask 
+                               to the choosen bank.
+        [in]  MaskBitLength  : The length in bit of the significative part of the Mask.
+        [in]  Mask           : The array containing the Mask.
+        [in]  MaskLen        : The number of bytes passed in Mask.
+        [in]  flag           : A bitmask that indicates the retrieving of RSSI, TID,
+                               XPC and PC values. FRAMED, CONTINUOS and EVENT_TRIGGER
+                               are not allowed.
+        [out] Tags           : A caller provided array receiving the tags read.
+        [in]  MaxTags        : The number of elements of Tags.
+        [out] Size           : Returns the number of tags stored in Tags.
+        [out] Found          : Returns the number of tags reported by the reader.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        This function performs a simple inventory round like CAENRFID_InventoryTag,
+        but stores the detected tags contiguously in Tags, in the order they were
+        reported by the reader, instead of allocating a list element per tag.
+        If Found is greater than Size, Tags was too small and the exceeding tags
+        were discarded.
+        The same array can be passed again for the next round: nothing has to be
+        released between calls.
+*/
+CAENRFIDErrorCodes CAENRFID_InventoryTagArray(CAENRFIDReader* reader,
+                                              char* SourceName,
+                                              uint16_t Bank,
+                                              uint16_t MaskBitAddress,
+                                              uint16_t MaskBitLength,
+                                              uint8_t* Mask,
+                                              uint16_t MaskLen,
+                                              uint16_t flag,
+                                              CAENRFIDTag* Tags,
+                                              uint16_t MaxTags,
+                                              uint16_t* Size,
+                                              uint16_t* Found);
+
+/*
+    CAENRFID_InventoryTagFrame.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  SourceName     : The name that identifies the Logical Source.
+        [in]  Bank           : The bank where apply the mask.
+        [in]  MaskBitAddress : The position in bit from where starting to compare the mask 
+                               to the choosen bank.
+        [in]  MaskBitLength  : The length in bit of the significative part of the Mask.
+        [in]  Mask           : The array containing the Mask.
+        [in]  MaskLen        : The number of bytes passed in Mask.
+        [in]  flag           : A bitmask that indicates the retrieving of RSSI,
+                               TID, XPC and PC values. FRAMED, CONTINUOS and
+                               EVENT_TRIGGER are not allowed.
+        [out] Frame          : Holds the reply, to be read with 
+                               CAENRFID_TagFrameNext.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        This function performs a simple inventory round like CAENRFID_InventoryTag,
+        but tags are not copied out of the reply: CAENRFID_TagFrameNext returns
+        views pointing into it. On success the reply is held in the reader
+        buffer and any other command on reader fails with CAENRFID_ReaderBusy
+        until CAENRFID_TagFrameRelease is called.
+*/
+CAENRFIDErrorCodes CAENRFID_InventoryTagFrame(CAENRFIDReader* reader,
+                                              char* SourceName,
+                                              uint16_t Bank,
+                                              uint16_t MaskBitAddress,
+                                              uint16_t MaskBitLength,
+                                              uint8_t* Mask,
+                                              uint16_t MaskLen,
+                                              uint16_t flag,
+                                              CAENRFIDTagFrame* Frame);
+
+/*
+    CAENRFID_TagFrameNext.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  Frame          : A frame filled by CAENRFID_InventoryTagFrame.
+        [out] View           : The next tag of the frame.
+    -----------------------------------------------------------------------------
+    Returns:
+        CAENRFID_StatusOK if View has been filled, CAENRFID_EOF after the last
+        tag, or the error reported by the reader for the inventory.
+    -----------------------------------------------------------------------------
+    Description:
+        This function returns the tags of a frame in the order they have been
+        received. View refers to the frame and is valid until 
+        CAENRFID_TagFrameRelease.
+*/
+CAENRFIDErrorCodes CAENRFID_TagFrameNext(CAENRFIDTagFrame* Frame,
+                                         CAENRFIDTagView* View);
+
+/*
+    CAENRFID_TagFrameRelease.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  Frame          : A frame filled by CAENRFID_InventoryTagFrame.
+    -----------------------------------------------------------------------------
+    Returns:
+    -----------------------------------------------------------------------------
+    Description:
+        This function gives the reader buffer back to reader; the views taken
+        from Frame must not be used anymore.
+*/
+void CAENRFID_TagFrameRelease(CAENRFIDTagFrame* Frame);
+
+/*
+    CAENRFID_InventoryTagStream.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  SourceName     : The name that identifies the Logical Source.
+        [in]  Bank           : The bank where apply the mask.
+        [in]  MaskBitAddress : The position in bit from where starting to compare the mask 
+                               to the choosen bank.
+        [in]  MaskBitLength  : The length in bit of the significative part of the Mask.
+        [in]  Mask           : The array containing the Mask.
+        [in]  MaskLen        : The number of bytes passed in Mask.
+        [in]  flag           : A bitmask that indicates the mode of inventory and the 
+                               retrieving of RSSI, TID, XPC and PC values.
+        [in]  Callbacks      : The functions the tags and the outcome of the
+                               inventory are delivered to.
+    -----------------------------------------------------------------------------
+    Returns:
+        The result code reported by the reader, or the error passed to on_error.
+    -----------------------------------------------------------------------------
+    Description:
+        This function performs an inventory like CAENRFID_InventoryTag and
+        returns when it is over. Tags are not collected: each one is passed to
+        on_tag as soon as its AVPs have been received, without waiting for the
+        rest of the reply, both for a simple round and for a continuous plus
+        framed inventory.
+        If on_tag returns false a framed inventory is aborted, while the rest
+        of a simple round is received and discarded.
+        In framed mode the function keeps waiting while no tag is detected; 
+        CAENRFID_InventoryAbort may be called from another thread as for 
+        CAENRFID_GetFramedTag.
+*/
+CAENRFIDErrorCodes CAENRFID_InventoryTagStream(CAENRFIDReader* reader,
+                                               char* SourceName,
+                                               uint16_t Bank,
+                                               uint16_t MaskBitAddress,
+                                               uint16_t MaskBitLength,
+                                               uint8_t* Mask,
+                                               uint16_t MaskLen,
+                                               uint16_t flag,
+                                               const CAENRFIDInventoryCallbacks* Callbacks);
+
+/*
+    CAENRFID_GetFramedTag.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader          : The reader data structure that identifies the device.
+        [out] has_tag         : Contains information about whether a tag was detected
+                                and received from the reader or not.
+        [out] Tag             : The detected tag, if present.
+        [out] has_result_code : Contains information about whether the inventory 
+                                rounds ended and a result code was returned by the 
+                                reader or not.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        This function is used to receive a tag Tag detected by the reader during
+        a framed plus continuous inventory. The function also detects the ending
+        of such an inventory. 
+        The framed plus continuous inventory must be started using the 
+        CAENRFID_InventoryTag function.
+        If the reader rx_some callback is set, the bytes available are received
+        at once and the following tags are parsed without further transport reads.
+*/
+CAENRFIDErrorCodes CAENRFID_GetFramedTag(CAENRFIDReader* reader,
+                                         bool* has_tag,
+                                         CAENRFIDTag* Tag, 
+                                         bool* has_result_code);
+
+/*
+    CAENRFID_InventoryAbort.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        This function tries to stop an ongoing framed plus continuous inventory.
+        To detect the ending of such inventory the user should use the 
+        CAENRFID_GetFramedTag function.
+*/
+CAENRFIDErrorCodes CAENRFID_InventoryAbort(CAENRFIDReader* reader);
+
+/*
+    CAENRFID_GetBufferSize.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [out] Size           : Returns the number of reads held in the reader buffer.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        This function returns the number of tag reads the reader has stored
+        in its buffer while inventorying on its own.
+        The encoding of the reply (AVP_LONG_LENGTH) is not documented by the
+        protocol manual and has not been verified on a reader.
+*/
+CAENRFIDErrorCodes CAENRFID_GetBufferSize(CAENRFIDReader* reader,
+                                          uint32_t* Size);
+
+/*
+    CAENRFID_ClearBuffer.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        This function discards all the reads held in the reader buffer.
+        Not verified on a reader, see CAENRFID_GetBufferedData.
+*/
+CAENRFIDErrorCodes CAENRFID_ClearBuffer(CAENRFIDReader* reader);
+
+/*
+    CAENRFID_GetBufferedData.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  flag           : A bitmask that indicates the retrieving of RSSI, TID,
+                               XPC and PC values. Other flags are not allowed.
+        [out] Tags           : A caller provided array receiving the reads.
+        [in]  MaxTags        : The number of elements of Tags.
+        [out] Size           : Returns the number of reads stored in Tags.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        This function moves the oldest reads out of the reader buffer into
+        Tags, with a single command whatever their number. At most as many
+        reads as fit both Tags and the reader scratch buffer 
+        (CAENRFID_MAX_FRAME_LENGTH) are requested, so that the buffer is
+        drained in chunks by calling the function until Size is 0:
+
+            do {
+                ret = CAENRFID_GetBufferedData(reader, RSSI, Tags, N, &Size);
+                ...
+            } while((ret == CAENRFID_StatusOK) && (Size > 0));
+
+        Reads not transferred stay in the reader buffer for the next call.
+        WARNING: the protocol manual lists this command as obsolete and does
+        not document it. The encoding used (chunk size in AVP_LENGTH, fields
+        in AVP_BITMASK, reads encoded as by a non compact inventory) is
+        assumed from the inventory command and has only been checked against
+        CAENRFIDEmulator, which implements the same assumption, not against
+        reader firmware.
+*/
+CAENRFIDErrorCodes CAENRFID_GetBufferedData(CAENRFIDReader* reader,
+                                            uint16_t flag,
+                                            CAENRFIDTag* Tags,
+                                            uint16_t MaxTags,
+                                            uint16_t* Size);
+
+/*
+    CAENRFID_TagPoolInit.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [out] Pool           : The pool to be initialized.
+        [in]  Tags           : A user provided array of packed tags.
+        [in]  MaxTags        : The number of elements of Tags.
+        [in]  Data           : A user provided buffer for the variable length
+                               fields of the tags (ID, TID, XPC, PC).
+        [in]  DataSize       : The size in bytes of Data.
+    -----------------------------------------------------------------------------
+    Returns:
+    -----------------------------------------------------------------------------
+    Description:
+        This function prepares an empty pool storing tags in the compact
+        CAENRFIDPackedTag layout. A tag with a 12 bytes EPC and no TID takes
+        sizeof(CAENRFIDPackedTag) plus 12 bytes, instead of sizeof(CAENRFIDTag).
+*/
+void CAENRFID_TagPoolInit(CAENRFIDTagPool* Pool,
+                          CAENRFIDPackedTag* Tags,
+                          uint32_t MaxTags,
+                          uint8_t* Data,
+                          uint32_t DataSize);
+
+/*
+    CAENRFID_TagPoolClear.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in],[out]  Pool     : The pool to be emptied.
+    -----------------------------------------------------------------------------
+    Returns:
+    -----------------------------------------------------------------------------
+    Description:
+        This function removes all the tags from the pool, keeping its storage.
+*/
+void CAENRFID_TagPoolClear(CAENRFIDTagPool* Pool);
+
+/*
+    CAENRFID_TagPoolAdd.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in],[out]  Pool     : The pool where the tag is stored.
+        [in]        Tag      : The tag to be packed.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        This function appends Tag to the pool. CAENRFID_OutOfMemoryError is
+        returned if either the tags array or the data buffer is full.
+        Logical source and read point names not belonging to the reader are 
+        not stored (PACKED_TAG_NO_INDEX), as well as all zero XPC and PC.
+*/
+CAENRFIDErrorCodes CAENRFID_TagPoolAdd(CAENRFIDTagPool* Pool,
+                                       const CAENRFIDTag* Tag);
+
+/*
+    CAENRFID_TagPoolGet.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  Pool           : The pool.
+        [in]  Index          : The position of the tag in the pool.
+        [out] Tag            : The unpacked tag.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        This function converts back the Index-th tag of the pool to a
+        CAENRFIDTag.
+*/
+CAENRFIDErrorCodes CAENRFID_TagPoolGet(const CAENRFIDTagPool* Pool,
+                                       uint32_t Index,
+                                       CAENRFIDTag* Tag);
+
+/*
+    CAENRFID_TagMatch.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  Tag            : The tag to be checked.
+        [in]  Bank           : The bank where apply the mask (EPC_CAEN or TID).
+        [in]  MaskBitAddress : The position in bit from where starting to compare the mask 
+                               to the choosen bank.
+        [in]  MaskBitLength  : The length in bit of the significative part of the Mask.
+        [in]  Mask           : The array containing the Mask.
+        [in]  MaskLen        : The number of bytes passed in Mask.
+        [out] Match          : Whether Tag matches the mask.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        This function applies on the host the mask CAENRFID_InventoryTag
+        passes to the reader. The EPC bank is made of the CRC, PC and ID of
+        the tag: the CRC is not known to the host, so the mask must start at
+        bit 16 or later. The TID bank is known only for tags read with
+        TID_READING.
+*/
+CAENRFIDErrorCodes CAENRFID_TagMatch(const CAENRFIDTag* Tag,
+                                     uint16_t Bank,
+                                     uint16_t MaskBitAddress,
+                                     uint16_t MaskBitLength,
+                                     uint8_t* Mask,
+                                     uint16_t MaskLen,
+                                     bool* Match);
+
+/*
+    CAENRFID_FilterTags.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in],[out]  Tags     : The tags to be filtered.
+        [in]  NumTags        : The number of elements of Tags.
+        [in]  Bank           : The bank where apply the mask (EPC_CAEN or TID).
+        [in]  MaskBitAddress : The position in bit from where starting to compare the mask 
+                               to the choosen bank.
+        [in]  MaskBitLength  : The length in bit of the significative part of the Mask.
+        [in]  Mask           : The array containing the Mask.
+        [in]  MaskLen        : The number of bytes passed in Mask.
+        [out] Size           : Returns the number of tags matching the mask.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        This function moves the tags matching the mask, as for 
+        CAENRFID_TagMatch, to the first Size elements of Tags, in their 
+        original order. The mask is prepared once, so that each tag costs a
+        few vector compares whatever MaskBitAddress.
+*/
+CAENRFIDErrorCodes CAENRFID_FilterTags(CAENRFIDTag* Tags,
+                                       uint32_t NumTags,
+                                       uint16_t Bank,
+                                       uint16_t MaskBitAddress,
+                                       uint16_t MaskBitLength,
+                                       uint8_t* Mask,
+                                       uint16_t MaskLen,
+                                       uint32_t* Size);
+
+/*
+    CAENRFID_InventoryTagSelect.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  SourceName     : The name that identifies the Logical Source.
+        [in]  Clauses        : The select clauses, applied in order (see 
+                               CAENRFIDSelectClause).
+        [in]  NumClauses     : The number of elements of Clauses.
+        [in]  flag           : A bitmask that indicates the retrieving of RSSI, TID,
+                               XPC and PC values. FRAMED, CONTINUOS and EVENT_TRIGGER
+                               are not allowed.
+        [out] Tags           : A caller provided array receiving the tags selected.
+        [in]  MaxTags        : The number of elements of Tags.
+        [in],[out] Overflow  : An empty de-duplication set (see
+                               CAENRFID_DedupInit, without DEDUP_BY_READPOINT)
+                               recording the tags not fitting in Tags, or NULL.
+        [out] Size           : Returns the number of tags stored in Tags.
+        [out] Found          : Returns the number of tags selected.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        This function returns the tags selected by a sequence of select and
+        unselect clauses. Each tag starts unselected and, clause after
+        clause, GROUP_SELECT_EQUAL selects the tags matching the mask,
+        GROUP_SELECT_NOT_EQUAL the tags not matching it, GROUP_UNSELECT_EQUAL
+        unselects the tags matching it and GROUP_UNSELECT_NOT_EQUAL the tags
+        not matching it. Masks are as for CAENRFID_TagMatch; TID clauses need
+        TID_READING in flag.
+        An inventory round as for CAENRFID_InventoryTagArray is performed for
+        each GROUP_SELECT_EQUAL clause, with its mask sent to the reader so
+        that only candidate tags are transmitted, and the clauses are then
+        applied to the tags received. A single round without mask is
+        performed if a GROUP_SELECT_NOT_EQUAL clause or a select clause
+        without mask is present. A tag reported by more than one round is
+        stored and counted in Found once. The tags not fitting in Tags are
+        counted once as long as Overflow has room for them; with Overflow
+        NULL, or once it is full, they are counted by every round reporting
+        them and Found is an upper bound. With a single round Found is
+        exact whatever Overflow.
+*/
+CAENRFIDErrorCodes CAENRFID_InventoryTagSelect(CAENRFIDReader* reader,
+                                               char* SourceName,
+                                               const CAENRFIDSelectClause* Clauses,
+                                               uint16_t NumClauses,
+                                               uint16_t flag,
+                                               CAENRFIDTag* Tags,
+                                               uint16_t MaxTags,
+                                               CAENRFIDDedup* Overflow,
+                                               uint16_t* Size,
+                                               uint16_t* Found);
+
+/*
+    CAENRFID_FilterCompile.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [out] Filter         : The filter to be built.
+        [in],[out] Rules     : A user provided array of rules, with Bank,
+                               MaskBitAddress, MaskBitLength and Mask set as 
+                               for CAENRFID_TagMatch. Rules and their masks
+                               must be kept until the filter is not used anymore.
+        [in]  NumRules       : The number of elements of Rules.
+        [in]  Slots          : A user provided hash table.
+        [in]  NumSlots       : The number of elements of Slots, a power of two
+                               greater than NumRules.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        This function builds a filter passing the tags that match any of
+        Rules, and fills its Reader fields with the mask to be passed to
+        CAENRFID_InventoryTag so that the reader already drops part of the
+        tags. CAENRFID_OutOfMemoryError is returned if the rules have more 
+        than CAENRFID_FILTER_MAX_GROUPS different bank, address and length.
+*/
+CAENRFIDErrorCodes CAENRFID_FilterCompile(CAENRFIDFilter* Filter,
+                                          CAENRFIDFilterRule* Rules,
+                                          uint32_t NumRules,
+                                          uint32_t* Slots,
+                                          uint32_t NumSlots);
+
+/*
+    CAENRFID_FilterMatch.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  Filter         : A filter built by CAENRFID_FilterCompile.
+        [in]  Tag            : The tag to be checked.
+        [out] Match          : Whether Tag matches any rule of Filter.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        This function checks Tag against the filter rules, with one hash
+        lookup per group of rules.
+*/
+CAENRFIDErrorCodes CAENRFID_FilterMatch(const CAENRFIDFilter* Filter,
+                                        const CAENRFIDTag* Tag,
+                                        bool* Match);
+
+/*
+    CAENRFID_FilterApply.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  Filter         : A filter built by CAENRFID_FilterCompile.
+        [in],[out]  Tags     : The tags to be filtered.
+        [in]  NumTags        : The number of elements of Tags.
+        [out] Size           : Returns the number of tags passing the filter.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        This function moves the tags passing the filter to the first Size
+        elements of Tags, in their original order.
+*/
+CAENRFIDErrorCodes CAENRFID_FilterApply(const CAENRFIDFilter* Filter,
+                                        CAENRFIDTag* Tags,
+                                        uint32_t NumTags,
+                                        uint32_t* Size);
+
+/*
+    CAENRFID_DedupInit.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [out] Dedup          : The de-duplication set to be initialized.
+        [in]  Entries        : A user provided array of entries, one per tag
+                               tracked at the same time.
+        [in]  MaxEntries     : The number of elements of Entries.
+        [in]  Slots          : A user provided hash table.
+        [in]  NumSlots       : The number of elements of Slots, a power of two
+                               greater than MaxEntries (twice as many keeps
+                               lookups short).
+        [in]  Flags          : DEDUP_BY_READPOINT to track a tag on each read
+                               point separately, 0 otherwise.
+        [in]  HoldOffMs      : The minimum time between two events of a tag.
+        [in]  LostMs         : The time after which an unread tag is lost.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        This function prepares an empty de-duplication set. Nothing is
+        allocated afterwards: a set sized for 100000 tags with 12 bytes EPCs
+        can be built with CAENRFID_DEDUP_ID_LENGTH set to 12.
+*/
+CAENRFIDErrorCodes CAENRFID_DedupInit(CAENRFIDDedup* Dedup,
+                                      CAENRFIDDedupEntry* Entries,
+                                      uint32_t MaxEntries,
+                                      uint32_t* Slots,
+                                      uint32_t NumSlots,
+                                      uint16_t Flags,
+                                      uint32_t HoldOffMs,
+                                      uint32_t LostMs);
+
+/*
+    CAENRFID_DedupAdd.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in],[out]  Dedup    : The de-duplication set.
+        [in]        Tag      : A tag read.
+        [in]        Now      : The time of the read in milliseconds, from any
+                               monotonic clock (wrapping around is allowed).
+        [out]       Event    : The event caused by the read, if any.
+        [out]       has_event: Whether Event has been filled.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        This function records a read of Tag, reporting CAENRFID_DEDUP_NEW for
+        a tag not tracked yet and CAENRFID_DEDUP_MOVED for a tag read on 
+        another read point. Any other read is counted as suppressed.
+        CAENRFID_OutOfMemoryError is returned if all the entries are in use.
+*/
+CAENRFIDErrorCodes CAENRFID_DedupAdd(CAENRFIDDedup* Dedup,
+                                     const CAENRFIDTag* Tag,
+                                     uint32_t Now,
+                                     CAENRFIDDedupEvent* Event,
+                                     bool* has_event);
+
+/*
+    CAENRFID_DedupExpire.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in],[out]  Dedup    : The de-duplication set.
+        [in]        Now      : The current time, as passed to CAENRFID_DedupAdd.
+        [out]       Event    : The CAENRFID_DEDUP_LOST event, if any.
+        [out]       has_event: Whether Event has been filled.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        This function removes the least recently read tag if it has not been
+        read for LostMs, reporting it as lost. It should be called until
+        has_event is false, periodically and before CAENRFID_DedupAdd when
+        the set is full. Each call takes constant time.
+*/
+CAENRFIDErrorCodes CAENRFID_DedupExpire(CAENRFIDDedup* Dedup,
+                                        uint32_t Now,
+                                        CAENRFIDDedupEvent* Event,
+                                        bool* has_event);
+
+/*
+    CAENRFID_AsyncInit.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [out] async          : The non-blocking reader data structure.
+        [in]  reader         : The reader data structure that identifies the device.
+    -----------------------------------------------------------------------------
+    Returns:
+    -----------------------------------------------------------------------------
+    Description:
+        This function binds async to reader, which must have been connected
+        with CAENRFID_Connect. In non-blocking mode the library never calls
+        the reader tx and rx callbacks: the user sends the bytes returned by
+        CAENRFID_AsyncTxData and pushes the bytes received from the reader
+        with CAENRFID_AsyncFeed, so that many readers can be served by a single
+        poll/epoll loop.
+        The blocking functions must not be used on reader while a non-blocking
+        command is ongoing.
+*/
+void CAENRFID_AsyncInit(CAENRFIDAsync* async, CAENRFIDReader* reader);
+
+/*
+    CAENRFID_AsyncInventoryTag.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  async          : The non-blocking reader data structure.
+        [in]  SourceName     : The name that identifies the Logical Source.
+        [in]  Bank           : The bank where apply the mask.
+        [in]  MaskBitAddress : The position in bit from where starting to compare the mask 
+                               to the choosen bank.
+        [in]  MaskBitLength  : The length in bit of the significative part of the Mask.
+        [in]  Mask           : The array containing the Mask.
+        [in]  MaskLen        : The number of bytes passed in Mask.
+        [in]  flag           : A bitmask that indicates various options for the
+                               inventory, as in CAENRFID_InventoryTag.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        This function starts an inventory without waiting for it. The detected
+        tags are delivered through the tag callback, then inventory_end is 
+        called with the inventory result code. For a framed inventory, tags are
+        delivered as soon as they are received.
+        CAENRFID_ReaderBusy is returned if another command is ongoing.
+*/
+CAENRFIDErrorCodes CAENRFID_AsyncInventoryTag(CAENRFIDAsync* async,
+                                              char* SourceName,
+                                              uint16_t Bank,
+                                              uint16_t MaskBitAddress,
+                                              uint16_t MaskBitLength,
+                                              uint8_t* Mask,
+                                              uint16_t MaskLen,
+                                              uint16_t flag);
+
+/*
+    CAENRFID_AsyncSubmit.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  async          : The non-blocking reader data structure.
+        [in]  Frame          : A complete easy2read command, header included.
+        [in]  Len            : The number of bytes in Frame.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        This function starts a command encoded by the user. Frame is copied
+        and its header rewritten with the CmdID assigned by the library.
+        The reply is delivered through the reply callback.
+        Framed inventories must be started with CAENRFID_AsyncInventoryTag.
+*/
+CAENRFIDErrorCodes CAENRFID_AsyncSubmit(CAENRFIDAsync* async,
+                                        const uint8_t* Frame,
+                                        uint16_t Len);
+
+/*
+    CAENRFID_AsyncAbort.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  async          : The non-blocking reader data structure.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        This function requests the stop of an ongoing framed inventory: the abort
+        is sent through CAENRFID_AsyncTxData and the ending reported by the
+        inventory_end callback.
+*/
+CAENRFIDErrorCodes CAENRFID_AsyncAbort(CAENRFIDAsync* async);
+
+/*
+    CAENRFID_AsyncWantRead / CAENRFID_AsyncWantWrite.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  async          : The non-blocking reader data structure.
+    -----------------------------------------------------------------------------
+    Returns:
+        true if bytes are expected from the reader / are to be sent to the reader.
+    -----------------------------------------------------------------------------
+    Description:
+        These functions tell which events the reader port should be polled for.
+*/
+bool CAENRFID_AsyncWantRead(CAENRFIDAsync* async);
+bool CAENRFID_AsyncWantWrite(CAENRFIDAsync* async);
+
+/*
+    CAENRFID_AsyncTxData.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  async          : The non-blocking reader data structure.
+        [out] Data           : Points to the bytes to be sent to the reader.
+    -----------------------------------------------------------------------------
+    Returns:
+        The number of bytes to be sent.
+    -----------------------------------------------------------------------------
+    Description:
+        This function returns the pending command bytes. Once (part of) them
+        has been written to the reader port, CAENRFID_AsyncTxDone must be called
+        with the number of bytes written.
+*/
+uint16_t CAENRFID_AsyncTxData(CAENRFIDAsync* async, const uint8_t** Data);
+
+/*
+    CAENRFID_AsyncTxDone.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  async          : The non-blocking reader data structure.
+        [in]  Len            : The number of bytes written to the reader port.
+    -----------------------------------------------------------------------------
+    Returns:
+    -----------------------------------------------------------------------------
+    Description:
+        This function consumes Len bytes returned by CAENRFID_AsyncTxData.
+*/
+void CAENRFID_AsyncTxDone(CAENRFIDAsync* async, uint16_t Len);
+
+/*
+    CAENRFID_AsyncFeed.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  async          : The non-blocking reader data structure.
+        [in]  Data           : The bytes received from the reader port.
+        [in]  Len            : The number of bytes in Data.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        This function parses the bytes received from the reader, in chunks of 
+        any size, and calls the callbacks for every completed reply or tag.
+        Bytes received while no reply is expected are discarded.
+*/
+CAENRFIDErrorCodes CAENRFID_AsyncFeed(CAENRFIDAsync* async,
+                                      const uint8_t* Data,
+                                      uint32_t Len);
+
+/*
+    CAENRFID_AsyncTimeout.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  async          : The non-blocking reader data structure.
+    -----------------------------------------------------------------------------
+    Returns:
+    -----------------------------------------------------------------------------
+    Description:
+        This function must be called when the user gives up waiting for the 
+        reader: the ongoing command ends with CAENRFID_CommunicationTimeOut.
+        Note that during a framed continuous inventory the reader sends nothing
+        while no tag is detected.
+*/
+void CAENRFID_AsyncTimeout(CAENRFIDAsync* async);
+
+/*
+    CAENRFID_PipelineInit.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [out] pipe           : The pipeline data structure.
+        [in]  reader         : The reader data structure that identifies the device.
+        [in]  Window         : The maximum number of commands in flight, from 1
+                               to CAENRFID_PIPELINE_DEPTH.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        This function prepares a pipeline on reader, which must have been
+        connected with CAENRFID_Connect. Commands submitted to a pipeline are
+        sent without waiting for the reply to the previous ones, so that the
+        link round trip time is paid once per window instead of once per
+        command. Replies are matched to commands by CmdID and may come in any
+        order.
+        The blocking functions must not be used on reader while commands are
+        in flight.
+*/
+CAENRFIDErrorCodes CAENRFID_PipelineInit(CAENRFIDPipeline* pipe,
+                                         CAENRFIDReader* reader,
+                                         uint16_t Window);
+
+/*
+    CAENRFID_PipelineReadTagData.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  pipe           : The pipeline data structure.
+        [in]  Tag            : The tag to be read.
+        [in]  Bank           : The memory bank where to read the data.
+        [in]  ByteAddress    : The address of the first byte to be read.
+        [in]  ByteLength     : The number of bytes to be read.
+        [out] Data           : Receives the data read, when the command completes.
+                               Must stay valid until then.
+        [in]  AccessPassword : The access password (0 if not needed).
+        [out] Handle         : Identifies the command in CAENRFID_PipelineWait.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        This function sends a CAENRFID_ReadTagData_EPC_C1G2 command without 
+        waiting for its reply. CAENRFID_ReaderBusy is returned if the window
+        is full: completed commands must be collected with
+        CAENRFID_PipelineWait first.
+*/
+CAENRFIDErrorCodes CAENRFID_PipelineReadTagData(CAENRFIDPipeline* pipe,
+                                                CAENRFIDTag* Tag,
+                                                uint16_t Bank,
+                                                uint16_t ByteAddress,
+                                                uint16_t ByteLength,
+                                                uint8_t* Data,
+                                                uint32_t AccessPassword,
+                                                uint16_t* Handle);
+
+/*
+    CAENRFID_PipelineWriteTagData.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  pipe           : The pipeline data structure.
+        [in]  Tag            : The tag to be written.
+        [in]  Bank           : The memory bank where to write the data.
+        [in]  ByteAddress    : The address of the first byte to be written.
+        [in]  ByteLength     : The number of bytes to be written.
+        [in]  Data           : The data to be written.
+        [in]  AccessPassword : The access password (0 if not needed).
+        [out] Handle         : Identifies the command in CAENRFID_PipelineWait.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        This function sends a CAENRFID_WriteTagData_EPC_C1G2 command without 
+        waiting for its reply, see CAENRFID_PipelineReadTagData.
+*/
+CAENRFIDErrorCodes CAENRFID_PipelineWriteTagData(CAENRFIDPipeline* pipe,
+                                                 CAENRFIDTag* Tag,
+                                                 uint16_t Bank,
+                                                 uint16_t ByteAddress,
+                                                 uint16_t ByteLength,
+                                                 uint8_t* Data,
+                                                 uint32_t AccessPassword,
+                                                 uint16_t* Handle);
+
+/*
+    CAENRFID_PipelineSubmit.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  pipe           : The pipeline data structure.
+        [in]  Frame          : A complete easy2read command, header included.
+        [in]  Len            : The number of bytes in Frame.
+        [out] Reply          : Receives the reply, header included, when the
+                               command completes. Must stay valid until then.
+        [in]  ReplySize      : The size of Reply.
+        [out] ReplyLen       : Receives the length of the reply.
+        [out] Handle         : Identifies the command in CAENRFID_PipelineWait.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        This function sends a command encoded by the user without waiting for
+        its reply. Frame header is rewritten with the CmdID assigned by the
+        library. Inventories can't be pipelined.
+*/
+CAENRFIDErrorCodes CAENRFID_PipelineSubmit(CAENRFIDPipeline* pipe,
+                                           const uint8_t* Frame,
+                                           uint16_t Len,
+                                           uint8_t* Reply,
+                                           uint16_t ReplySize,
+                                           uint16_t* ReplyLen,
+                                           uint16_t* Handle);
+
+/*
+    CAENRFID_PipelineWait.
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  pipe           : The pipeline data structure.
+        [out] Handle         : The handle of the completed command.
+        [out] Result         : The result of the completed command.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+        CAENRFID_EOF is returned if no command is in flight.
+    -----------------------------------------------------------------------------
+    Description:
+        This function returns a completed command, receiving replies as 
+        needed. The slot of the returned command becomes free for a new one.
+        If the connection fails, all the commands in flight complete with the
+        communication error.
+*/
+CAENRFIDErrorCodes CAENRFID_PipelineWait(CAENRFIDPipeline* pipe,
+                                         uint16_t* Handle,
+                                         CAENRFIDErrorCodes* Result);
+
+#endif /* SRC_LIB_CAENRFIDLIB_LIGHT_H_ */
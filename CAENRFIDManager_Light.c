@@ -0,0 +1,329 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2022, CAEN RFID S.R.L.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of CAEN RFID S.R.L. nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "CAENRFIDManager_Light.h"
+#include "CAENRFIDLib_Light.h"
+
+#ifdef CAENRFID_MANAGER_SUPPORTED
+
+#define MANAGER_RETRY_MSEC (100)
+#define MANAGER_POLL_USEC  (500)
+
+typedef struct CAENRFIDManagerEntry_s {
+    CAENRFIDManagerTag  Tag;
+    uint64_t            Arrival;    // host time in ms
+} ManagerEntry_t;
+
+// queue element: Seq tells whether the slot holds an entry for the
+// current lap (Seq == position + 1) or is free (Seq == position)
+typedef struct CAENRFIDManagerSlot_s {
+    uint32_t            Seq;
+    ManagerEntry_t      Entry;
+} ManagerSlot_t;
+
+typedef struct CAENRFIDManagerWorker_s {
+    CAENRFIDManager*    mgr;
+    uint16_t            index;
+    pthread_t           thread;
+    bool                started;
+    CAENRFIDErrorCodes  last_error;
+    uint32_t            tags;
+    uint32_t            dropped;
+} ManagerWorker_t;
+
+static uint64_t nowMs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+
+static void sleepUs(uint32_t us)
+{
+    struct timespec ts;
+
+    ts.tv_sec = us / 1000000;
+    ts.tv_nsec = (long)(us % 1000000) * 1000;
+    nanosleep(&ts, NULL);
+}
+
+/*
+    Bounded multi producer / single consumer queue: producers reserve a
+    position with a CAS on _tail, the consumer owns _head.
+*/
+static bool queuePush(CAENRFIDManager* mgr, const ManagerEntry_t* entry)
+{
+    ManagerSlot_t* slot;
+    uint32_t pos, seq;
+    int32_t diff;
+
+    pos = __atomic_load_n(&mgr->_tail, __ATOMIC_RELAXED);
+    while(1)
+    {
+        slot = &mgr->_slots[pos & mgr->_mask];
+        seq = __atomic_load_n(&slot->Seq, __ATOMIC_ACQUIRE);
+        diff = (int32_t)(seq - pos);
+        if(diff == 0)
+        {
+            if(__atomic_compare_exchange_n(&mgr->_tail, &pos, pos + 1, true,
+                                           __ATOMIC_RELAXED, __ATOMIC_RELAXED)) break;
+        }
+        else if(diff < 0)
+        {
+            //the consumer did not free this slot yet: full
+            return false;
+        }
+        else
+        {
+            pos = __atomic_load_n(&mgr->_tail, __ATOMIC_RELAXED);
+        }
+    }
+    slot->Entry = *entry;
+    __atomic_store_n(&slot->Seq, pos + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+static bool queuePop(CAENRFIDManager* mgr, ManagerEntry_t* entry)
+{
+    ManagerSlot_t* slot = &mgr->_slots[mgr->_head & mgr->_mask];
+    uint32_t seq = __atomic_load_n(&slot->Seq, __ATOMIC_ACQUIRE);
+
+    if(seq != mgr->_head + 1) return false;
+    *entry = slot->Entry;
+    __atomic_store_n(&slot->Seq, mgr->_head + mgr->_mask + 1, __ATOMIC_RELEASE);
+    mgr->_head++;
+    return true;
+}
+
+/*
+    Reorder window: binary min-heap on the tag TimeStamp
+*/
+static bool entryBefore(const ManagerEntry_t* a, const ManagerEntry_t* b)
+{
+    if(a->Tag.Tag.TimeStamp[0] != b->Tag.Tag.TimeStamp[0]) return a->Tag.Tag.TimeStamp[0] < b->Tag.Tag.TimeStamp[0];
+    if(a->Tag.Tag.TimeStamp[1] != b->Tag.Tag.TimeStamp[1]) return a->Tag.Tag.TimeStamp[1] < b->Tag.Tag.TimeStamp[1];
+    return a->Arrival < b->Arrival;
+}
+
+static void heapPush(CAENRFIDManager* mgr, const ManagerEntry_t* entry)
+{
+    ManagerEntry_t* heap = mgr->_heap;
+    uint16_t i = mgr->_heap_len++, parent;
+
+    while(i > 0)
+    {
+        parent = (i - 1) / 2;
+        if(!entryBefore(entry, &heap[parent])) break;
+        heap[i] = heap[parent];
+        i = parent;
+    }
+    heap[i] = *entry;
+}
+
+static void heapPop(CAENRFIDManager* mgr, ManagerEntry_t* entry)
+{
+    ManagerEntry_t* heap = mgr->_heap;
+    ManagerEntry_t* last;
+    uint16_t i = 0, child;
+
+    *entry = heap[0];
+    last = &heap[--mgr->_heap_len];
+    while((child = 2 * i + 1) < mgr->_heap_len)
+    {
+        if((child + 1 < mgr->_heap_len) && entryBefore(&heap[child + 1], &heap[child])) child++;
+        if(!entryBefore(&heap[child], last)) break;
+        heap[i] = heap[child];
+        i = child;
+    }
+    heap[i] = *last;
+}
+
+static void* managerWorker(void* arg)
+{
+    ManagerWorker_t* worker = (ManagerWorker_t*) arg;
+    CAENRFIDManager* mgr = worker->mgr;
+    CAENRFIDReader* reader = mgr->Readers[worker->index];
+    CAENRFIDErrorCodes ret;
+    ManagerEntry_t entry;
+    bool has_tag, has_result_code, aborted;
+
+    memset(&entry, 0, sizeof(entry));
+    entry.Tag.Reader = worker->index;
+    while(__atomic_load_n(&mgr->_running, __ATOMIC_ACQUIRE))
+    {
+        ret = CAENRFID_InventoryTag(reader, mgr->SourceName, 0, 0, 0, NULL, 0,
+                                    mgr->Flag | FRAMED | CONTINUOS, NULL, NULL);
+        if(ret != CAENRFID_StatusOK)
+        {
+            __atomic_store_n(&worker->last_error, ret, __ATOMIC_RELAXED);
+            sleepUs(MANAGER_RETRY_MSEC * 1000);
+            continue;
+        }
+        aborted = false;
+        do
+        {
+            if(!aborted && !__atomic_load_n(&mgr->_running, __ATOMIC_ACQUIRE))
+            {
+                CAENRFID_InventoryAbort(reader);
+                aborted = true;
+            }
+            ret = CAENRFID_GetFramedTag(reader, &has_tag, &entry.Tag.Tag, &has_result_code);
+            if(has_tag)
+            {
+                entry.Arrival = nowMs();
+                __atomic_add_fetch(&worker->tags, 1, __ATOMIC_RELAXED);
+                if(!queuePush(mgr, &entry)) __atomic_add_fetch(&worker->dropped, 1, __ATOMIC_RELAXED);
+            }
+            //a reader not answering the abort is left behind
+            else if(aborted && !has_result_code) break;
+        } while(!has_result_code && (ret == CAENRFID_StatusOK));
+        if(ret != CAENRFID_StatusOK) __atomic_store_n(&worker->last_error, ret, __ATOMIC_RELAXED);
+    }
+    return NULL;
+}
+
+CAENRFIDErrorCodes CAENRFID_ManagerStart(CAENRFIDManager* mgr)
+{
+    uint32_t size = 1, i;
+
+    if((mgr->NumReaders == 0) || (mgr->Readers == NULL) || (mgr->SourceName == NULL)) return CAENRFID_InvalidParam;
+    //the size is rounded up to a power of 2, which must fit in 32 bits
+    if(mgr->QueueSize > 0x80000000UL) return CAENRFID_InvalidParam;
+    //already started, CAENRFID_ManagerStop must be called first
+    if(mgr->_workers != NULL) return CAENRFID_ReaderBusy;
+    while(size < mgr->QueueSize) size <<= 1;
+    mgr->_mask = size - 1;
+    mgr->_head = 0;
+    mgr->_tail = 0;
+    mgr->_heap_len = 0;
+    mgr->_heap_size = (mgr->ReorderDepth > 0) ? mgr->ReorderDepth : 1;
+    mgr->_slots = malloc(size * sizeof(ManagerSlot_t));
+    mgr->_heap = malloc(mgr->_heap_size * sizeof(ManagerEntry_t));
+    mgr->_workers = calloc(mgr->NumReaders, sizeof(ManagerWorker_t));
+    if((mgr->_slots == NULL) || (mgr->_heap == NULL) || (mgr->_workers == NULL))
+    {
+        free(mgr->_slots);
+        free(mgr->_heap);
+        free(mgr->_workers);
+        mgr->_slots = NULL;
+        mgr->_heap = NULL;
+        mgr->_workers = NULL;
+        return CAENRFID_OutOfMemoryError;
+    }
+    for(i = 0; i < size; i++) mgr->_slots[i].Seq = i;
+    mgr->_running = true;
+    for(i = 0; i < mgr->NumReaders; i++)
+    {
+        mgr->_workers[i].mgr = mgr;
+        mgr->_workers[i].index = (uint16_t) i;
+        mgr->_workers[i].last_error = CAENRFID_StatusOK;
+        if(pthread_create(&mgr->_workers[i].thread, NULL, managerWorker, &mgr->_workers[i]) != 0)
+        {
+            CAENRFID_ManagerStop(mgr);
+            return CAENRFID_GenericError;
+        }
+        mgr->_workers[i].started = true;
+    }
+    return CAENRFID_StatusOK;
+}
+
+CAENRFIDErrorCodes CAENRFID_ManagerGetTag(CAENRFIDManager* mgr,
+                                          bool* has_tag,
+                                          CAENRFIDManagerTag* Tag,
+                                          uint32_t ms_timeout)
+{
+    ManagerEntry_t entry;
+    uint64_t now = nowMs(), deadline = now + ms_timeout;
+    uint32_t hold = (mgr->ReorderDepth > 0) ? mgr->ReorderMs : 0;
+
+    *has_tag = false;
+    if(mgr->_workers == NULL) return CAENRFID_InvalidParam;
+    while(1)
+    {
+        while((mgr->_heap_len < mgr->_heap_size) && queuePop(mgr, &entry)) heapPush(mgr, &entry);
+        //the oldest tag leaves when the window is full or it waited long enough
+        if((mgr->_heap_len == mgr->_heap_size) ||
+           ((mgr->_heap_len > 0) && (now >= mgr->_heap[0].Arrival + hold)))
+        {
+            heapPop(mgr, &entry);
+            *Tag = entry.Tag;
+            *has_tag = true;
+            return CAENRFID_StatusOK;
+        }
+        if(now >= deadline) return CAENRFID_StatusOK;
+        sleepUs(MANAGER_POLL_USEC);
+        now = nowMs();
+    }
+}
+
+CAENRFIDErrorCodes CAENRFID_ManagerGetStats(CAENRFIDManager* mgr,
+                                            uint16_t Reader,
+                                            CAENRFIDErrorCodes* LastError,
+                                            uint32_t* Tags,
+                                            uint32_t* Dropped)
+{
+    ManagerWorker_t* worker;
+
+    if((mgr->_workers == NULL) || (Reader >= mgr->NumReaders)) return CAENRFID_InvalidParam;
+    worker = &mgr->_workers[Reader];
+    *LastError = __atomic_load_n(&worker->last_error, __ATOMIC_RELAXED);
+    *Tags = __atomic_load_n(&worker->tags, __ATOMIC_RELAXED);
+    *Dropped = __atomic_load_n(&worker->dropped, __ATOMIC_RELAXED);
+    return CAENRFID_StatusOK;
+}
+
+CAENRFIDErrorCodes CAENRFID_ManagerStop(CAENRFIDManager* mgr)
+{
+    uint16_t i;
+
+    if(mgr->_workers == NULL) return CAENRFID_InvalidParam;
+    __atomic_store_n(&mgr->_running, false, __ATOMIC_RELEASE);
+    for(i = 0; i < mgr->NumReaders; i++)
+    {
+        if(mgr->_workers[i].started) pthread_join(mgr->_workers[i].thread, NULL);
+    }
+    free(mgr->_slots);
+    free(mgr->_heap);
+    free(mgr->_workers);
+    mgr->_slots = NULL;
+    mgr->_heap = NULL;
+    mgr->_workers = NULL;
+    return CAENRFID_StatusOK;
+}
+
+#endif /* CAENRFID_MANAGER_SUPPORTED */
@@ -0,0 +1,176 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2022, CAEN RFID S.R.L.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of CAEN RFID S.R.L. nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+
+#ifndef SRC_LIB_CAENRFIDMANAGER_LIGHT_H_
+#define SRC_LIB_CAENRFIDMANAGER_LIGHT_H_
+
+#include "CAENRFIDTypes_Light.h"
+
+/*
+    The manager runs one thread per reader: it is available on POSIX hosts only.
+*/
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(CAENRFID_NO_HEAP)
+#define CAENRFID_MANAGER_SUPPORTED
+#endif
+
+#ifdef CAENRFID_MANAGER_SUPPORTED
+
+#include <pthread.h>
+
+/*
+    Tag of the merged stream
+*/
+typedef struct CAENRFIDManagerTag_s {
+    CAENRFIDTag         Tag;
+    uint16_t            Reader;     // index of the reader in CAENRFIDManager.Readers
+} CAENRFIDManagerTag;
+
+/*
+    Manager Struct
+
+    User should zero the whole struct (e.g. with memset) and then initialize
+    the following fields before calling CAENRFID_ManagerStart:
+    - Readers, NumReaders : the connected readers to be run.
+    - SourceName          : the logical source used on every reader.
+    - Flag                : inventory options as in CAENRFID_InventoryTag
+                            (RSSI, TID_READING, ...). FRAMED and CONTINUOS
+                            are always added.
+    - QueueSize           : number of tags the queue can hold, rounded up
+                            to a power of two. At most 2^31. When the
+                            queue is full, new tags are dropped and counted.
+    - ReorderDepth        : number of tags held back to be sorted by
+                            TimeStamp. 0 delivers tags in arrival order.
+    - ReorderMs           : maximum time in milliseconds a tag is held back.
+
+    User should NOT modify the fields starting with an underscore.
+*/
+typedef struct CAENRFIDManager_s {
+    CAENRFIDReader**    Readers;
+    uint16_t            NumReaders;
+    char*               SourceName;
+    uint16_t            Flag;
+    uint32_t            QueueSize;
+    uint16_t            ReorderDepth;
+    uint32_t            ReorderMs;
+
+    struct CAENRFIDManagerSlot_s*   _slots;
+    uint32_t                        _mask;
+    uint32_t                        _tail;
+    uint32_t                        _head;
+    struct CAENRFIDManagerEntry_s*  _heap;
+    uint16_t                        _heap_len;
+    uint16_t                        _heap_size;
+    struct CAENRFIDManagerWorker_s* _workers;
+    bool                            _running;
+} CAENRFIDManager;
+
+/*
+    CAENRFID_ManagerStart
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in],[out]  mgr      : The manager, with its configuration fields set.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        Starts a worker thread per reader, running a framed continuous
+        inventory and pushing the detected tags to a lock-free queue shared
+        by all readers. An inventory ending (e.g. because of the read cycle
+        configured on the logical source) is restarted.
+        The readers must not be used by the application until
+        CAENRFID_ManagerStop returns.
+        Returns CAENRFID_ReaderBusy if the manager is already started.
+*/
+CAENRFIDErrorCodes CAENRFID_ManagerStart(CAENRFIDManager* mgr);
+
+/*
+    CAENRFID_ManagerGetTag
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  mgr            : The manager.
+        [out] has_tag        : Tells whether a tag was returned or not.
+        [out] Tag            : The next tag of the merged stream.
+        [in]  ms_timeout     : The maximum time in milliseconds to wait for a tag.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        Returns the tags detected by all the readers, ordered by TimeStamp
+        within the reorder window. The readers clocks should be kept in sync
+        for the order to be meaningful across readers.
+        Must be called by a single thread.
+*/
+CAENRFIDErrorCodes CAENRFID_ManagerGetTag(CAENRFIDManager* mgr,
+                                          bool* has_tag,
+                                          CAENRFIDManagerTag* Tag,
+                                          uint32_t ms_timeout);
+
+/*
+    CAENRFID_ManagerGetStats
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in]  mgr            : The manager.
+        [in]  Reader         : The index of the reader in mgr->Readers.
+        [out] LastError      : The last error returned by the reader, if any.
+        [out] Tags           : The number of tags received from the reader.
+        [out] Dropped        : The number of tags dropped because the queue was full.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+*/
+CAENRFIDErrorCodes CAENRFID_ManagerGetStats(CAENRFIDManager* mgr,
+                                            uint16_t Reader,
+                                            CAENRFIDErrorCodes* LastError,
+                                            uint32_t* Tags,
+                                            uint32_t* Dropped);
+
+/*
+    CAENRFID_ManagerStop
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in],[out]  mgr      : The manager.
+    -----------------------------------------------------------------------------
+    Returns:
+        An error code about the execution of the function.
+    -----------------------------------------------------------------------------
+    Description:
+        Aborts the inventories, waits for the worker threads to exit and
+        releases the manager resources. Tags not retrieved yet are discarded.
+*/
+CAENRFIDErrorCodes CAENRFID_ManagerStop(CAENRFIDManager* mgr);
+
+#endif /* CAENRFID_MANAGER_SUPPORTED */
+
+#endif /* SRC_LIB_CAENRFIDMANAGER_LIGHT_H_ */
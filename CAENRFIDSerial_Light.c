@@ -0,0 +1,290 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2022, CAEN RFID S.R.L.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of CAEN RFID S.R.L. nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+
+#define _DEFAULT_SOURCE
+
+#include "CAENRFIDSerial_Light.h"
+
+#ifdef CAENRFID_SERIAL_SUPPORTED
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/serial.h>
+
+#define SERIAL_DEFAULT_BAUDRATE (921600)
+
+static const struct {
+    uint32_t    rate;
+    speed_t     speed;
+} serialSpeeds[] = {
+    {9600, B9600}, {19200, B19200}, {38400, B38400}, {57600, B57600},
+    {115200, B115200}, {230400, B230400}, {460800, B460800}, {921600, B921600},
+};
+
+static uint64_t serialNowMs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+
+// waits for the tty to be readable (POLLIN) or writable (POLLOUT)
+// returns 1 when ready, 0 on timeout, -1 on error
+static int16_t serialWait(int fd, short events, uint64_t deadline)
+{
+    struct pollfd pfd;
+    uint64_t now;
+    int n;
+
+    pfd.fd = fd;
+    pfd.events = events;
+    while(1)
+    {
+        now = serialNowMs();
+        pfd.revents = 0;
+        n = poll(&pfd, 1, (now < deadline) ? (int)(deadline - now) : 0);
+        if(n > 0)
+        {
+            if(pfd.revents & (POLLERR | POLLNVAL)) return (-1);
+            //a hung up tty may still hold unread bytes
+            if(!(pfd.revents & events) && (pfd.revents & POLLHUP)) return (-1);
+            return (1);
+        }
+        if(n == 0) return (0);
+        if(errno != EINTR) return (-1);
+    }
+}
+
+static int16_t serialSetup(int fd, const CAENRFIDSerialParams* params)
+{
+    struct termios tio;
+    struct serial_struct ss;
+    uint32_t rate = (params->BaudRate != 0) ? params->BaudRate : SERIAL_DEFAULT_BAUDRATE;
+    speed_t speed = B0;
+    size_t i;
+
+    for(i = 0; i < sizeof(serialSpeeds) / sizeof(serialSpeeds[0]); i++)
+    {
+        if(serialSpeeds[i].rate == rate) speed = serialSpeeds[i].speed;
+    }
+    if(speed == B0) return (-1);
+    if(tcgetattr(fd, &tio) != 0) return (-1);
+    cfmakeraw(&tio);
+    cfsetispeed(&tio, speed);
+    cfsetospeed(&tio, speed);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cflag &= ~(CSIZE | CSTOPB | PARENB | PARODD | CRTSCTS);
+    switch(params->DataBits)
+    {
+    case 5: tio.c_cflag |= CS5; break;
+    case 6: tio.c_cflag |= CS6; break;
+    case 7: tio.c_cflag |= CS7; break;
+    case 0:
+    case 8: tio.c_cflag |= CS8; break;
+    default: return (-1);
+    }
+    if(params->StopBits == 2) tio.c_cflag |= CSTOPB;
+    if(params->Parity == CAENRS232_Parity_Odd) tio.c_cflag |= PARENB | PARODD;
+    else if(params->Parity == CAENRS232_Parity_Even) tio.c_cflag |= PARENB;
+    tio.c_iflag &= ~(IXON | IXOFF | IXANY);
+    if(params->FlowControl == CAENRFID_RS232_FlowControl_Hardware) tio.c_cflag |= CRTSCTS;
+    else if(params->FlowControl == CAENRFID_RS232_FlowControl_XonXoff) tio.c_iflag |= IXON | IXOFF;
+    //reads never block in the driver, waiting is left to poll()
+    tio.c_cc[VMIN] = 0;
+    tio.c_cc[VTIME] = 0;
+    if(tcsetattr(fd, TCSANOW, &tio) != 0) return (-1);
+    //drivers without a latency timer (ptys, CDC ACM) do not support it
+    if(ioctl(fd, TIOCGSERIAL, &ss) == 0)
+    {
+        ss.flags |= ASYNC_LOW_LATENCY;
+        (void) ioctl(fd, TIOCSSERIAL, &ss);
+    }
+    tcflush(fd, TCIOFLUSH);
+    return (0);
+}
+
+static int16_t serial_connect(void* *port_handle, int16_t port_type, void* port_params)
+{
+    CAENRFIDSerialPort* port = (CAENRFIDSerialPort*) *port_handle;
+    const CAENRFIDSerialParams* params = (const CAENRFIDSerialParams*) port_params;
+
+    if((port == NULL) || (params == NULL) || (params->Device == NULL)) return (-1);
+    if(port_type != CAENRFID_RS232 && port_type != CAENRFID_USB) return (-1);
+    //a port connected again is closed first
+    if(port->_fd >= 0) close(port->_fd);
+    port->_fd = -1;
+    port->_rpos = port->_wpos = 0;
+    if((port->_fd = open(params->Device, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC)) < 0) return (-1);
+    if(serialSetup(port->_fd, params) != 0)
+    {
+        close(port->_fd);
+        port->_fd = -1;
+        return (-1);
+    }
+    return (0);
+}
+
+static int16_t serial_disconnect(void* port_handle)
+{
+    CAENRFIDSerialPort* port = (CAENRFIDSerialPort*) port_handle;
+    int fd = port->_fd;
+
+    port->_fd = -1;
+    if(fd < 0) return (0);
+    return (close(fd) == 0) ? 0 : -1;
+}
+
+static int16_t serial_tx(void* port_handle, uint8_t* data, uint32_t len)
+{
+    CAENRFIDSerialPort* port = (CAENRFIDSerialPort*) port_handle;
+    uint64_t deadline = serialNowMs() + CAENRFID_SERIAL_TX_MSEC_TMO;
+    ssize_t n;
+
+    while(len > 0)
+    {
+        n = write(port->_fd, data, len);
+        if(n > 0)
+        {
+            data += n;
+            len -= (uint32_t) n;
+        }
+        else if((n < 0) && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            if(serialWait(port->_fd, POLLOUT, deadline) <= 0) return (-1);
+        }
+        else if((n < 0) && (errno == EINTR))
+        {
+            continue;
+        }
+        else
+        {
+            return (-1);
+        }
+    }
+    return (0);
+}
+
+// reads what the tty holds, up to maxlen bytes, into data
+// returns the number of bytes read, 0 on timeout, -1 on error
+static int32_t serialRead(CAENRFIDSerialPort* port, uint8_t* data, uint32_t maxlen, uint64_t deadline)
+{
+    ssize_t n;
+    int16_t tmp;
+
+    while(1)
+    {
+        n = read(port->_fd, data, maxlen);
+        if(n > 0) return (int32_t) n;
+        if((n < 0) && (errno == EINTR)) continue;
+        if((n < 0) && (errno != EAGAIN) && (errno != EWOULDBLOCK)) return (-1);
+        //n == 0 with VMIN == 0 just means no data
+        if((tmp = serialWait(port->_fd, POLLIN, deadline)) <= 0) return (tmp);
+    }
+}
+
+static int32_t serial_rx_some(void* port_handle, uint8_t* data, uint32_t maxlen, uint32_t ms_timeout)
+{
+    CAENRFIDSerialPort* port = (CAENRFIDSerialPort*) port_handle;
+    uint32_t n;
+    int32_t got;
+
+    if(port->_rpos == port->_wpos)
+    {
+        //nothing buffered: large requests are read straight into data
+        if(maxlen >= sizeof(port->_buffer))
+        {
+            return serialRead(port, data, maxlen, serialNowMs() + ms_timeout);
+        }
+        port->_rpos = port->_wpos = 0;
+        got = serialRead(port, port->_buffer, sizeof(port->_buffer), serialNowMs() + ms_timeout);
+        if(got <= 0) return (got);
+        port->_wpos = (uint32_t) got;
+    }
+    n = port->_wpos - port->_rpos;
+    if(n > maxlen) n = maxlen;
+    memcpy(data, &port->_buffer[port->_rpos], n);
+    port->_rpos += n;
+    return (int32_t) n;
+}
+
+static int16_t serial_rx(void* port_handle, uint8_t* data, uint32_t len, uint32_t ms_timeout)
+{
+    uint64_t deadline = serialNowMs() + ms_timeout;
+    uint64_t now;
+    int32_t n;
+
+    while(len > 0)
+    {
+        now = serialNowMs();
+        n = serial_rx_some(port_handle, data, len, (now < deadline) ? (uint32_t)(deadline - now) : 0);
+        if(n <= 0) return (-1);
+        data += n;
+        len -= (uint32_t) n;
+    }
+    return (0);
+}
+
+static int16_t serial_clear_rx_data(void* port_handle)
+{
+    CAENRFIDSerialPort* port = (CAENRFIDSerialPort*) port_handle;
+
+    port->_rpos = port->_wpos = 0;
+    return (tcflush(port->_fd, TCIFLUSH) == 0) ? 0 : -1;
+}
+
+static void serial_irqs(void)
+{
+}
+
+void CAENRFID_SerialAttach(CAENRFIDReader* reader, CAENRFIDSerialPort* port)
+{
+    port->_fd = -1;
+    port->_rpos = port->_wpos = 0;
+    reader->_port_handle = port;
+    reader->connect = serial_connect;
+    reader->disconnect = serial_disconnect;
+    reader->tx = serial_tx;
+    reader->rx = serial_rx;
+    reader->rx_some = serial_rx_some;
+    reader->clear_rx_data = serial_clear_rx_data;
+    reader->enable_irqs = serial_irqs;
+    reader->disable_irqs = serial_irqs;
+}
+
+#endif /* CAENRFID_SERIAL_SUPPORTED */
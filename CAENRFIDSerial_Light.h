@@ -0,0 +1,112 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2022, CAEN RFID S.R.L.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of CAEN RFID S.R.L. nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+
+#ifndef SRC_LIB_CAENRFIDSERIAL_LIGHT_H_
+#define SRC_LIB_CAENRFIDSERIAL_LIGHT_H_
+
+#include "CAENRFIDTypes_Light.h"
+
+/*
+    The serial backend is built on termios: it is available on Linux hosts only.
+*/
+#if defined(__linux__)
+#define CAENRFID_SERIAL_SUPPORTED
+#endif
+
+#ifdef CAENRFID_SERIAL_SUPPORTED
+
+#ifndef CAENRFID_SERIAL_BUFFER_SIZE
+#define CAENRFID_SERIAL_BUFFER_SIZE             4096
+#endif
+#ifndef CAENRFID_SERIAL_TX_MSEC_TMO
+#define CAENRFID_SERIAL_TX_MSEC_TMO             1000
+#endif
+
+/*
+    Serial Port Parameters, to be passed as PortParams to CAENRFID_Connect
+
+    - Device      : the tty the reader is attached to, e.g. "/dev/ttyACM0".
+    - BaudRate    : the baudrate, 0 for 921600.
+    - DataBits    : 5 to 8, 0 for 8.
+    - StopBits    : 1 or 2, 0 for 1.
+    - Parity      : the parity.
+    - FlowControl : the flow control.
+*/
+typedef struct CAENRFIDSerialParams_s {
+    const char*                 Device;
+    uint32_t                    BaudRate;
+    uint8_t                     DataBits;
+    uint8_t                     StopBits;
+    CAENRFID_RS232_Parity       Parity;
+    CAENRFID_RS232_FlowControl  FlowControl;
+} CAENRFIDSerialParams;
+
+/*
+    Serial Port Struct
+
+    Holds the open tty and the bytes read from it but not yet requested:
+    the port is read in chunks of up to CAENRFID_SERIAL_BUFFER_SIZE bytes
+    whatever the length asked by the library.
+
+    User should NOT modify the fields starting with an underscore.
+*/
+typedef struct CAENRFIDSerialPort_s {
+    int                 _fd;
+    uint32_t            _rpos;
+    uint32_t            _wpos;
+    uint8_t             _buffer[CAENRFID_SERIAL_BUFFER_SIZE];
+} CAENRFIDSerialPort;
+
+/*
+    CAENRFID_SerialAttach
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in],[out]  reader     : The reader data structure to be bound to the port.
+        [in]        port       : The serial port, owned by the caller for as
+                                 long as the reader is connected.
+    -----------------------------------------------------------------------------
+    Returns:
+    -----------------------------------------------------------------------------
+    Description:
+        Fills the reader callbacks so that the reader is driven through a
+        Linux tty. The tty is opened by CAENRFID_Connect, called afterwards
+        with a CAENRFIDSerialParams as PortParams, and closed by
+        CAENRFID_Disconnect.
+        The tty is set to raw mode, with ASYNC_LOW_LATENCY requested to the
+        driver where supported (e.g. FTDI adapters), and is read through
+        poll() so that reads return as soon as data is available.
+*/
+void CAENRFID_SerialAttach(CAENRFIDReader* reader, CAENRFIDSerialPort* port);
+
+#endif /* CAENRFID_SERIAL_SUPPORTED */
+
+#endif /* SRC_LIB_CAENRFIDSERIAL_LIGHT_H_ */
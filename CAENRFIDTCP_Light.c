@@ -0,0 +1,438 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2022, CAEN RFID S.R.L.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of CAEN RFID S.R.L. nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+
+#define _POSIX_C_SOURCE 200809L
+#define _DEFAULT_SOURCE
+
+#include "CAENRFIDTCP_Light.h"
+
+#ifdef CAENRFID_TCP_SUPPORTED
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL            (0)
+#endif
+
+#define TCP_DEFAULT_PORT        (1000)
+#define TCP_DEFAULT_CONNECT_MS  (1000)
+#define TCP_DEFAULT_KEEPALIVE   (5)
+#define TCP_KEEPALIVE_INTERVAL  (1)
+#define TCP_KEEPALIVE_PROBES    (3)
+#define TCP_RETRY_MSEC          (10)
+
+static uint64_t tcpNowMs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+
+static void tcpSleepMs(uint32_t ms)
+{
+    struct timespec ts;
+
+    ts.tv_sec = ms / 1000;
+    ts.tv_nsec = (long)(ms % 1000) * 1000000L;
+    nanosleep(&ts, NULL);
+}
+
+// waits for the socket to be readable (POLLIN) or writable (POLLOUT)
+// returns 1 when ready, 0 on timeout, -1 on error
+static int16_t tcpWait(int fd, short events, uint64_t deadline)
+{
+    struct pollfd pfd;
+    uint64_t now;
+    int n;
+
+    pfd.fd = fd;
+    pfd.events = events;
+    while(1)
+    {
+        now = tcpNowMs();
+        pfd.revents = 0;
+        n = poll(&pfd, 1, (now < deadline) ? (int)(deadline - now) : 0);
+        if(n > 0)
+        {
+            if(pfd.revents & POLLNVAL) return (-1);
+            //errors and hang ups are reported by the following send/recv
+            return (1);
+        }
+        if(n == 0) return (0);
+        if(errno != EINTR) return (-1);
+    }
+}
+
+static void tcpClose(CAENRFIDTCPPort* port)
+{
+    if(port->_fd >= 0) close(port->_fd);
+    port->_fd = -1;
+    port->_rpos = port->_wpos = 0;
+}
+
+// opens a connection to the resolved address, giving up after ConnectMs
+static int16_t tcpOpen(CAENRFIDTCPPort* port)
+{
+    int fd, one = 1, err = 0, value;
+    socklen_t len = sizeof(err);
+
+    tcpClose(port);
+    if((fd = socket(port->_addr.ss_family, SOCK_STREAM, 0)) < 0) return (-1);
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    //commands are small and latency bound, never wait to fill a segment
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    setsockopt(fd, SOL_SOCKET, SO_KEEPALIVE, &one, sizeof(one));
+#ifdef TCP_KEEPIDLE
+    value = port->_params.KeepAliveSec;
+    setsockopt(fd, IPPROTO_TCP, TCP_KEEPIDLE, &value, sizeof(value));
+#endif
+#ifdef TCP_KEEPINTVL
+    value = TCP_KEEPALIVE_INTERVAL;
+    setsockopt(fd, IPPROTO_TCP, TCP_KEEPINTVL, &value, sizeof(value));
+#endif
+#ifdef TCP_KEEPCNT
+    value = TCP_KEEPALIVE_PROBES;
+    setsockopt(fd, IPPROTO_TCP, TCP_KEEPCNT, &value, sizeof(value));
+#endif
+#ifdef SO_NOSIGPIPE
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+    (void) value;
+    if(connect(fd, (struct sockaddr*) &port->_addr, port->_addr_len) != 0)
+    {
+        if((errno != EINPROGRESS) ||
+           (tcpWait(fd, POLLOUT, tcpNowMs() + port->_params.ConnectMs) <= 0) ||
+           (getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &len) != 0) || (err != 0))
+        {
+            close(fd);
+            return (-1);
+        }
+    }
+    port->_fd = fd;
+    return (0);
+}
+
+static int16_t tcpReconnect(CAENRFIDTCPPort* port)
+{
+    uint16_t i;
+
+    tcpClose(port);
+    for(i = 0; i < port->_params.ReconnectTries; i++)
+    {
+        if(i != 0) tcpSleepMs(TCP_RETRY_MSEC);
+        if(tcpOpen(port) == 0)
+        {
+            port->Reconnects++;
+            return (0);
+        }
+    }
+    return (-1);
+}
+
+static int16_t tcpSend(CAENRFIDTCPPort* port, const uint8_t* data, uint32_t len)
+{
+    uint64_t deadline = tcpNowMs() + CAENRFID_TCP_TX_MSEC_TMO;
+    ssize_t n;
+
+    if(port->_fd < 0) return (-1);
+    while(len > 0)
+    {
+        n = send(port->_fd, data, len, MSG_NOSIGNAL);
+        if(n > 0)
+        {
+            data += n;
+            len -= (uint32_t) n;
+        }
+        else if((n < 0) && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            if(tcpWait(port->_fd, POLLOUT, deadline) <= 0) return (-1);
+        }
+        else if((n < 0) && (errno == EINTR))
+        {
+            continue;
+        }
+        else
+        {
+            return (-1);
+        }
+    }
+    return (0);
+}
+
+// sends data on the connection, restoring it once if the send fails
+// called with the port lock held
+static int16_t tcpSendRestore(CAENRFIDTCPPort* port, const uint8_t* data, uint32_t len)
+{
+    if(tcpSend(port, data, len) == 0) return (0);
+    if(tcpReconnect(port) != 0) return (-1);
+    return tcpSend(port, data, len);
+}
+
+// called with the port lock held
+static int16_t tcpFlush(CAENRFIDTCPPort* port)
+{
+    int16_t ret = 0;
+
+    if(port->_tx_len != 0)
+    {
+        ret = tcpSendRestore(port, port->_tx, port->_tx_len);
+        port->_tx_len = 0;
+    }
+    return (ret);
+}
+
+// reads what the socket holds, up to maxlen bytes, into data
+// returns the number of bytes read, 0 on timeout, -1 on error or peer closed
+static int32_t tcpRead(CAENRFIDTCPPort* port, uint8_t* data, uint32_t maxlen, uint64_t deadline)
+{
+    ssize_t n;
+    int16_t tmp;
+
+    if(port->_fd < 0) return (-1);
+    while(1)
+    {
+        n = recv(port->_fd, data, maxlen, 0);
+        if(n > 0) return (int32_t) n;
+        if(n == 0) return (-1);
+        if(errno == EINTR) continue;
+        if((errno != EAGAIN) && (errno != EWOULDBLOCK)) return (-1);
+        if((tmp = tcpWait(port->_fd, POLLIN, deadline)) <= 0) return (tmp);
+    }
+}
+
+static int16_t tcp_disconnect(void* port_handle)
+{
+    CAENRFIDTCPPort* port = (CAENRFIDTCPPort*) port_handle;
+
+    //the lock lives from a successful connect to here, whatever the socket
+    //state: a connection lost for good still has it
+    if(!port->_lock_ready)
+    {
+        tcpClose(port);
+        return (0);
+    }
+    pthread_mutex_lock(&port->_lock);
+    (void) tcpSend(port, port->_tx, port->_tx_len);
+    port->_tx_len = 0;
+    tcpClose(port);
+    pthread_mutex_unlock(&port->_lock);
+    pthread_mutex_destroy(&port->_lock);
+    port->_lock_ready = false;
+    return (0);
+}
+
+static int16_t tcp_connect(void* *port_handle, int16_t port_type, void* port_params)
+{
+    CAENRFIDTCPPort* port = (CAENRFIDTCPPort*) *port_handle;
+    const CAENRFIDTCPParams* params = (const CAENRFIDTCPParams*) port_params;
+    struct addrinfo hints, *res, *ai;
+    char service[8];
+
+    if((port == NULL) || (params == NULL) || (params->Address == NULL)) return (-1);
+    if(port_type != CAENRFID_TCP) return (-1);
+    //a port connected again is closed first
+    (void) tcp_disconnect(port);
+    port->_params = *params;
+    if(port->_params.Port == 0) port->_params.Port = TCP_DEFAULT_PORT;
+    if(port->_params.ConnectMs == 0) port->_params.ConnectMs = TCP_DEFAULT_CONNECT_MS;
+    if(port->_params.KeepAliveSec == 0) port->_params.KeepAliveSec = TCP_DEFAULT_KEEPALIVE;
+    port->Reconnects = 0;
+    port->_rx_busy = false;
+    port->_tx_len = 0;
+    //the address is resolved once, reconnecting does not wait for the resolver
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_NUMERICSERV;
+    snprintf(service, sizeof(service), "%u", (unsigned) port->_params.Port);
+    if(getaddrinfo(params->Address, service, &hints, &res) != 0) return (-1);
+    for(ai = res; ai != NULL; ai = ai->ai_next)
+    {
+        if(ai->ai_addrlen > sizeof(port->_addr)) continue;
+        memcpy(&port->_addr, ai->ai_addr, ai->ai_addrlen);
+        port->_addr_len = ai->ai_addrlen;
+        if(tcpOpen(port) == 0) break;
+    }
+    freeaddrinfo(res);
+    if(port->_fd < 0) return (-1);
+    if(pthread_mutex_init(&port->_lock, NULL) != 0)
+    {
+        tcpClose(port);
+        return (-1);
+    }
+    port->_lock_ready = true;
+    return (0);
+}
+
+static int16_t tcp_tx(void* port_handle, uint8_t* data, uint32_t len)
+{
+    CAENRFIDTCPPort* port = (CAENRFIDTCPPort*) port_handle;
+    int16_t ret = 0;
+
+    pthread_mutex_lock(&port->_lock);
+    if(port->_rx_busy)
+    {
+        //another thread waits for data: nothing would flush the frame
+        ret = tcpSend(port, data, len);
+    }
+    else
+    {
+        //frames are held until a reply is waited for or the buffer is full
+        if(port->_tx_len + len > sizeof(port->_tx)) ret = tcpFlush(port);
+        if((ret == 0) && (len > sizeof(port->_tx)))
+        {
+            ret = tcpSendRestore(port, data, len);
+        }
+        else if(ret == 0)
+        {
+            memcpy(&port->_tx[port->_tx_len], data, len);
+            port->_tx_len += len;
+        }
+    }
+    pthread_mutex_unlock(&port->_lock);
+    return (ret);
+}
+
+static int32_t tcp_rx_some(void* port_handle, uint8_t* data, uint32_t maxlen, uint32_t ms_timeout)
+{
+    CAENRFIDTCPPort* port = (CAENRFIDTCPPort*) port_handle;
+    uint32_t n;
+    int32_t got;
+    bool direct = (maxlen >= sizeof(port->_buffer));
+
+    if(port->_rpos == port->_wpos)
+    {
+        //the frames waiting for this reply go out first
+        pthread_mutex_lock(&port->_lock);
+        if(tcpFlush(port) != 0)
+        {
+            pthread_mutex_unlock(&port->_lock);
+            return (-1);
+        }
+        port->_rx_busy = true;
+        pthread_mutex_unlock(&port->_lock);
+        //nothing buffered: large requests are read straight into data
+        port->_rpos = port->_wpos = 0;
+        got = tcpRead(port, direct ? data : port->_buffer,
+                      direct ? maxlen : sizeof(port->_buffer), tcpNowMs() + ms_timeout);
+        pthread_mutex_lock(&port->_lock);
+        port->_rx_busy = false;
+        //the reply is lost, the connection is restored for the next command
+        if(got < 0) (void) tcpReconnect(port);
+        pthread_mutex_unlock(&port->_lock);
+        if((got <= 0) || direct) return (got);
+        port->_wpos = (uint32_t) got;
+    }
+    n = port->_wpos - port->_rpos;
+    if(n > maxlen) n = maxlen;
+    memcpy(data, &port->_buffer[port->_rpos], n);
+    port->_rpos += n;
+    return (int32_t) n;
+}
+
+static int16_t tcp_rx(void* port_handle, uint8_t* data, uint32_t len, uint32_t ms_timeout)
+{
+    uint64_t deadline = tcpNowMs() + ms_timeout;
+    uint64_t now;
+    int32_t n;
+
+    while(len > 0)
+    {
+        now = tcpNowMs();
+        n = tcp_rx_some(port_handle, data, len, (now < deadline) ? (uint32_t)(deadline - now) : 0);
+        if(n <= 0) return (-1);
+        data += n;
+        len -= (uint32_t) n;
+    }
+    return (0);
+}
+
+static int16_t tcp_clear_rx_data(void* port_handle)
+{
+    CAENRFIDTCPPort* port = (CAENRFIDTCPPort*) port_handle;
+    int16_t ret = 0;
+    ssize_t n;
+
+    pthread_mutex_lock(&port->_lock);
+    port->_rpos = port->_wpos = 0;
+    //a connection found closed or dead is restored before the next command
+    while(1)
+    {
+        if(port->_fd < 0)
+        {
+            ret = tcpReconnect(port);
+            break;
+        }
+        n = recv(port->_fd, port->_buffer, sizeof(port->_buffer), MSG_DONTWAIT);
+        if(n > 0) continue;
+        if((n < 0) && (errno == EINTR)) continue;
+        if((n < 0) && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        ret = tcpReconnect(port);
+        break;
+    }
+    pthread_mutex_unlock(&port->_lock);
+    return (ret);
+}
+
+static void tcp_irqs(void)
+{
+}
+
+void CAENRFID_TCPAttach(CAENRFIDReader* reader, CAENRFIDTCPPort* port)
+{
+    port->_fd = -1;
+    port->_lock_ready = false;
+    port->_rpos = port->_wpos = 0;
+    port->_tx_len = 0;
+    reader->_port_handle = port;
+    reader->connect = tcp_connect;
+    reader->disconnect = tcp_disconnect;
+    reader->tx = tcp_tx;
+    reader->rx = tcp_rx;
+    reader->rx_some = tcp_rx_some;
+    reader->clear_rx_data = tcp_clear_rx_data;
+    reader->enable_irqs = tcp_irqs;
+    reader->disable_irqs = tcp_irqs;
+}
+
+#endif /* CAENRFID_TCP_SUPPORTED */
@@ -0,0 +1,137 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2022, CAEN RFID S.R.L.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of CAEN RFID S.R.L. nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+
+#ifndef SRC_LIB_CAENRFIDTCP_LIGHT_H_
+#define SRC_LIB_CAENRFIDTCP_LIGHT_H_
+
+#include "CAENRFIDTypes_Light.h"
+
+/*
+    The TCP backend is built on BSD sockets: it is available on POSIX hosts only.
+*/
+#if defined(__unix__) || defined(__APPLE__)
+#define CAENRFID_TCP_SUPPORTED
+#endif
+
+#ifdef CAENRFID_TCP_SUPPORTED
+
+#include <pthread.h>
+#include <sys/socket.h>
+
+#ifndef CAENRFID_TCP_BUFFER_SIZE
+#define CAENRFID_TCP_BUFFER_SIZE                4096
+#endif
+#ifndef CAENRFID_TCP_TX_BUFFER_SIZE
+#define CAENRFID_TCP_TX_BUFFER_SIZE             1024
+#endif
+#ifndef CAENRFID_TCP_TX_MSEC_TMO
+#define CAENRFID_TCP_TX_MSEC_TMO                1000
+#endif
+
+/*
+    TCP Connection Parameters, to be passed as PortParams to CAENRFID_Connect
+
+    - Address        : the reader host name or IP address.
+    - Port           : the reader TCP port, 0 for 1000.
+    - ConnectMs      : the time allowed to each connection attempt, 0 for 1000.
+    - KeepAliveSec   : the idle time before the peer is probed, 0 for 5.
+                       A peer not answering 3 probes sent 1 second apart is
+                       considered dead.
+    - ReconnectTries : the number of attempts made to restore a lost
+                       connection before a command fails, 0 for none.
+*/
+typedef struct CAENRFIDTCPParams_s {
+    const char*         Address;
+    uint16_t            Port;
+    uint32_t            ConnectMs;
+    uint16_t            KeepAliveSec;
+    uint16_t            ReconnectTries;
+} CAENRFIDTCPParams;
+
+/*
+    TCP Port Struct
+
+    Holds the socket, the address resolved by CAENRFID_Connect, the bytes
+    received but not yet requested and the bytes to be sent.
+    Frames passed to tx are held in the port and sent with a single write
+    when the library waits for a reply, so that the commands of a pipeline
+    window go out in as few segments as possible. A frame sent while another
+    thread waits for data (e.g. CAENRFID_InventoryAbort) is written at once.
+
+    User may read the following fields:
+    - Reconnects : the number of times the connection was restored.
+
+    User should NOT modify the fields starting with an underscore.
+*/
+typedef struct CAENRFIDTCPPort_s {
+    uint32_t                Reconnects;
+
+    int                     _fd;
+    CAENRFIDTCPParams       _params;
+    struct sockaddr_storage _addr;
+    socklen_t               _addr_len;
+    pthread_mutex_t         _lock;
+    bool                    _lock_ready;
+    bool                    _rx_busy;
+    uint32_t                _rpos;
+    uint32_t                _wpos;
+    uint8_t                 _buffer[CAENRFID_TCP_BUFFER_SIZE];
+    uint32_t                _tx_len;
+    uint8_t                 _tx[CAENRFID_TCP_TX_BUFFER_SIZE];
+} CAENRFIDTCPPort;
+
+/*
+    CAENRFID_TCPAttach
+    -----------------------------------------------------------------------------
+    Parameters:
+        [in],[out]  reader     : The reader data structure to be bound to the port.
+        [in]        port       : The TCP port, owned by the caller for as long
+                                 as the reader is connected.
+    -----------------------------------------------------------------------------
+    Returns:
+    -----------------------------------------------------------------------------
+    Description:
+        Fills the reader callbacks so that the reader is driven through a
+        TCP connection. The connection is opened by CAENRFID_Connect, called
+        afterwards with CAENRFID_TCP as PortType and a CAENRFIDTCPParams as
+        PortParams, and closed by CAENRFID_Disconnect.
+        The socket is non-blocking with Nagle's algorithm disabled and
+        keepalive probes enabled. A connection found closed or dead is
+        restored before the next command is sent, or while a command is
+        sent; the command whose reply was lost fails with
+        CAENRFID_CommunicationError.
+*/
+void CAENRFID_TCPAttach(CAENRFIDReader* reader, CAENRFIDTCPPort* port);
+
+#endif /* CAENRFID_TCP_SUPPORTED */
+
+#endif /* SRC_LIB_CAENRFIDTCP_LIGHT_H_ */
@@ -1,464 +1,1045 @@
-/* --COPYRIGHT--,BSD
- * Copyright (c) 2022, CAEN RFID S.R.L.
- * All rights reserved.
- *
- * Redistribution and use in source and binary forms, with or without
- * modification, are permitted provided that the following conditions
- * are met:
- *
- * *  Redistributions of source code must retain the above copyright
- *    notice, this list of conditions and the following disclaimer.
- *
- * *  Redistributions in binary form must reproduce the above copyright
- *    notice, this list of conditions and the following disclaimer in the
- *    documentation and/or other materials provided with the distribution.
- *
- * *  Neither the name of CAEN RFID S.R.L. nor the names of
- *    its contributors may be used to endorse or promote products derived
- *    from this software without specific prior written permission.
- *
- * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
- * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
- * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
- * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
- * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
- * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
- * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
- * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
- * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
- * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
- * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
- * --/COPYRIGHT--*/
-
-#ifndef SRC_LIB_CAENRFIDTYPES_LIGHT_H_
-#define SRC_LIB_CAENRFIDTYPES_LIGHT_H_
-
-#include <stdint.h>
-#include <stdbool.h>
-
-#define MAX_ID_LENGTH                           64
-#define XPC_LENGTH                              4
-#define PC_LENGTH                               2
-#define MAX_READPOINT_NAME                      5
-#define MAX_LOGICAL_SOURCE_NAME                 30
-#define MAX_TID_SIZE                            64
-#define MAX_TAG_VALUE_LENGTH                    128
-#define MAX_FWREL_LENGTH                        30
-#define MAX_SWREL_LENGTH                        6
-#define MAX_MODEL_LENGTH                        20
-#define MAX_SERIAL_LENGTH                       20
-
- /*
-     Error Codes
- */
-typedef enum {
-    // -------------------- GENERAL ERROR CODES
-    CAENRFID_StatusOK                          =  0,  // Operation completed successfully
-    CAENRFID_TooManyClientsError               = -1,  
-    CAENRFID_PortError                         = -2,  
-    CAENRFID_LibraryError                      = -3,
-    CAENRFID_SocketError                       = -4,  
-    CAENRFID_InvalidHandleError                = -5,  
-    CAENRFID_OutOfMemoryError                  = -6,
-    CAENRFID_CommunicationError                = -7,
-    CAENRFID_CommunicationTimeOut              = -8,
-    CAENRFID_ChannelExist                      = -9,
-    CAENRFID_GenericError                      = -10, 
-    CAENRFID_InvalidParam                      = -11,  // Invalid parameter error
-    CAENRFID_ReaderBusy                        = -12,
-    CAENRFID_EOF                               = -13,
-    //--------------------- FIRMWARE ERROR CODES (communication specific)
-    CAENRFID_ChanNameExistsError               = 100,
-    CAENRFID_AddrAlreadyInUseError             = 101,
-    CAENRFID_UnknowError                       = 102,
-    CAENRFID_BadChannelError                   = 103,
-    CAENRFID_InvalidSourceNamError             = 104,
-    CAENRFID_InvalidChannelNameError           = 105,
-    CAENRFID_TooManyChannelError               = 106,
-    CAENRFID_TooManySourceError                = 107,
-    CAENRFID_SourceNotInChannelError           = 109,
-    CAENRFID_BadTimerValueError                = 110,
-    CAENRFID_TriggerNameExistError             = 111,
-    CAENRFID_TooManyTriggerError               = 112,
-    CAENRFID_BadTriggerError                   = 113,
-    CAENRFID_BadAddressError                   = 114,
-    CAENRFID_InvalidProtocolError              = 115,
-    CAENRFID_BadPortAddressError               = 116,
-    CAENRFID_CannotConnectToServerError        = 117,
-    CAENRFID_InvalidTriggerNameError           = 118,
-    CAENRFID_InvalidTimeError                  = 119,
-    CAENRFID_SourceNotFoundError               = 120,
-    CAENRFID_TriggerNotFoundError              = 121,
-    CAENRFID_ChannelNotFoundError              = 122,
-    CAENRFID_BadReadPointError                 = 123,
-    CAENRFID_ChannelBusyError                  = 124,
-    CAENRFID_TriggerBusyError                  = 125,
-    CAENRFID_InternalFilesystemError           = 126,
-    CAENRFID_InvalidCommand                    = 127,
-    CAENRFID_BadParameterValueError            = 128,
-    CAENRFID_NotifyServerNotReadyError         = 129,
-    CAENRFID_PowerValueOutofRangeError         = 183,
-    CAENRFID_InvalidParameterError             = 200,
-    CAENRFID_LogicalSourceDisabledError        = 201,
-    CAENRFID_TagNotPresentError                = 202,
-    CAENRFID_WritingTagError                   = 203,
-    CAENRFID_ReadingTagError                   = 204,
-    CAENRFID_BadTagAddressError                = 205,
-    CAENRFID_InvalidFunctionError              = 206,
-    CAENRFID_SelectUnselectError               = 207,
-    CAENRFID_TagLockedError                    = 209,
-    CAENRFID_UnsupportedError                  = 210,
-    CAENRFID_PowerError                        = 211,
-    CAENRFID_NonSpecificError                  = 212,
-    CAENRFID_KillTagError                      = 213,
-    CAENRFID_ChannelsFullError                 = 214,
-    CAENRFID_ErrorMatchReadpoint               = 215
-} CAENRFIDErrorCodes;
-
-/*
-    Logical Source Parameters Values
-*/
-typedef enum {
-    EPC_C1G2_SESSION_S0     = 0,
-    EPC_C1G2_SESSION_S1     = 1,
-    EPC_C1G2_SESSION_S2     = 2,
-    EPC_C1G2_SESSION_S3     = 3,
-    EPC_C1G2_TARGET_A       = 0,
-    EPC_C1G2_TARGET_B       = 1,
-    EPC_C1G2_SELECTED_YES   = 3,
-    EPC_C1G2_SELECTED_NO    = 2,
-    EPC_C1G2_ALL_SELECTED   = 0,
-    ISO18006B_DESB_ON       = 1,
-    ISO18006B_DESB_OFF      = 0,
-}CAENRFIDLogicalSourceConstants ;
-
-/*
-    Logical Source Parameters
-*/
-typedef enum {
-    CONFIG_READCYCLE            = 0,
-    CONFIG_OBSERVEDTHRESHOLD    = 1,
-    CONFIG_LOSTTHRESHOLD        = 2,
-    CONFIG_G2_Q_VALUE           = 3,
-    CONFIG_G2_SESSION           = 4,
-    CONFIG_G2_TARGET            = 5,
-    CONFIG_G2_SELECTED          = 6,
-    CONFIG_ISO18006B_DESB       = 7,
-    CONFIG_DWELL_TIME           = 8,
-    CONFIG_INV_COUNT            = 10,
-    CONFIG_TID_LENGTH           = 13,
-    CONFIG_QUIETTIME            = 15
-} CAENRFID_SOURCE_Parameter;
-
-/*
-    Reader Port Types
-*/
-typedef enum {
-    CAENRFID_RS232   = 0,
-   //CAENRFID_RS485  = 1, Obsolete
-    CAENRFID_TCP     = 2,
-    CAENRFID_USB     = 3
-} CAENRFIDPort;
-
-/*
-    Reader Serial Port Parity 
-*/
-typedef enum {
-    CAENRS232_Parity_None      = 0,
-    CAENRS232_Parity_Odd       = 1,
-    CAENRS232_Parity_Even      = 2
-} CAENRFID_RS232_Parity;
-
-/*
-    Reader Serial Port Flow Control
-*/
-typedef enum {
-    CAENRFID_RS232_FlowControl_XonXoff    = 2,
-    CAENRFID_RS232_FlowControl_Hardware   = 1,
-    CAENRFID_RS232_FlowControl_None       = 0
-}CAENRFID_RS232_FlowControl;
-
-/*
-    Reader Protocols
-*/
-typedef enum {
-    CAENRFID_ISO18000_6B   = 0,
-    CAENRFID_EPC_C1G1      = 1,
-    CAENRFID_ISO18000_6A   = 2,
-    CAENRFID_EPC_C1G2      = 3,
-    CAENRFID_MULTIPROTOCOL = 4,
-    CAENRFID_EPC119        = 5
-} CAENRFIDProtocol;
-
-/*
-    EPCC1G2 Banks
-*/
-typedef enum {
-    RESERVED   = 0,
-    EPC_CAEN        = 1,
-    TID        = 2,
-    USER       = 3
-} CAENRFIDMemBanks;
-
-/*
-    Inventory flag bit values
-*/
-typedef enum {
-    RSSI                    = 0x0001,
-    FRAMED                  = 0x0002,
-    CONTINUOS               = 0x0004,
-    COMPACT                 = 0x0008,
-    TID_READING             = 0x0010,
-    EVENT_TRIGGER           = 0x0020,
-    XPC                     = 0x0040,
-    PC                      = 0x0100
-} CAENRFID_InventoryFlag;
-
-/*
-    Antenna Status
-*/
-typedef enum {
-    STATUS_GOOD     = 0,
-    STATUS_POOR     = 1,
-    STATUS_BAD      = 2
-} CAENRFIDReadPointStatus;
-
-/*
-    RF Bitrate
-*/
-typedef enum{
-    TX10RX40 = 1,
-    TX40RX40 = 2,
-    TX40RX160 = 3,
-    DSB_ASK_FM0_TX10RX40 = 1,
-    DSB_ASK_FM0_TX40RX40 = 2,
-    DSB_ASK_FM0_TX40RX160 = 3,
-    DSB_ASK_FM0_TX160RX400 = 4,
-    DSB_ASK_M2_TX40RX160 = 5,
-    PR_ASK_M4_TX40RX250 = 6,
-    PR_ASK_M4_TX40RX300 = 7,
-    PR_ASK_M2_TX40RX250 = 8,
-    DSB_ASK_M4_TX40RX256 = 10,
-    PR_ASK_M4_TX40RX320 = 11,
-    PR_ASK_FM0_TX40RX640 = 12,
-    PR_ASK_M4_TX80RX320 = 13,
-    PR_ASK_M4_TX40RX256 = 14,
-    PR_ASK_M8_TX40RX256 = 15,
-    PR_ASK_M2_TX133RX640 = 16,
-    PR_ASK_M2_TX50RX320 = 17,
-    PR_ASK_M4_TX50RX320 = 18,
-    PR_ASK_M4_TX50RX250 = 19,
-    PR_ASK_FM0_TX133RX640 = 20,
-    PR_ASK_M2_TX66RX320 = 21,
-    PR_ASK_M8_TX50RX160 = 22,
-    PR_ASK_M4_TX133RX640 = 23,
-    DSB_ASK_FM0_TX160RX640 = 24,
-    DSB_ASK_M2_TX160RX640 = 25
-}CAENRFID_Bitrate;
-
-/*
-    RF regulations
-*/
-typedef enum{
-    ETSI_302208     = 0,
-    ETSI_300220     = 1,
-    FCC_US          = 2,
-    MALAYSIA        = 3,
-    JAPAN           = 4,
-    KOREA           = 5,
-    AUSTRALIA       = 6,
-    CHINA           = 7,
-    TAIWAN          = 8,
-    SINGAPORE       = 9,
-    BRAZIL          = 10,
-    JAPAN_STD_T106  = 11,
-    JAPAN_STD_T107  = 12,
-    PERU            = 13,
-    SOUTH_AFRICA    = 14,
-    CHILE           = 15
-}CAENRFIDRFRegulations;
-
-/*
-    Antenna Matching Parameters
-*/
-typedef enum{
-    RPCMATCHRFALG =14
-}CAENRFIDMatchingParams;
-
-/*
-    Tag identification struct
-*/
-typedef struct CAENRFIDTag_s {
-    uint8_t             ID[MAX_ID_LENGTH];
-    uint16_t            Length;
-    char                LogicalSource[MAX_LOGICAL_SOURCE_NAME];
-    char                ReadPoint[MAX_READPOINT_NAME];
-    uint32_t            TimeStamp[2];
-    CAENRFIDProtocol    Type;
-    int16_t             RSSI;
-    uint8_t             TID[MAX_TID_SIZE];
-    uint16_t            TIDLen;
-    uint8_t             XPC[XPC_LENGTH];
-    uint8_t             PC[PC_LENGTH];
-} CAENRFIDTag;
-
-/*
-    Element of a list of tags
-*/
-typedef struct CAENRFIDTagList_s {
-    CAENRFIDTag Tag;
-    struct CAENRFIDTagList_s* Next;
-} CAENRFIDTagList;
-
-/*
-    Inventory Parameters Struct : For internal use only 
-*/
-typedef struct CAENRFIDInventoryParams_s {
-    bool has_RSSI;
-    bool has_framed;
-    bool has_continuous;
-    bool has_compact;
-    bool has_TID;
-    bool has_event_trigger;
-    bool has_XPC;
-    bool has_PC;
-} CAENRFIDInventoryParams;
-
-/*
-    Reader Struct 
-
-    User should initialize the following fields:
-    - connect
-    - disconnect
-    - tx
-    - rx
-    - clear_rx_data
-    - enable_irqs
-    - disable_irqs
-    
-    User should NOT modify the following fields:
-     - _port_handle
-     - _inventory_params
-*/
-typedef struct CAENRFIDReader_s {
-    /*
-    ---------------------------------------------------------------
-      _port_handle - An handle that identifies the reader port
-      For internal use only : do not modify.
-    ---------------------------------------------------------------
-    */
-    void*   _port_handle;
-
-    /*
-    ---------------------------------------------------------------
-     connect - Opens a connection with the reader
-    ---------------------------------------------------------------
-     Parameters:
-     [out] port_handle   :   handle to the reader port
-     [in]  port_type     :   the type of port 
-     [in]  port_params   :   the connection parameters
-     ---------------------------------------------------------------
-      Returns:
-       (0) : Success
-      (-1) : Failure
-    */
-    int16_t (*connect)(void* *port_handle, int16_t port_type, void* port_params);
- 
-
-    /*
-    ---------------------------------------------------------------
-     disconnect - Closes the connection with the reader
-    ---------------------------------------------------------------
-     Parameters:
-     [in]  port_handle   :   handle to the reader port
-     ---------------------------------------------------------------
-      Returns:
-       (0) : Success
-      (-1) : Failure
-    */
-    int16_t (*disconnect)(void* port_handle);
-
-    /*
-    ---------------------------------------------------------------
-     tx - Transmits data to the reader
-    ---------------------------------------------------------------
-     Parameters:
-     [in]  port_handle   :   handle to the reader port
-     [in]  data          :   the bytes data to be sent to the reader
-     [in]  len           :   the number of bytes to be sent
-     ---------------------------------------------------------------
-      Returns:
-       (0) : Success
-      (-1) : Failure
-    */
-    int16_t (*tx)(void* port_handle, uint8_t* data, uint32_t len);
-
-    /*
-    ---------------------------------------------------------------
-     rx - Receives data from the reader
-    ---------------------------------------------------------------
-     Parameters:
-     [in]  port_handle   :   handle to the reader port
-     [out] data          :   the data received from the reader
-     [in]  len           :   the number of bytes to be received
-     [in]  ms_timeout    :   the timeout in milliseconds for 
-                             reception to be completed.
-     ---------------------------------------------------------------
-      Returns:
-       (0) : Success
-      (-1) : Failure
-    */
-    int16_t (*rx)(void* port_handle, uint8_t* data, uint32_t len, uint32_t ms_timeout);
-
-    /*
-     ---------------------------------------------------------------
-     clear_rx_data - Clears data present in the receive buffer, 
-                     that is any data sent by the reader but not
-                     parsed.
-     ---------------------------------------------------------------
-     Parameters:
-     [in]  port_handle   :   handle to the reader port
-     ---------------------------------------------------------------
-     Returns:
-       (0) : Success
-      (-1) : Failure
-    */
-    int16_t (*clear_rx_data)(void* port_handle);
-
-    /*
-     ---------------------------------------------------------------
-     enable_irqs - Enables host interrupts not related to tx/rx
-                   communication with the reader.
-     ---------------------------------------------------------------
-     Parameters:
-     ---------------------------------------------------------------
-     Returns:
-    */
-    void    (*enable_irqs)(void); 
-
-    /*
-     ---------------------------------------------------------------
-     disable_irqs - Disables host interrupts not related to tx/rx
-                    communication with the reader.
-     ---------------------------------------------------------------
-     Parameters:
-     ---------------------------------------------------------------
-     Returns:
-    */
-    void    (*disable_irqs)(void);
-
-    /*
-    ---------------------------------------------------------------
-      inventory_params - A struct containing information about
-                         reader ongoing framed inventory.
-      WARNING : For internal use only - DO NOT MODIFY!!
-    ---------------------------------------------------------------
-    */
-    struct CAENRFIDInventoryParams_s  _inventory_params;
-
-} CAENRFIDReader;
-
-
-
-
-#endif /* SRC_LIB_CAENRFIDTYPES_LIGHT_H_ */
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2022, CAEN RFID S.R.L.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of CAEN RFID S.R.L. nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+
+#ifndef SRC_LIB_CAENRFIDTYPES_LIGHT_H_
+#define SRC_LIB_CAENRFIDTYPES_LIGHT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define MAX_ID_LENGTH                           64
+#define XPC_LENGTH                              4
+#define PC_LENGTH                               2
+#define MAX_READPOINT_NAME                      5
+#define MAX_LOGICAL_SOURCE_NAME                 30
+#define MAX_TID_SIZE                            64
+#define MAX_TAG_VALUE_LENGTH                    128
+#define MAX_FWREL_LENGTH                        30
+#define MAX_SWREL_LENGTH                        6
+#define MAX_MODEL_LENGTH                        20
+#define MAX_SERIAL_LENGTH                       20
+
+/*
+    Build options
+
+    CAENRFID_MAX_FRAME_LENGTH : size in bytes of the per-reader scratch buffer
+                                used to encode commands and to receive replies.
+                                Replies longer than this value are rejected
+                                with CAENRFID_OutOfMemoryError. At most 0xFFFF.
+    CAENRFID_NO_HEAP          : when defined, the library never calls malloc/free.
+                                The scratch buffer is embedded in CAENRFIDReader
+                                and functions returning a CAENRFIDTagList are not
+                                available. Must be defined for the whole project.
+    CAENRFID_RX_BUFFER_SIZE   : size in bytes of the per-reader buffer framed
+                                inventory data is received into. Must hold at
+                                least the largest tag AVP.
+    CAENRFID_PIPELINE_DEPTH   : maximum number of commands a CAENRFIDPipeline
+                                can keep in flight.
+    CAENRFID_TEMPLATE_SLOTS   : number of per-reader slots keeping the last
+                                frames of fixed shape commands (status polls,
+                                inventory start), which are then only patched
+                                with a new CmdID. 0 disables the cache.
+    CAENRFID_TEMPLATE_LENGTH  : size in bytes of a template slot, holding the
+                                command parameters and the encoded frame.
+*/
+#ifndef CAENRFID_MAX_FRAME_LENGTH
+#define CAENRFID_MAX_FRAME_LENGTH               0xFFFF
+#endif
+#if CAENRFID_MAX_FRAME_LENGTH > 0xFFFF
+#error "CAENRFID_MAX_FRAME_LENGTH must not exceed 0xFFFF, the largest easy2read frame"
+#endif
+#ifndef CAENRFID_RX_BUFFER_SIZE
+#define CAENRFID_RX_BUFFER_SIZE                 512
+#endif
+#ifndef CAENRFID_PIPELINE_DEPTH
+#define CAENRFID_PIPELINE_DEPTH                 8
+#endif
+#ifndef CAENRFID_TEMPLATE_SLOTS
+#define CAENRFID_TEMPLATE_SLOTS                 4
+#endif
+#ifndef CAENRFID_TEMPLATE_LENGTH
+#define CAENRFID_TEMPLATE_LENGTH                96
+#endif
+
+ /*
+     Error Codes
+ */
+typedef enum {
+    // -------------------- GENERAL ERROR CODES
+    CAENRFID_StatusOK                          =  0,  // Operation completed successfully
+    CAENRFID_TooManyClientsError               = -1,  
+    CAENRFID_PortError                         = -2,  
+    CAENRFID_LibraryError                      = -3,
+    CAENRFID_SocketError                       = -4,  
+    CAENRFID_InvalidHandleError                = -5,  
+    CAENRFID_OutOfMemoryError                  = -6,
+    CAENRFID_CommunicationError                = -7,
+    CAENRFID_CommunicationTimeOut              = -8,
+    CAENRFID_ChannelExist                      = -9,
+    CAENRFID_GenericError                      = -10, 
+    CAENRFID_InvalidParam                      = -11,  // Invalid parameter error
+    CAENRFID_ReaderBusy                        = -12,
+    CAENRFID_EOF                               = -13,
+    //--------------------- FIRMWARE ERROR CODES (communication specific)
+    CAENRFID_ChanNameExistsError               = 100,
+    CAENRFID_AddrAlreadyInUseError             = 101,
+    CAENRFID_UnknowError                       = 102,
+    CAENRFID_BadChannelError                   = 103,
+    CAENRFID_InvalidSourceNamError             = 104,
+    CAENRFID_InvalidChannelNameError           = 105,
+    CAENRFID_TooManyChannelError               = 106,
+    CAENRFID_TooManySourceError                = 107,
+    CAENRFID_SourceNotInChannelError           = 109,
+    CAENRFID_BadTimerValueError                = 110,
+    CAENRFID_TriggerNameExistError             = 111,
+    CAENRFID_TooManyTriggerError               = 112,
+    CAENRFID_BadTriggerError                   = 113,
+    CAENRFID_BadAddressError                   = 114,
+    CAENRFID_InvalidProtocolError              = 115,
+    CAENRFID_BadPortAddressError               = 116,
+    CAENRFID_CannotConnectToServerError        = 117,
+    CAENRFID_InvalidTriggerNameError           = 118,
+    CAENRFID_InvalidTimeError                  = 119,
+    CAENRFID_SourceNotFoundError               = 120,
+    CAENRFID_TriggerNotFoundError              = 121,
+    CAENRFID_ChannelNotFoundError              = 122,
+    CAENRFID_BadReadPointError                 = 123,
+    CAENRFID_ChannelBusyError                  = 124,
+    CAENRFID_TriggerBusyError                  = 125,
+    CAENRFID_InternalFilesystemError           = 126,
+    CAENRFID_InvalidCommand                    = 127,
+    CAENRFID_BadParameterValueError            = 128,
+    CAENRFID_NotifyServerNotReadyError         = 129,
+    CAENRFID_PowerValueOutofRangeError         = 183,
+    CAENRFID_InvalidParameterError             = 200,
+    CAENRFID_LogicalSourceDisabledError        = 201,
+    CAENRFID_TagNotPresentError                = 202,
+    CAENRFID_WritingTagError                   = 203,
+    CAENRFID_ReadingTagError                   = 204,
+    CAENRFID_BadTagAddressError                = 205,
+    CAENRFID_InvalidFunctionError              = 206,
+    CAENRFID_SelectUnselectError               = 207,
+    CAENRFID_TagLockedError                    = 209,
+    CAENRFID_UnsupportedError                  = 210,
+    CAENRFID_PowerError                        = 211,
+    CAENRFID_NonSpecificError                  = 212,
+    CAENRFID_KillTagError                      = 213,
+    CAENRFID_ChannelsFullError                 = 214,
+    CAENRFID_ErrorMatchReadpoint               = 215
+} CAENRFIDErrorCodes;
+
+/*
+    Logical Source Parameters Values
+*/
+typedef enum {
+    EPC_C1G2_SESSION_S0     = 0,
+    EPC_C1G2_SESSION_S1     = 1,
+    EPC_C1G2_SESSION_S2     = 2,
+    EPC_C1G2_SESSION_S3     = 3,
+    EPC_C1G2_TARGET_A       = 0,
+    EPC_C1G2_TARGET_B       = 1,
+    EPC_C1G2_SELECTED_YES   = 3,
+    EPC_C1G2_SELECTED_NO    = 2,
+    EPC_C1G2_ALL_SELECTED   = 0,
+    ISO18006B_DESB_ON       = 1,
+    ISO18006B_DESB_OFF      = 0,
+}CAENRFIDLogicalSourceConstants ;
+
+/*
+    Logical Source Parameters
+*/
+typedef enum {
+    CONFIG_READCYCLE            = 0,
+    CONFIG_OBSERVEDTHRESHOLD    = 1,
+    CONFIG_LOSTTHRESHOLD        = 2,
+    CONFIG_G2_Q_VALUE           = 3,
+    CONFIG_G2_SESSION           = 4,
+    CONFIG_G2_TARGET            = 5,
+    CONFIG_G2_SELECTED          = 6,
+    CONFIG_ISO18006B_DESB       = 7,
+    CONFIG_DWELL_TIME           = 8,
+    CONFIG_INV_COUNT            = 10,
+    CONFIG_TID_LENGTH           = 13,
+    CONFIG_QUIETTIME            = 15
+} CAENRFID_SOURCE_Parameter;
+
+/*
+    Group select/unselect operations
+*/
+typedef enum {
+    GROUP_SELECT_EQUAL              = 0,
+    GROUP_SELECT_NOT_EQUAL          = 1,
+    GROUP_SELECT_GREATER_THAN       = 2,
+    GROUP_SELECT_LOWER_THAN         = 3,
+    GROUP_UNSELECT_EQUAL            = 4,
+    GROUP_UNSELECT_NOT_EQUAL        = 5,
+    GROUP_UNSELECT_GREATER_THAN     = 6,
+    GROUP_UNSELECT_LOWER_THAN       = 7,
+} CAENRFIDSelUnselOptions;
+
+/*
+    Reader Port Types
+*/
+typedef enum {
+    CAENRFID_RS232   = 0,
+   //CAENRFID_RS485  = 1, Obsolete
+    CAENRFID_TCP     = 2,
+    CAENRFID_USB     = 3
+} CAENRFIDPort;
+
+/*
+    Reader Serial Port Parity 
+*/
+typedef enum {
+    CAENRS232_Parity_None      = 0,
+    CAENRS232_Parity_Odd       = 1,
+    CAENRS232_Parity_Even      = 2
+} CAENRFID_RS232_Parity;
+
+/*
+    Reader Serial Port Flow Control
+*/
+typedef enum {
+    CAENRFID_RS232_FlowControl_XonXoff    = 2,
+    CAENRFID_RS232_FlowControl_Hardware   = 1,
+    CAENRFID_RS232_FlowControl_None       = 0
+}CAENRFID_RS232_FlowControl;
+
+/*
+    Reader Protocols
+*/
+typedef enum {
+    CAENRFID_ISO18000_6B   = 0,
+    CAENRFID_EPC_C1G1      = 1,
+    CAENRFID_ISO18000_6A   = 2,
+    CAENRFID_EPC_C1G2      = 3,
+    CAENRFID_MULTIPROTOCOL = 4,
+    CAENRFID_EPC119        = 5
+} CAENRFIDProtocol;
+
+/*
+    EPCC1G2 Banks
+*/
+typedef enum {
+    RESERVED   = 0,
+    EPC_CAEN        = 1,
+    TID        = 2,
+    USER       = 3
+} CAENRFIDMemBanks;
+
+/*
+    Inventory flag bit values
+*/
+typedef enum {
+    RSSI                    = 0x0001,
+    FRAMED                  = 0x0002,
+    CONTINUOS               = 0x0004,
+    COMPACT                 = 0x0008,
+    TID_READING             = 0x0010,
+    EVENT_TRIGGER           = 0x0020,
+    XPC                     = 0x0040,
+    PC                      = 0x0100
+} CAENRFID_InventoryFlag;
+
+/*
+    Antenna Status
+*/
+typedef enum {
+    STATUS_GOOD     = 0,
+    STATUS_POOR     = 1,
+    STATUS_BAD      = 2
+} CAENRFIDReadPointStatus;
+
+/*
+    RF Bitrate
+*/
+typedef enum{
+    TX10RX40 = 1,
+    TX40RX40 = 2,
+    TX40RX160 = 3,
+    DSB_ASK_FM0_TX10RX40 = 1,
+    DSB_ASK_FM0_TX40RX40 = 2,
+    DSB_ASK_FM0_TX40RX160 = 3,
+    DSB_ASK_FM0_TX160RX400 = 4,
+    DSB_ASK_M2_TX40RX160 = 5,
+    PR_ASK_M4_TX40RX250 = 6,
+    PR_ASK_M4_TX40RX300 = 7,
+    PR_ASK_M2_TX40RX250 = 8,
+    DSB_ASK_M4_TX40RX256 = 10,
+    PR_ASK_M4_TX40RX320 = 11,
+    PR_ASK_FM0_TX40RX640 = 12,
+    PR_ASK_M4_TX80RX320 = 13,
+    PR_ASK_M4_TX40RX256 = 14,
+    PR_ASK_M8_TX40RX256 = 15,
+    PR_ASK_M2_TX133RX640 = 16,
+    PR_ASK_M2_TX50RX320 = 17,
+    PR_ASK_M4_TX50RX320 = 18,
+    PR_ASK_M4_TX50RX250 = 19,
+    PR_ASK_FM0_TX133RX640 = 20,
+    PR_ASK_M2_TX66RX320 = 21,
+    PR_ASK_M8_TX50RX160 = 22,
+    PR_ASK_M4_TX133RX640 = 23,
+    DSB_ASK_FM0_TX160RX640 = 24,
+    DSB_ASK_M2_TX160RX640 = 25
+}CAENRFID_Bitrate;
+
+/*
+    RF regulations
+*/
+typedef enum{
+    ETSI_302208     = 0,
+    ETSI_300220     = 1,
+    FCC_US          = 2,
+    MALAYSIA        = 3,
+    JAPAN           = 4,
+    KOREA           = 5,
+    AUSTRALIA       = 6,
+    CHINA           = 7,
+    TAIWAN          = 8,
+    SINGAPORE       = 9,
+    BRAZIL          = 10,
+    JAPAN_STD_T106  = 11,
+    JAPAN_STD_T107  = 12,
+    PERU            = 13,
+    SOUTH_AFRICA    = 14,
+    CHILE           = 15
+}CAENRFIDRFRegulations;
+
+/*
+    Antenna Matching Parameters
+*/
+typedef enum{
+    RPCMATCHRFALG =14
+}CAENRFIDMatchingParams;
+
+/*
+    Tag identification struct
+*/
+typedef struct CAENRFIDTag_s {
+    uint8_t             ID[MAX_ID_LENGTH];
+    uint16_t            Length;
+    char                LogicalSource[MAX_LOGICAL_SOURCE_NAME];
+    char                ReadPoint[MAX_READPOINT_NAME];
+    uint32_t            TimeStamp[2];
+    CAENRFIDProtocol    Type;
+    int16_t             RSSI;
+    uint8_t             TID[MAX_TID_SIZE];
+    uint16_t            TIDLen;
+    uint8_t             XPC[XPC_LENGTH];
+    uint8_t             PC[PC_LENGTH];
+} CAENRFIDTag;
+
+/*
+    Element of a list of tags
+*/
+typedef struct CAENRFIDTagList_s {
+    CAENRFIDTag Tag;
+    struct CAENRFIDTagList_s* Next;
+} CAENRFIDTagList;
+
+/*
+    Tag handle
+
+    Holds the attributes addressing a tag (logical source, ID length and
+    ID) and the access password, already encoded by CAENRFID_TagHandleInit,
+    so that the access commands issued through the handle copy them into
+    their frame as they are. The handle does not refer to the tag it was
+    built from.
+
+    User should NOT modify the fields starting with an underscore.
+*/
+#define CAENRFID_TAG_HANDLE_LENGTH              (3 * 6 + MAX_LOGICAL_SOURCE_NAME + 2 + MAX_ID_LENGTH)
+#define CAENRFID_TAG_HANDLE_PASSWORD_LENGTH     (6 + 4)
+
+typedef struct CAENRFIDTagHandle_s {
+    uint8_t             _address[CAENRFID_TAG_HANDLE_LENGTH];
+    uint16_t            _address_len;
+    uint8_t             _password[CAENRFID_TAG_HANDLE_PASSWORD_LENGTH];
+    uint16_t            _password_len;
+} CAENRFIDTagHandle;
+
+/*
+    View of a tag inside a received inventory reply
+
+    Pointers refer to the reply held by a CAENRFIDTagFrame and stay valid
+    until it is released. Strings are not NUL terminated. Attributes not
+    requested by the inventory flag are NULL/0.
+*/
+typedef struct CAENRFIDTagView_s {
+    const uint8_t*      ID;
+    uint16_t            Length;
+    const char*         LogicalSource;
+    uint16_t            LogicalSourceLen;
+    const char*         ReadPoint;
+    uint16_t            ReadPointLen;
+    uint32_t            TimeStamp[2];
+    CAENRFIDProtocol    Type;
+    int16_t             RSSI;
+    const uint8_t*      TID;
+    uint16_t            TIDLen;
+    const uint8_t*      XPC;
+    const uint8_t*      PC;
+} CAENRFIDTagView;
+
+/*
+    Packed tag flags
+*/
+#define PACKED_TAG_HAS_XPC                      0x01
+#define PACKED_TAG_HAS_PC                       0x02
+#define PACKED_TAG_NO_INDEX                     0xFF
+
+/*
+    Packed tag identification struct
+
+    Compact alternative to CAENRFIDTag to be stored in a CAENRFIDTagPool.
+    Source and ReadPoint are the indexes of the reader logical source and
+    read point names (PACKED_TAG_NO_INDEX if unknown).
+    The variable length fields are stored contiguously in the pool data
+    starting at Offset: ID (IDLen bytes), TID (TIDLen bytes), then XPC and PC
+    if the corresponding flags are set.
+*/
+typedef struct CAENRFIDPackedTag_s {
+    uint32_t            TimeStamp[2];
+    uint32_t            Offset;
+    int16_t             RSSI;
+    uint8_t             IDLen;
+    uint8_t             TIDLen;
+    uint8_t             Source;
+    uint8_t             ReadPoint;
+    uint8_t             Type;
+    uint8_t             Flags;
+} CAENRFIDPackedTag;
+
+/*
+    Pool of packed tags
+
+    Tags and Data are provided by the user through CAENRFID_TagPoolInit.
+*/
+typedef struct CAENRFIDTagPool_s {
+    CAENRFIDPackedTag*  Tags;
+    uint32_t            MaxTags;
+    uint32_t            NumTags;
+    uint8_t*            Data;
+    uint32_t            DataSize;
+    uint32_t            DataUsed;
+} CAENRFIDTagPool;
+
+/*
+    Select clause of CAENRFID_InventoryTagSelect: a mask as passed to
+    CAENRFID_InventoryTag and the operation applied to the tags matching
+    it (GROUP_SELECT_EQUAL ... GROUP_UNSELECT_NOT_EQUAL only). At most
+    CAENRFID_SELECT_MAX_CLAUSES clauses are allowed.
+*/
+#ifndef CAENRFID_SELECT_MAX_CLAUSES
+#define CAENRFID_SELECT_MAX_CLAUSES             8
+#endif
+
+typedef struct CAENRFIDSelectClause_s {
+    CAENRFIDSelUnselOptions Op;
+    uint16_t                Bank;
+    uint16_t                MaskBitAddress;
+    uint16_t                MaskBitLength;
+    uint8_t*                Mask;
+    uint16_t                MaskLen;
+} CAENRFIDSelectClause;
+
+/*
+    Host side filter
+
+    A CAENRFIDFilter passes the tags matching any of its rules, each rule
+    being a mask as passed to CAENRFID_InventoryTag. Rules sharing Bank,
+    MaskBitAddress and MaskBitLength form a group, looked up in a hash table
+    with a single probe whatever the number of rules in it: a tag costs one
+    lookup per group. At most CAENRFID_FILTER_MAX_GROUPS groups are allowed.
+
+    CAENRFID_FilterCompile also finds the longest run of bits on which all
+    the rules agree: passed to the reader as ReaderBank/ReaderMaskBitAddress/
+    ReaderMaskBitLength/ReaderMask, it drops on the reader side only tags the
+    filter would drop anyway (ReaderMaskBitLength is 0 if there is none).
+*/
+#ifndef CAENRFID_FILTER_MAX_GROUPS
+#define CAENRFID_FILTER_MAX_GROUPS              8
+#endif
+#define FILTER_MAX_MASK_LENGTH                  (PC_LENGTH + 2 + MAX_ID_LENGTH)
+#define FILTER_NO_RULE                          0xFFFFFFFF
+
+typedef struct CAENRFIDFilterRule_s {
+    uint16_t            Bank;
+    uint16_t            MaskBitAddress;
+    uint16_t            MaskBitLength;
+    uint8_t*            Mask;
+
+    uint32_t            _hash;
+    uint8_t             _group;
+} CAENRFIDFilterRule;
+
+/*
+    Rules of a group : For internal use only 
+*/
+typedef struct CAENRFIDFilterGroup_s {
+    uint16_t            _Bank;
+    uint16_t            _MaskBitAddress;
+    uint16_t            _MaskBitLength;
+} CAENRFIDFilterGroup;
+
+/*
+    Filter Struct
+
+    User should NOT modify the fields starting with an underscore.
+*/
+typedef struct CAENRFIDFilter_s {
+    CAENRFIDFilterRule* Rules;
+    uint32_t            NumRules;
+    uint32_t*           Slots;
+    uint32_t            NumSlots;
+    uint16_t            ReaderBank;
+    uint16_t            ReaderMaskBitAddress;
+    uint16_t            ReaderMaskBitLength;
+    uint8_t             ReaderMask[FILTER_MAX_MASK_LENGTH];
+    uint16_t            ReaderMaskLen;
+
+    CAENRFIDFilterGroup _groups[CAENRFID_FILTER_MAX_GROUPS];
+    uint8_t             _num_groups;
+} CAENRFIDFilter;
+
+/*
+    Tag de-duplication
+
+    A CAENRFIDDedup tracks the tags currently in the field, keyed on their
+    ID (and read point if DEDUP_BY_READPOINT is set), and turns the stream
+    of reads into events:
+    - CAENRFID_DEDUP_NEW   : first read of a tag.
+    - CAENRFID_DEDUP_MOVED : a tag has been read on another read point,
+                             at least HoldOffMs after its last event.
+    - CAENRFID_DEDUP_LOST  : a tag has not been read for LostMs.
+    Entries and Slots are provided by the user through CAENRFID_DedupInit,
+    IDs longer than CAENRFID_DEDUP_ID_LENGTH are refused.
+*/
+#ifndef CAENRFID_DEDUP_ID_LENGTH
+#define CAENRFID_DEDUP_ID_LENGTH                MAX_ID_LENGTH
+#endif
+#define DEDUP_BY_READPOINT                      0x0001
+#define DEDUP_NO_ENTRY                          0xFFFFFFFF
+
+typedef enum {
+    CAENRFID_DEDUP_NEW                          = 0,
+    CAENRFID_DEDUP_MOVED                        = 1,
+    CAENRFID_DEDUP_LOST                         = 2,
+} CAENRFIDDedupEventType;
+
+typedef struct CAENRFIDDedupEvent_s {
+    CAENRFIDDedupEventType  Type;
+    uint8_t                 ID[CAENRFID_DEDUP_ID_LENGTH];
+    uint16_t                Length;
+    uint8_t                 ReadPoint;      // index as in CAENRFIDPackedTag
+    uint8_t                 PrevReadPoint;  // CAENRFID_DEDUP_MOVED only
+    uint32_t                FirstSeen;
+    uint32_t                LastSeen;
+    uint32_t                Reads;
+} CAENRFIDDedupEvent;
+
+/*
+    Tracked tag : For internal use only 
+*/
+typedef struct CAENRFIDDedupEntry_s {
+    uint8_t             _ID[CAENRFID_DEDUP_ID_LENGTH];
+    uint8_t             _Length;
+    uint8_t             _ReadPoint;
+    uint32_t            _hash;
+    uint32_t            _first_seen;
+    uint32_t            _last_seen;
+    uint32_t            _reported;
+    uint32_t            _reads;
+    uint32_t            _prev;
+    uint32_t            _next;
+} CAENRFIDDedupEntry;
+
+/*
+    De-duplication Struct
+
+    User should NOT modify the fields starting with an underscore.
+*/
+typedef struct CAENRFIDDedup_s {
+    CAENRFIDDedupEntry* Entries;
+    uint32_t            MaxEntries;
+    uint32_t*           Slots;
+    uint32_t            NumSlots;
+    uint16_t            Flags;
+    uint32_t            HoldOffMs;
+    uint32_t            LostMs;
+    uint32_t            NumEntries;
+    uint32_t            Reads;
+    uint32_t            Suppressed;
+
+    uint32_t            _free;
+    uint32_t            _oldest;
+    uint32_t            _newest;
+} CAENRFIDDedup;
+
+/*
+    Inventory Parameters Struct : For internal use only 
+*/
+typedef struct CAENRFIDInventoryParams_s {
+    bool has_RSSI;
+    bool has_framed;
+    bool has_continuous;
+    bool has_compact;
+    bool has_TID;
+    bool has_event_trigger;
+    bool has_XPC;
+    bool has_PC;
+} CAENRFIDInventoryParams;
+
+struct CAENRFIDReader_s;
+
+/*
+    Framed tag decoder
+    WARNING : For internal use only
+*/
+typedef int16_t (*CAENRFIDFramedDecoder)(struct CAENRFIDReader_s* reader, bool* has_tag,
+                                         CAENRFIDTag* Tag, bool* has_result_code);
+
+/*
+    Value of the reader _connected field while it is connected, unlikely
+    to be found in uninitialised memory.
+*/
+#define CAENRFID_READER_CONNECTED               0x43524644
+
+/*
+    Reader Struct 
+
+    User should initialize the following fields:
+    - disconnect
+    - tx
+    - rx
+    - clear_rx_data
+    - enable_irqs
+    - disable_irqs
+
+    User may initialize the following fields, or set them to NULL:
+    - connect
+    - rx_some
+    
+    User should NOT modify the following fields:
+     - _port_handle
+     - _inventory_params
+     - _framed_decoder
+     - _cmdID
+     - _buffer
+     - _buffer_size
+     - _connected
+     - _buffer_held
+     - _rx_buffer
+     - _rx_rpos
+     - _rx_wpos
+*/
+typedef struct CAENRFIDReader_s {
+    /*
+    ---------------------------------------------------------------
+      _port_handle - An handle that identifies the reader port
+      For internal use only : do not modify.
+    ---------------------------------------------------------------
+    */
+    void*   _port_handle;
+
+    /*
+    ---------------------------------------------------------------
+     connect - Opens a connection with the reader. If NULL,
+               CAENRFID_Connect leaves the port as opened by the
+               application.
+    ---------------------------------------------------------------
+     Parameters:
+     [out] port_handle   :   handle to the reader port
+     [in]  port_type     :   the type of port 
+     [in]  port_params   :   the connection parameters
+     ---------------------------------------------------------------
+      Returns:
+       (0) : Success
+      (-1) : Failure
+    */
+    int16_t (*connect)(void* *port_handle, int16_t port_type, void* port_params);
+ 
+
+    /*
+    ---------------------------------------------------------------
+     disconnect - Closes the connection with the reader
+    ---------------------------------------------------------------
+     Parameters:
+     [in]  port_handle   :   handle to the reader port
+     ---------------------------------------------------------------
+      Returns:
+       (0) : Success
+      (-1) : Failure
+    */
+    int16_t (*disconnect)(void* port_handle);
+
+    /*
+    ---------------------------------------------------------------
+     tx - Transmits data to the reader
+    ---------------------------------------------------------------
+     Parameters:
+     [in]  port_handle   :   handle to the reader port
+     [in]  data          :   the bytes data to be sent to the reader
+     [in]  len           :   the number of bytes to be sent
+     ---------------------------------------------------------------
+      Returns:
+       (0) : Success
+      (-1) : Failure
+    */
+    int16_t (*tx)(void* port_handle, uint8_t* data, uint32_t len);
+
+    /*
+    ---------------------------------------------------------------
+     rx - Receives data from the reader
+    ---------------------------------------------------------------
+     Parameters:
+     [in]  port_handle   :   handle to the reader port
+     [out] data          :   the data received from the reader
+     [in]  len           :   the number of bytes to be received
+     [in]  ms_timeout    :   the timeout in milliseconds for 
+                             reception to be completed.
+     ---------------------------------------------------------------
+      Returns:
+       (0) : Success
+      (-1) : Failure
+    */
+    int16_t (*rx)(void* port_handle, uint8_t* data, uint32_t len, uint32_t ms_timeout);
+
+    /*
+    ---------------------------------------------------------------
+     rx_some - Receives the data available from the reader, 
+               waiting for at least one byte. Optional: if NULL,
+               rx is used instead.
+    ---------------------------------------------------------------
+     Parameters:
+     [in]  port_handle   :   handle to the reader port
+     [out] data          :   the data received from the reader
+     [in]  maxlen        :   the maximum number of bytes to be received
+     [in]  ms_timeout    :   the timeout in milliseconds for the
+                             first byte to be received.
+     ---------------------------------------------------------------
+      Returns:
+       (>0) : The number of bytes received
+        (0) : Timeout
+       (-1) : Failure
+    */
+    int32_t (*rx_some)(void* port_handle, uint8_t* data, uint32_t maxlen, uint32_t ms_timeout);
+
+    /*
+     ---------------------------------------------------------------
+     clear_rx_data - Clears data present in the receive buffer, 
+                     that is any data sent by the reader but not
+                     parsed.
+     ---------------------------------------------------------------
+     Parameters:
+     [in]  port_handle   :   handle to the reader port
+     ---------------------------------------------------------------
+     Returns:
+       (0) : Success
+      (-1) : Failure
+    */
+    int16_t (*clear_rx_data)(void* port_handle);
+
+    /*
+     ---------------------------------------------------------------
+     enable_irqs - Enables host interrupts not related to tx/rx
+                   communication with the reader.
+     ---------------------------------------------------------------
+     Parameters:
+     ---------------------------------------------------------------
+     Returns:
+    */
+    void    (*enable_irqs)(void); 
+
+    /*
+     ---------------------------------------------------------------
+     disable_irqs - Disables host interrupts not related to tx/rx
+                    communication with the reader.
+     ---------------------------------------------------------------
+     Parameters:
+     ---------------------------------------------------------------
+     Returns:
+    */
+    void    (*disable_irqs)(void);
+
+    /*
+    ---------------------------------------------------------------
+      inventory_params - A struct containing information about
+                         reader ongoing framed inventory.
+      WARNING : For internal use only - DO NOT MODIFY!!
+    ---------------------------------------------------------------
+    */
+    struct CAENRFIDInventoryParams_s  _inventory_params;
+
+    /*
+    ---------------------------------------------------------------
+      _framed_decoder - Parser of the tags of the ongoing framed
+                        inventory, chosen for its flags when the
+                        inventory starts.
+      WARNING : For internal use only - DO NOT MODIFY!!
+    ---------------------------------------------------------------
+    */
+    CAENRFIDFramedDecoder _framed_decoder;
+
+    /*
+    ---------------------------------------------------------------
+      _cmdID - CmdID of the next command sent to the reader, the
+               reply must carry the same value. Kept per reader, so
+               that different readers share no state.
+      WARNING : For internal use only - DO NOT MODIFY!!
+    ---------------------------------------------------------------
+    */
+    uint16_t  _cmdID;
+
+    /*
+    ---------------------------------------------------------------
+      _buffer - Scratch buffer every command is encoded into and
+                every reply is received into. Set up once by
+                CAENRFID_Connect, so the command path performs no
+                dynamic memory allocation, and freed by
+                CAENRFID_Disconnect.
+      _buffer_size - The size of _buffer in bytes.
+      _connected - CAENRFID_READER_CONNECTED from CAENRFID_Connect
+                   to CAENRFID_Disconnect: a reader connected again
+                   keeps its _buffer. Any other value, including
+                   whatever an uninitialised reader holds, means
+                   that _buffer is not allocated.
+      WARNING : For internal use only - DO NOT MODIFY!!
+    ---------------------------------------------------------------
+    */
+#ifdef CAENRFID_NO_HEAP
+    uint8_t   _buffer[CAENRFID_MAX_FRAME_LENGTH];
+#else
+    uint8_t*  _buffer;
+#endif
+    uint16_t  _buffer_size;
+    uint32_t  _connected;
+
+    /*
+    ---------------------------------------------------------------
+      _buffer_held - Set while a CAENRFIDTagFrame refers to the
+                     reply in _buffer: other commands are refused
+                     until it is released.
+      WARNING : For internal use only - DO NOT MODIFY!!
+    ---------------------------------------------------------------
+    */
+    bool      _buffer_held;
+
+    /*
+    ---------------------------------------------------------------
+      _rx_buffer - Buffer framed inventory data is received into,
+                   as many bytes as available at once when rx_some
+                   is set, so that a tag is usually parsed out of a
+                   single transport read.
+      _rx_rpos, _rx_wpos - Parsing and receiving positions in
+                   _rx_buffer.
+      WARNING : For internal use only - DO NOT MODIFY!!
+    ---------------------------------------------------------------
+    */
+    uint8_t   _rx_buffer[CAENRFID_RX_BUFFER_SIZE];
+    uint16_t  _rx_rpos;
+    uint16_t  _rx_wpos;
+
+#if CAENRFID_TEMPLATE_SLOTS > 0
+    /*
+    ---------------------------------------------------------------
+      _templates - Frames of the last fixed shape commands, with
+                   the parameters they were encoded from. A command
+                   sent again with the same parameters is copied
+                   from here and only gets a new CmdID.
+      _template_next - The slot to be replaced next.
+      WARNING : For internal use only - DO NOT MODIFY!!
+    ---------------------------------------------------------------
+    */
+    struct {
+        uint16_t  cmd;
+        uint16_t  key_len;
+        uint16_t  frame_len;
+        uint8_t   data[CAENRFID_TEMPLATE_LENGTH];
+    }         _templates[CAENRFID_TEMPLATE_SLOTS];
+    uint8_t   _template_next;
+#endif
+
+} CAENRFIDReader;
+
+/*
+    Inventory reply held in the reader buffer, see CAENRFID_InventoryTagFrame.
+
+    User should NOT modify the fields starting with an underscore.
+*/
+typedef struct CAENRFIDTagFrame_s {
+    CAENRFIDReader*                     _reader;
+    struct CAENRFIDInventoryParams_s    _params;
+    uint16_t                            _rpos;
+    uint16_t                            _size;
+} CAENRFIDTagFrame;
+
+/*
+    Callbacks of CAENRFID_InventoryTagStream, all of them receive ctx:
+    - on_tag       : called with each tag as soon as it has been received,
+                     Tag is only valid during the call. Returning false stops
+                     the inventory, the tags still received are discarded.
+                     Must be set.
+    - on_round_end : called with the result code reported by the reader at
+                     the end of the inventory. May be NULL.
+    - on_error     : called with the error code if the reply could not be
+                     received. May be NULL.
+*/
+typedef struct CAENRFIDInventoryCallbacks_s {
+    void*   ctx;
+    bool    (*on_tag)(void* ctx, const CAENRFIDTag* Tag);
+    void    (*on_round_end)(void* ctx, CAENRFIDErrorCodes result);
+    void    (*on_error)(void* ctx, CAENRFIDErrorCodes error);
+} CAENRFIDInventoryCallbacks;
+
+/*
+    Non-blocking reader Struct
+
+    Binds a connected CAENRFIDReader to an event loop owned by the user, who
+    performs the port I/O and pushes received bytes to the library. Commands
+    are started with the CAENRFID_Async* functions and their outcome is
+    delivered through the callbacks.
+
+    User should initialize the following fields after CAENRFID_AsyncInit
+    (unused callbacks may be left NULL):
+    - ctx
+    - reply
+    - tag
+    - inventory_end
+
+    User should NOT modify the fields starting with an underscore.
+*/
+typedef struct CAENRFIDAsync_s {
+    /*
+    ---------------------------------------------------------------
+     ctx - User data passed to the callbacks.
+    ---------------------------------------------------------------
+    */
+    void*   ctx;
+
+    /*
+    ---------------------------------------------------------------
+     reply - Called when the reply to a command started with
+             CAENRFID_AsyncSubmit is complete.
+    ---------------------------------------------------------------
+     Parameters:
+     [in]  ctx           :   the user data
+     [in]  result        :   CAENRFID_StatusOK or the reason why
+                             no reply was received
+     [in]  frame         :   the reply, header included. Valid
+                             until the next command is started.
+     [in]  len           :   the number of bytes in frame
+    */
+    void    (*reply)(void* ctx, CAENRFIDErrorCodes result, const uint8_t* frame, uint16_t len);
+
+    /*
+    ---------------------------------------------------------------
+     tag - Called for each tag received during an inventory
+           started with CAENRFID_AsyncInventoryTag.
+    ---------------------------------------------------------------
+     Parameters:
+     [in]  ctx           :   the user data
+     [in]  Tag           :   the detected tag
+    */
+    void    (*tag)(void* ctx, const CAENRFIDTag* Tag);
+
+    /*
+    ---------------------------------------------------------------
+     inventory_end - Called when an inventory started with
+                     CAENRFID_AsyncInventoryTag ends.
+    ---------------------------------------------------------------
+     Parameters:
+     [in]  ctx           :   the user data
+     [in]  result        :   the inventory result code
+    */
+    void    (*inventory_end)(void* ctx, CAENRFIDErrorCodes result);
+
+    /*
+    ---------------------------------------------------------------
+      _reader - The reader the commands are issued to.
+      _state - Current step of the ongoing command.
+      _cmdID - CmdID the reply must carry.
+      _tx_pos, _tx_len - Command bytes already sent and to be sent,
+                         the command is kept in the reader _buffer.
+      _rx_len, _rx_size - Reply bytes already received into the
+                          reader _buffer and reply length.
+      _abort - An inventory abort must be sent.
+      _inventory - The ongoing command is an inventory.
+      _params - The ongoing inventory parameters.
+      WARNING : For internal use only - DO NOT MODIFY!!
+    ---------------------------------------------------------------
+    */
+    CAENRFIDReader*                   _reader;
+    uint8_t                           _state;
+    uint16_t                          _cmdID;
+    uint16_t                          _tx_pos;
+    uint16_t                          _tx_len;
+    uint16_t                          _rx_len;
+    uint16_t                          _rx_size;
+    bool                              _abort;
+    bool                              _inventory;
+    struct CAENRFIDInventoryParams_s  _params;
+
+} CAENRFIDAsync;
+
+/*
+    Command in flight in a pipeline : For internal use only
+*/
+typedef struct CAENRFIDPipelineSlot_s {
+    uint8_t             State;
+    uint16_t            CmdID;
+    uint16_t            Command;
+    CAENRFIDErrorCodes  Result;
+    uint8_t*            Data;
+    uint16_t            Size;
+    uint16_t*           Len;
+} CAENRFIDPipelineSlot;
+
+/*
+    Pipeline Struct
+
+    Keeps up to a window of commands in flight on a reader, replies
+    being matched to commands by CmdID.
+    Initialized by CAENRFID_PipelineInit, user should NOT modify the 
+    fields starting with an underscore.
+*/
+typedef struct CAENRFIDPipeline_s {
+    CAENRFIDReader*       _reader;
+    uint16_t              _window;
+    uint16_t              _inflight;
+    CAENRFIDPipelineSlot  _slots[CAENRFID_PIPELINE_DEPTH];
+} CAENRFIDPipeline;
+
+
+
+
+#endif /* SRC_LIB_CAENRFIDTYPES_LIGHT_H_ */
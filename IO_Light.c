@@ -1,622 +1,838 @@
-/* --COPYRIGHT--,BSD
- * Copyright (c) 2022, CAEN RFID S.R.L.
- * All rights reserved.
- *
- * Redistribution and use in source and binary forms, with or without
- * modification, are permitted provided that the following conditions
- * are met:
- *
- * *  Redistributions of source code must retain the above copyright
- *    notice, this list of conditions and the following disclaimer.
- *
- * *  Redistributions in binary form must reproduce the above copyright
- *    notice, this list of conditions and the following disclaimer in the
- *    documentation and/or other materials provided with the distribution.
- *
- * *  Neither the name of CAEN RFID S.R.L. nor the names of
- *    its contributors may be used to endorse or promote products derived
- *    from this software without specific prior written permission.
- *
- * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
- * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
- * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
- * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
- * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
- * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
- * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
- * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
- * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
- * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
- * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
- * --/COPYRIGHT--*/
-
-#include <assert.h>
-#include <stdint.h>
-#include <stdlib.h>
-#include <string.h>
-#include "IO_Light.h"
-
-
-#define STANDARD_RX_MSEC_TMO (5000)
-#define FRAMED_RX_MSEC_TMO_FIRST (500)
-#define FRAMED_RX_MSEC_TMO_OTHER (5000)
-
-static char * AntName[] = {"Ant0","Ant1","Ant2","Ant3"};
-static char * SrcName[] = {"Source_0","Source_1","Source_2","Source_3"};
-
-static uint16_t get_short(uint8_t *buf)
-{
-    return ((((uint16_t) buf[0] & 0xFF) << 8) | (((uint16_t)buf[1]) & 0xFF));
-}
-
-static int16_t set_short(uint16_t value, uint8_t *buf)
-{
-    buf[0] = value >> 8;
-    buf[1] = value & 0xFF;
-    return 2;
-}
-
-static uint32_t get_long(uint8_t *buf)
-{
-    return((((uint32_t) buf[0] & 0xFF) << 24) |
-           (((uint32_t) buf[1] & 0xFF) << 16) |
-           (((uint32_t) buf[2] & 0xFF) <<  8) |
-           (((uint32_t) buf[3])& 0xFF));
-}
-
-static int16_t set_long(uint32_t value, uint8_t *buf)
-{
-    buf[0] = value >> 24;
-    buf[1] = value >> 16;
-    buf[2] = value >> 8;
-    buf[3] = value & 0xFF;
-    return 4;
-}
-
-static float get_float(uint8_t* buf)
-{
-    float fvalue = 0;
-    uint32_t ivalue = (((((uint32_t) buf[0] & 0xFF) << 24) |
-                        (((uint32_t) buf[1] & 0xFF) << 16) |
-                        (((uint32_t) buf[2] & 0xFF) <<  8) |
-                        (((uint32_t) buf[3])& 0xFF)));
-
-    memcpy(&fvalue, &ivalue, sizeof(ivalue));
-    return fvalue;
-}
-
-static int16_t receiveAVP(CAENRFIDReader* reader, IOBuffer_t* rxbuf, uint16_t ms_tmo)
-{
-    int16_t len = AVP_HEADLEN, idx = rxbuf->wpos;
-
-    if(len + idx > rxbuf->size) return(-1);
-    //Receive AVP header
-    if(reader->rx(reader->_port_handle, &rxbuf->memory[idx], len, ms_tmo) != 0) return (-1);
-    if(get_short(&rxbuf->memory[idx]) != 0) return (-1);
-    len = get_short(&rxbuf->memory[idx + 2]);
-    if(len + idx > rxbuf->size) return (-1);
-    len -= AVP_HEADLEN;
-    if(len < 0) return (-1);
-    idx += AVP_HEADLEN;
-    //Receive AVP value
-    if(reader->rx(reader->_port_handle, &rxbuf->memory[idx], len, ms_tmo) != 0) return (-1);
-    rxbuf->wpos = idx + len;
-
-    return (0);
-}
-
-void getAntNames(char ** Array[], int16_t* n)
-{
-    *Array=AntName;
-    *n=4;
-}
-
-void getSrcNames(char ** Array[], int16_t* n)
-{
-    *Array=SrcName;
-    *n=4;
-}
-
-void addHeader(uint16_t CmdID, IOBuffer_t* buf, uint16_t size)
-{
-    int16_t idx = 0;
-
-    assert(buf->wpos + HEADER_LEN <= buf->size);
-
-    idx += set_short(0x8001, &buf->memory[buf->wpos + idx]);
-    idx += set_short(CmdID,  &buf->memory[buf->wpos + idx]);
-    idx += set_long(CAEN_VENDOR,& buf->memory[buf->wpos + idx]);
-    idx += set_short(size, &buf->memory[buf->wpos + idx]);
-
-    buf->wpos += idx;
-}
-
-void addAVP(IOBuffer_t *buf, uint16_t len, uint16_t wtype, void *value)
-{
-    int16_t idx = 0;
-
-    assert(buf->wpos + AVP_HEADLEN + len <= buf->size);
-
-    idx += set_short(0, &buf->memory[buf->wpos + idx]); /* Reserved bits */
-    idx += set_short(AVP_HEADLEN + len, &buf->memory[buf->wpos + idx]);
-    idx += set_short(wtype, &buf->memory[buf->wpos + idx]);
-
-    switch (wtype) {
-    case AVP_COMMAND:
-    case AVP_RESULT_CODE:
-    case AVP_LENGTH:
-    case AVP_TAGADDRESS:
-    case AVP_TAGIDLEN:
-    case AVP_BITMASK:
-    case AVP_TAGTYPE:
-    case AVP_MEMBANK:
-    case AVP_RSSI:
-    case AVP_G2NSI:
-    case AVP_MODULATION:
-    case AVP_BOOLEAN:
-    case AVP_RFCHANNEL:
-    case AVP_RFREGULATION:
-        assert(len == sizeof(uint16_t));
-        set_short(*(uint16_t *)value, &buf->memory[buf->wpos + idx]);
-        break;
-    case AVP_PROTOCOL_NAME:
-    case AVP_POWER:
-    case AVP_G2PWD:
-    case AVP_CONFIGPARAMETER:
-    case AVP_CONFIGVALUE:
-    case AVP_PAYLOAD:
-    case AVP_IOREGISTER:
-    case AVP_BAUDRATE:
-    case AVP_DATABITS:
-    case AVP_STOPBITS:
-    case AVP_PARITY:
-    case AVP_FLOWCTRL:
-        assert(len == sizeof(uint32_t));
-        set_long(*(uint32_t *)value, &buf->memory[buf->wpos + idx]);
-        break;
-    case AVP_SOURCE_NAME:
-        assert(len <= MAX_LOGICAL_SOURCE_NAME);
-        memcpy(&buf->memory[buf->wpos + idx], (char *) value, len);
-        break;
-    case AVP_READPOINT_NAME:
-        assert(len <= MAX_READPOINT_NAME);
-        memcpy(&buf->memory[buf->wpos + idx], (char *) value, len);
-        break;
-    case AVP_TAGID:
-        assert(len <= MAX_ID_LENGTH);
-        memcpy(&buf->memory[buf->wpos + idx], (uint8_t *) value, len);
-        break;
-    case AVP_TAG_VALUE:
-        assert(len <= MAX_TAG_VALUE_LENGTH);
-        memcpy(&buf->memory[buf->wpos + idx], (uint8_t *) value, len);
-        break;
-    case AVP_SUBCMD:
-        assert(len == 1);
-        memcpy(&buf->memory[buf->wpos + idx], (uint8_t *)value, len);
-        break;
-    default:
-        assert(0);
-    }
-    idx += len;
-    buf->wpos += idx;
-}
-
-int16_t getAVP(IOBuffer_t *buf, uint16_t wtype, void *value)
-{
-    int16_t idx;
-    uint16_t len, rtype;
-
-    if(buf->rpos + AVP_HEADLEN > buf->size) return (-1);
-
-     /* First 2 bytes are reserved */
-    idx  = 2;
-    len = get_short(&buf->memory[buf->rpos + idx]);
-    idx += 2;
-    rtype = get_short(&buf->memory[buf->rpos + idx]);
-    idx += 2;
-    if(rtype != wtype) return (1);
-    if(buf->rpos + len > buf->size) return (-1);
-    buf->rpos += idx;
-    len -= AVP_HEADLEN;
-    switch (rtype) {
-        case AVP_RESULT_CODE:
-        case AVP_LENGTH:
-        case AVP_TAGIDLEN:
-        case AVP_TAGADDRESS:
-        case AVP_TAGTYPE:
-        case AVP_COMMAND:
-        case AVP_RSSI:
-        case AVP_MODULATION:
-        case AVP_BOOLEAN:
-        case AVP_RFCHANNEL:
-        case AVP_RFREGULATION:
-        case AVP_BITMASK:
-        case AVP_MEMBANK:
-            if(len != sizeof(uint16_t)) return (-1);
-            *(uint16_t *) value = get_short(&buf->memory[buf->rpos]);
-            break;
-        case AVP_PROTOCOL_NAME:
-        case AVP_POWER_GET:
-        case AVP_CONFIGVALUE:
-        case AVP_READPOINT_STATUS:
-        case AVP_IOREGISTER:
-            if(len != sizeof(uint32_t)) return (-1);
-            *(uint32_t *) value = get_long(&buf->memory[buf->rpos]);
-            break;
-        case AVP_TIMESTAMP:
-            if(len != 2*sizeof(uint32_t)) return (-1);
-            *(uint32_t *) value = get_long(&buf->memory[buf->rpos]);
-            *(((uint32_t *) value) + 1) = get_long(&buf->memory[buf->rpos + 4]);
-            break;
-        case AVP_POWER_VSWR:
-            if(len != sizeof(uint32_t)) return (-1);
-            *(float *)value = get_float(&buf->memory[buf->rpos]);
-            break;
-        case AVP_TAGID:
-            if(len > MAX_ID_LENGTH) return (-1);
-            memcpy((uint8_t *) value, &buf->memory[buf->rpos], len);
-            break;
-        case AVP_SOURCE_NAME:
-            if(len > MAX_LOGICAL_SOURCE_NAME) return (-1);
-            memcpy((char *) value, &buf->memory[buf->rpos], len);
-            break;
-        case AVP_READPOINT_NAME:
-            if(len > MAX_READPOINT_NAME) return (-1);
-            memcpy((char *) value, &buf->memory[buf->rpos], len);
-            break;
-        case AVP_TAG_VALUE:
-            //if(len > MAX_TAG_VALUE_LENGTH) return (-1); //<--Commented out because some custom commands
-                                                          //   can exceed the MAX_TAG_VALUE_LENGTH limit
-            memcpy((uint8_t *) value, &buf->memory[buf->rpos], len);
-            break;
-        case AVP_XPC:
-            if(len != XPC_LENGTH) return (-1);
-            memcpy((uint8_t *) value, &buf->memory[buf->rpos], len);
-            break;
-        case AVP_PC:
-            if(len != PC_LENGTH) return (-1);
-            memcpy((uint8_t *) value, &buf->memory[buf->rpos], len);
-            break;
-        case AVP_READERINFO:
-            if(len > MAX_MODEL_LENGTH + 1 + MAX_SERIAL_LENGTH) return (-1);
-            memcpy((char *) value, &buf->memory[buf->rpos], len);
-            break;
-        case AVP_GETFWRELEASE:
-            if(len > MAX_FWREL_LENGTH) return (-1);
-            memcpy((uint8_t *)value, &buf->memory[buf->rpos], len);
-            break;
-        default:
-            return (-1);
-    }
-    buf->rpos += len;
-    return (0);
-}
-
-int16_t sendReceive(CAENRFIDReader* reader, IOBuffer_t* txbuf, IOBuffer_t* rxbuf)
-{
-    int16_t tmp = 0;
-    uint16_t sentCmdID;
-    uint8_t header[HEADER_LEN] = {0};
-
-    sentCmdID = get_short(txbuf->memory + 2);
-    reader->clear_rx_data(reader->_port_handle);
-    //send command
-    //--note : time interval between bytes of command must
-    // not exceed the reader timeout value, otherwise reader 
-    // will disregard command
-    reader->disable_irqs();
-    tmp = reader->tx(reader->_port_handle, txbuf->memory, txbuf->size);
-    reader->enable_irqs();
-    rxbuf->size = 0;
-    if(tmp != 0)
-    {
-        return CAENRFID_CommunicationError;
-    }
-
-    //get protocol header
-    if(reader->rx(reader->_port_handle, header, HEADER_LEN, STANDARD_RX_MSEC_TMO) != 0)
-    {
-        return CAENRFID_CommunicationError;
-    }
-
-    //verify header
-    uint16_t TxVer    = get_short(header);
-    uint16_t CmdID    = get_short(header + 2);
-    uint32_t VendorID = get_long(header + 4);
-    uint16_t Length   = get_short(header + 8);
-
-    if(Length == 0) Length = HEADER_LEN + sizeAVP(AVP_COMMAND, sizeof(uint16_t));
-    if((TxVer != 0x0001) ||
-       (VendorID != CAEN_VENDOR)||
-       (CmdID != sentCmdID) ||
-       (Length < HEADER_LEN)
-       )
-    {
-        return CAENRFID_CommunicationError;
-    }
-
-    if((rxbuf->memory = realloc(rxbuf->memory, Length)) == NULL)
-    {
-        return CAENRFID_OutOfMemoryError;
-    }
-    memcpy(header, &rxbuf->memory[rxbuf->wpos], HEADER_LEN);
-    rxbuf->size = Length;
-    rxbuf->wpos = HEADER_LEN;
-    rxbuf->rpos = 0;
-    //get rest of data
-    Length -= HEADER_LEN;
-    if(Length != 0)
-    {
-        if(reader->rx(reader->_port_handle, &rxbuf->memory[rxbuf->wpos], Length, STANDARD_RX_MSEC_TMO) != 0)
-        {
-            rxbuf->size = 0;
-            rxbuf->wpos = 0;
-            free(rxbuf->memory);
-            rxbuf->memory = NULL;
-            return CAENRFID_CommunicationError;
-        }
-        rxbuf->wpos += Length;
-    }
-
-    return CAENRFID_StatusOK;
-}
-
-int16_t sendAbort(CAENRFIDReader* reader)
-{
-    uint8_t abort = UART_ABORT;
-
-    if(reader->tx(reader->_port_handle, &abort, sizeof(abort)) != 0) return CAENRFID_CommunicationError;
-    return CAENRFID_StatusOK;
-}
-
-int16_t receiveFramedTag(CAENRFIDReader* reader, bool* has_tag, CAENRFIDTag* Tag,
-                         bool* has_result_code)
-{
-    int16_t ret = CAENRFID_LibraryError, pos;
-    uint16_t type;
-    uint8_t buf[AVP_HEADLEN + MAX_ID_LENGTH];  //getting AVPs one by one, AVP_ID is the largest we're expecting
-    IOBuffer_t rxbuf;
-    uint32_t tmo = FRAMED_RX_MSEC_TMO_FIRST;
-    bool nextAVP = true;
-
-    enum {
-     STATE_FIRST_AVP_RECEIVED = 0,
-     STATE_GET_SOURCE,
-     STATE_GET_READPOINT,
-     STATE_GET_TIMESTAMP,
-     STATE_GET_TYPE,
-     STATE_GET_ID_LENGTH,
-     STATE_GET_ID,
-     STATE_GET_RSSI,
-     STATE_GET_TID_LENGTH,
-     STATE_GET_TID,
-     STATE_GET_XPC,
-     STATE_GET_PC,
-     STATE_GET_RESULT,
-     STATE_TAG_DONE,
-     STATE_EXIT_DONE,
-    } state = STATE_FIRST_AVP_RECEIVED;
-
-    rxbuf.size = sizeof(buf);
-    rxbuf.memory = buf;
-
-    *has_tag = false;
-    *has_result_code = false;
-    while(1)
-    {
-        if(nextAVP)
-        {
-            rxbuf.rpos = 0;
-            rxbuf.wpos = 0;
-            if(receiveAVP(reader, &rxbuf, tmo) != 0)
-            {
-                nextAVP = false;
-                if(state == STATE_FIRST_AVP_RECEIVED)
-                {
-                    ret = CAENRFID_StatusOK;
-                }
-                else
-                {
-                    ret = CAENRFID_CommunicationError;
-                }
-                state = STATE_EXIT_DONE;
-            }
-        }
-
-        switch(state)
-        {
-        case STATE_FIRST_AVP_RECEIVED:
-            tmo = FRAMED_RX_MSEC_TMO_OTHER;
-            if(reader->_inventory_params.has_compact) state = STATE_GET_ID;
-            else state = STATE_GET_SOURCE;
-            nextAVP = false;
-            break;
-        case STATE_GET_SOURCE:
-            if(getAVP(&rxbuf, AVP_SOURCE_NAME, Tag->LogicalSource) != 0)
-            {
-                nextAVP = false;
-                state = STATE_GET_RESULT;
-                break;
-            }
-            nextAVP = true;
-            state = STATE_GET_READPOINT;
-            break;
-        case STATE_GET_READPOINT:
-            if(getAVP(&rxbuf, AVP_READPOINT_NAME, Tag->ReadPoint) != 0)
-            {
-                nextAVP = false;
-                state = STATE_GET_RESULT;
-                break;
-            }
-            state = STATE_GET_TIMESTAMP;
-            break;
-        case STATE_GET_TIMESTAMP:
-            if(getAVP(&rxbuf, AVP_TIMESTAMP, Tag->TimeStamp) != 0)
-            {
-                nextAVP = false;
-                state = STATE_GET_RESULT;
-                break;
-            }
-            state = STATE_GET_TYPE;
-            break;
-        case STATE_GET_TYPE:
-            if(getAVP(&rxbuf, AVP_TAGTYPE, &type) != 0)
-            {
-                nextAVP = false;
-                state = STATE_GET_RESULT;
-                break;
-            }
-            Tag->Type = (CAENRFIDProtocol) type;
-            state = STATE_GET_ID_LENGTH;
-            break;
-        case STATE_GET_ID_LENGTH:
-            if(getAVP(&rxbuf, AVP_TAGIDLEN, &Tag->Length) != 0)
-            {
-                nextAVP = false;
-                state = STATE_GET_RESULT;
-                break;
-            }
-            else if(Tag->Length > MAX_ID_LENGTH)
-            {
-                nextAVP = false;
-                ret = CAENRFID_LibraryError;
-                state = STATE_EXIT_DONE;
-                break;
-            }
-            state = STATE_GET_ID;
-            break;
-        case STATE_GET_ID:
-            if(reader->_inventory_params.has_compact)
-            {
-                pos = rxbuf.rpos;
-                if(getAVP(&rxbuf, AVP_TAGID, Tag->ID) != 0)
-                {
-                    nextAVP = false;
-                    state = STATE_GET_RESULT;
-                    break;
-                }
-                Tag->Length = (rxbuf.rpos - pos) - AVP_HEADLEN;
-            }
-            else
-            {
-                if(getAVP(&rxbuf, AVP_TAGID, Tag->ID) != 0)
-                {
-                    nextAVP = false;
-                    state = STATE_GET_RESULT;
-                    break;
-                }
-            }
-            if(reader->_inventory_params.has_RSSI) state = STATE_GET_RSSI;
-            else if(reader->_inventory_params.has_TID) state = STATE_GET_TID_LENGTH;
-            else if(reader->_inventory_params.has_XPC) state = STATE_GET_XPC;
-            else if(reader->_inventory_params.has_PC) state = STATE_GET_PC;
-            else
-            {
-                nextAVP = false;
-                state = STATE_TAG_DONE;
-                break;
-            }
-            nextAVP = true;
-            break;
-        case STATE_GET_RESULT:
-            if(getAVP(&rxbuf, AVP_RESULT_CODE,  &ret) != 0)
-            {
-                ret = CAENRFID_LibraryError;
-            }
-            else
-            {
-                *has_result_code = true;
-            }
-            nextAVP = false;
-            state = STATE_EXIT_DONE;
-            break;
-        case STATE_TAG_DONE:
-            *has_tag = true;
-            ret = CAENRFID_StatusOK;
-        case STATE_EXIT_DONE:
-            return (ret);
-        case STATE_GET_RSSI:
-            if(getAVP(&rxbuf, AVP_RSSI, &Tag->RSSI) != 0)
-            {
-                nextAVP = false;
-                state = STATE_GET_RESULT;
-                break;
-            }
-            if(reader->_inventory_params.has_TID) state = STATE_GET_TID_LENGTH;
-            else if(reader->_inventory_params.has_XPC) state = STATE_GET_XPC;
-            else if(reader->_inventory_params.has_PC) state = STATE_GET_PC;
-            else
-            {
-                nextAVP = false;
-                state = STATE_TAG_DONE;
-            }
-            break;
-        case STATE_GET_TID_LENGTH:
-            if(getAVP(&rxbuf, AVP_LENGTH, &Tag->TIDLen) != 0) 
-            {
-                nextAVP = false;
-                state = STATE_GET_RESULT;
-                break;
-            }
-            else if(Tag->TIDLen > MAX_TID_SIZE)
-            {
-                nextAVP = false;
-                ret = CAENRFID_LibraryError;
-                state = STATE_EXIT_DONE;
-                break;
-            }
-            if(Tag->TIDLen > 0) state = STATE_GET_TID;
-            else if(reader->_inventory_params.has_XPC) state = STATE_GET_XPC;
-            else if(reader->_inventory_params.has_PC) state = STATE_GET_PC;
-            else
-            {
-                nextAVP = false;
-                state = STATE_TAG_DONE;
-            }
-            break;
-        case STATE_GET_TID:
-            if(getAVP(&rxbuf, AVP_TAG_VALUE, Tag->TID) != 0)
-            {
-                nextAVP = false;
-                state = STATE_GET_RESULT;
-                break;
-            }
-            if(reader->_inventory_params.has_XPC) state = STATE_GET_XPC;
-            else if(reader->_inventory_params.has_PC) state = STATE_GET_PC;
-            else
-            {
-                nextAVP = false;
-                state = STATE_TAG_DONE;
-            }
-            break;
-        case STATE_GET_XPC:
-            if(getAVP(&rxbuf, AVP_XPC, Tag->XPC) != 0)
-            {
-                nextAVP = false;
-                state = STATE_GET_RESULT;
-                break;
-            }
-            if(reader->_inventory_params.has_PC) state = STATE_GET_PC;
-            else
-            {
-                nextAVP = false;
-                state = STATE_TAG_DONE;
-            }
-            break;
-        case STATE_GET_PC:
-            if(getAVP(&rxbuf, AVP_PC, Tag->PC) != 0)
-            {
-                nextAVP = false;
-                state = STATE_GET_RESULT;
-            }
-            else
-            {
-                nextAVP = false;
-                state = STATE_TAG_DONE;
-            }
-            break;
-        default:
-            return CAENRFID_LibraryError;
-        }
-    }
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2022, CAEN RFID S.R.L.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of CAEN RFID S.R.L. nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "IO_Light.h"
+
+
+#define STANDARD_RX_MSEC_TMO (5000)
+#define FRAMED_RX_MSEC_TMO_FIRST (500)
+#define FRAMED_RX_MSEC_TMO_OTHER (5000)
+
+static char * AntName[] = {"Ant0","Ant1","Ant2","Ant3"};
+static char * SrcName[] = {"Source_0","Source_1","Source_2","Source_3"};
+
+typedef struct AVPDesc
+{
+    uint8_t         kind;
+    uint16_t        min;
+    uint16_t        max;
+} AVPDesc_t;
+
+// attributes descriptors indexed by type, built from AVP_DESCRIPTORS:
+// numbers and fixed strings have min == max, other strings min == 0
+#define AVP_WIDTH(kind) (((kind) == AVP_KIND_SHORT) ? sizeof(uint16_t) : \
+                         ((kind) == AVP_KIND_LONG2) ? 2 * sizeof(uint32_t) : sizeof(uint32_t))
+#define AVP_DESC(type, kind, len) \
+    [type] = {kind, ((kind) == AVP_KIND_BYTES) ? 0 : ((kind) == AVP_KIND_FIXED) ? (len) : AVP_WIDTH(kind), \
+                    ((kind) >= AVP_KIND_BYTES) ? (len) : AVP_WIDTH(kind)},
+static const AVPDesc_t AVPDesc[AVP_TYPES] = {
+    AVP_DESCRIPTORS(AVP_DESC)
+};
+#undef AVP_DESC
+#undef AVP_WIDTH
+
+static uint16_t get_short(uint8_t *buf)
+{
+    return ((((uint16_t) buf[0] & 0xFF) << 8) | (((uint16_t)buf[1]) & 0xFF));
+}
+
+static int16_t set_short(uint16_t value, uint8_t *buf)
+{
+    buf[0] = value >> 8;
+    buf[1] = value & 0xFF;
+    return 2;
+}
+
+static uint32_t get_long(uint8_t *buf)
+{
+    return((((uint32_t) buf[0] & 0xFF) << 24) |
+           (((uint32_t) buf[1] & 0xFF) << 16) |
+           (((uint32_t) buf[2] & 0xFF) <<  8) |
+           (((uint32_t) buf[3])& 0xFF));
+}
+
+static int16_t set_long(uint32_t value, uint8_t *buf)
+{
+    buf[0] = value >> 24;
+    buf[1] = value >> 16;
+    buf[2] = value >> 8;
+    buf[3] = value & 0xFF;
+    return 4;
+}
+
+static float get_float(uint8_t* buf)
+{
+    float fvalue = 0;
+    uint32_t ivalue = (((((uint32_t) buf[0] & 0xFF) << 24) |
+                        (((uint32_t) buf[1] & 0xFF) << 16) |
+                        (((uint32_t) buf[2] & 0xFF) <<  8) |
+                        (((uint32_t) buf[3])& 0xFF)));
+
+    memcpy(&fvalue, &ivalue, sizeof(ivalue));
+    return fvalue;
+}
+
+static int16_t fillRx(CAENRFIDReader* reader, uint16_t len, uint32_t ms_tmo)
+{
+    uint16_t avail = reader->_rx_wpos - reader->_rx_rpos;
+    int32_t n;
+
+    if(len > sizeof(reader->_rx_buffer)) return (-1);
+    if(avail >= len) return (0);
+    //move pending bytes to the start, so that len bytes fit contiguously
+    if(reader->_rx_rpos + len > sizeof(reader->_rx_buffer))
+    {
+        memmove(reader->_rx_buffer, &reader->_rx_buffer[reader->_rx_rpos], avail);
+        reader->_rx_rpos = 0;
+        reader->_rx_wpos = avail;
+    }
+    while(avail < len)
+    {
+        if(reader->rx_some != NULL)
+        {
+            n = reader->rx_some(reader->_port_handle, &reader->_rx_buffer[reader->_rx_wpos],
+                                sizeof(reader->_rx_buffer) - reader->_rx_wpos, ms_tmo);
+            if(n <= 0) return (-1);
+        }
+        else
+        {
+            n = len - avail;
+            if(reader->rx(reader->_port_handle, &reader->_rx_buffer[reader->_rx_wpos], n, ms_tmo) != 0) return (-1);
+        }
+        reader->_rx_wpos += n;
+        avail += n;
+    }
+    return (0);
+}
+
+static int16_t receiveAVP(CAENRFIDReader* reader, IOBuffer_t* rxbuf, uint16_t ms_tmo)
+{
+    uint16_t len;
+
+    //Receive AVP header
+    if(fillRx(reader, AVP_HEADLEN, ms_tmo) != 0) return (-1);
+    if(get_short(&reader->_rx_buffer[reader->_rx_rpos]) != 0) return (-1);
+    len = get_short(&reader->_rx_buffer[reader->_rx_rpos + 2]);
+    if(len < AVP_HEADLEN) return (-1);
+    //Receive AVP value
+    if(fillRx(reader, len, ms_tmo) != 0) return (-1);
+    //the AVP is parsed in place, it stays valid until next call
+    rxbuf->memory = &reader->_rx_buffer[reader->_rx_rpos];
+    rxbuf->size = len;
+    rxbuf->rpos = 0;
+    rxbuf->wpos = len;
+    reader->_rx_rpos += len;
+
+    return (0);
+}
+
+void getAntNames(char ** Array[], int16_t* n)
+{
+    *Array=AntName;
+    *n=4;
+}
+
+void getSrcNames(char ** Array[], int16_t* n)
+{
+    *Array=SrcName;
+    *n=4;
+}
+
+int16_t attachBuffer(CAENRFIDReader* reader, IOBuffer_t* buf)
+{
+    // buf->size holds the length of the frame about to be encoded
+    if(reader->_buffer_held) return CAENRFID_ReaderBusy;
+    if(reader->_buffer_size < buf->size) return CAENRFID_OutOfMemoryError;
+    buf->memory = reader->_buffer;
+    buf->rpos = 0;
+    buf->wpos = 0;
+    return CAENRFID_StatusOK;
+}
+
+void addHeader(uint16_t CmdID, IOBuffer_t* buf, uint16_t size)
+{
+    int16_t idx = 0;
+
+    assert(buf->wpos + HEADER_LEN <= buf->size);
+
+    idx += set_short(0x8001, &buf->memory[buf->wpos + idx]);
+    idx += set_short(CmdID,  &buf->memory[buf->wpos + idx]);
+    idx += set_long(CAEN_VENDOR,& buf->memory[buf->wpos + idx]);
+    idx += set_short(size, &buf->memory[buf->wpos + idx]);
+
+    buf->wpos += idx;
+}
+
+void addAVP(IOBuffer_t *buf, uint16_t len, uint16_t wtype, void *value)
+{
+    const AVPDesc_t* desc = &AVPDesc[wtype & (AVP_TYPES - 1)];
+    uint8_t* p = &buf->memory[buf->wpos];
+
+    assert(buf->wpos + AVP_HEADLEN + len <= buf->size);
+    assert((wtype < AVP_TYPES) && (desc->kind != AVP_KIND_NONE));
+    assert((len >= desc->min) && (len <= desc->max));
+
+    set_short(0, &p[0]); /* Reserved bits */
+    set_short(AVP_HEADLEN + len, &p[2]);
+    set_short(wtype, &p[4]);
+    p += AVP_HEADLEN;
+
+    switch (desc->kind) {
+    case AVP_KIND_SHORT:
+        set_short(*(uint16_t *)value, p);
+        break;
+    case AVP_KIND_LONG:
+    case AVP_KIND_FLOAT:
+        set_long(*(uint32_t *)value, p);
+        break;
+    case AVP_KIND_LONG2:
+        set_long(*(uint32_t *)value, p);
+        set_long(*(((uint32_t *)value) + 1), p + 4);
+        break;
+    default:
+        memcpy(p, value, len);
+        break;
+    }
+    buf->wpos += AVP_HEADLEN + len;
+}
+
+void addBytes(IOBuffer_t *buf, const uint8_t *data, uint16_t len)
+{
+    // data are attributes already encoded by addAVP
+    assert(buf->wpos + len <= buf->size);
+
+    memcpy(&buf->memory[buf->wpos], data, len);
+    buf->wpos += len;
+}
+
+void clearTemplates(CAENRFIDReader* reader)
+{
+#if CAENRFID_TEMPLATE_SLOTS > 0
+    uint8_t i;
+
+    for(i = 0; i < CAENRFID_TEMPLATE_SLOTS; i++)
+    {
+        reader->_templates[i].frame_len = 0;
+    }
+    reader->_template_next = 0;
+#endif
+}
+
+bool getTemplate(CAENRFIDReader* reader, IOBuffer_t* buf, uint16_t cmd, const void* key, uint16_t key_len)
+{
+#if CAENRFID_TEMPLATE_SLOTS > 0
+    uint8_t i;
+
+    // buf is attached and sized for the frame the parameters in key encode to
+    for(i = 0; i < CAENRFID_TEMPLATE_SLOTS; i++)
+    {
+        if((reader->_templates[i].frame_len == buf->size) &&
+           (reader->_templates[i].cmd == cmd) &&
+           (reader->_templates[i].key_len == key_len) &&
+           ((key_len == 0) || (memcmp(reader->_templates[i].data, key, key_len) == 0)))
+        {
+            memcpy(buf->memory, &reader->_templates[i].data[key_len], buf->size);
+            set_short(reader->_cmdID++, &buf->memory[2]);
+            buf->wpos = buf->size;
+            return true;
+        }
+    }
+#endif
+    return false;
+}
+
+void putTemplate(CAENRFIDReader* reader, const IOBuffer_t* buf, uint16_t cmd, const void* key, uint16_t key_len)
+{
+#if CAENRFID_TEMPLATE_SLOTS > 0
+    uint8_t i = reader->_template_next;
+
+    // frames too long for a slot are encoded on every call
+    if((uint32_t)key_len + buf->size > CAENRFID_TEMPLATE_LENGTH) return;
+    reader->_templates[i].cmd = cmd;
+    reader->_templates[i].key_len = key_len;
+    reader->_templates[i].frame_len = buf->size;
+    if(key_len != 0) memcpy(reader->_templates[i].data, key, key_len);
+    memcpy(&reader->_templates[i].data[key_len], buf->memory, buf->size);
+    reader->_template_next = (uint8_t)((i + 1) % CAENRFID_TEMPLATE_SLOTS);
+#endif
+}
+
+static void decodeValue(uint8_t kind, uint8_t *p, uint16_t len, void *value)
+{
+    switch (kind) {
+    case AVP_KIND_SHORT:
+        *(uint16_t *) value = get_short(p);
+        break;
+    case AVP_KIND_LONG:
+        *(uint32_t *) value = get_long(p);
+        break;
+    case AVP_KIND_FLOAT:
+        *(float *) value = get_float(p);
+        break;
+    case AVP_KIND_LONG2:
+        *(uint32_t *) value = get_long(p);
+        *(((uint32_t *) value) + 1) = get_long(p + 4);
+        break;
+    default:
+        memcpy(value, p, len);
+        break;
+    }
+}
+
+int16_t getAVP(IOBuffer_t *buf, uint16_t wtype, void *value)
+{
+    const AVPDesc_t* desc;
+    uint8_t* p = &buf->memory[buf->rpos];
+    uint16_t len;
+
+    if(buf->rpos + AVP_HEADLEN > buf->size) return (-1);
+
+     /* First 2 bytes are reserved */
+    len = get_short(&p[2]);
+    if(get_short(&p[4]) != wtype) return (1);
+    if(buf->rpos + len > buf->size) return (-1);
+    if(wtype >= AVP_TYPES) return (-1);
+    desc = &AVPDesc[wtype];
+    len -= AVP_HEADLEN;
+    if((desc->kind == AVP_KIND_NONE) || (len < desc->min) || (len > desc->max)) return (-1);
+
+    decodeValue(desc->kind, p + AVP_HEADLEN, len, value);
+    buf->rpos += AVP_HEADLEN + len;
+    return (0);
+}
+
+static uint16_t indexSlot(AVPIndex_t *index, uint16_t type)
+{
+    uint16_t slot = type & (AVP_INDEX_SIZE - 1);
+
+    //open addressing: the slot holding type, or the free one ending its probes
+    while((index->type[slot] != 0) && (index->type[slot] != type))
+    {
+        slot = (slot + 1) & (AVP_INDEX_SIZE - 1);
+    }
+    return (slot);
+}
+
+int16_t scanAVPs(IOBuffer_t *buf, AVPIndex_t *index)
+{
+    const AVPDesc_t* desc;
+    uint16_t pos, len, type, slot;
+
+    if(index != NULL)
+    {
+        memset(index, 0, sizeof(AVPIndex_t));
+        index->buf = buf;
+        index->start = buf->rpos;
+    }
+    //every AVP up to the end of the frame must be well formed
+    for(pos = buf->rpos; pos < buf->size; pos += len)
+    {
+        if(pos + AVP_HEADLEN > buf->size) return (-1);
+        len = get_short(&buf->memory[pos + 2]);
+        type = get_short(&buf->memory[pos + 4]);
+        if((len < AVP_HEADLEN) || (pos + len > buf->size)) return (-1);
+        if(type >= AVP_TYPES) continue;
+        desc = &AVPDesc[type];
+        if((desc->kind != AVP_KIND_NONE) &&
+           ((len - AVP_HEADLEN < desc->min) || (len - AVP_HEADLEN > desc->max))) return (-1);
+        if((index == NULL) || (type == 0)) continue;
+        //only the first AVP of each type is recorded
+        slot = indexSlot(index, type);
+        if(index->type[slot] != 0) continue;
+        if(index->count == AVP_INDEX_SIZE - 1)
+        {
+            //keep a free slot to end the probes, lookups of the types
+            //left out walk the frame
+            index->full = true;
+            continue;
+        }
+        index->type[slot] = (uint8_t) type;
+        index->pos[slot] = pos;
+        index->count++;
+    }
+    return (0);
+}
+
+int16_t findAVP(AVPIndex_t *index, uint16_t wtype, void *value)
+{
+    IOBuffer_t* buf = index->buf;
+    uint16_t slot, pos, len;
+
+    if((wtype == 0) || (wtype >= AVP_TYPES) || (AVPDesc[wtype].kind == AVP_KIND_NONE)) return (-1);
+    slot = indexSlot(index, wtype);
+    if(index->type[slot] != 0)
+    {
+        pos = index->pos[slot];
+    }
+    else
+    {
+        if(!index->full) return (1);
+        for(pos = index->start; pos < buf->size; pos += get_short(&buf->memory[pos + 2]))
+        {
+            if(get_short(&buf->memory[pos + 4]) == wtype) break;
+        }
+        if(pos >= buf->size) return (1);
+    }
+    //the AVP has been validated by scanAVPs
+    len = get_short(&buf->memory[pos + 2]) - AVP_HEADLEN;
+    decodeValue(AVPDesc[wtype].kind, &buf->memory[pos + AVP_HEADLEN], len, value);
+    return (0);
+}
+
+static int16_t takeAVP(IOBuffer_t *buf, uint16_t wtype, void *value)
+{
+    uint8_t* p = &buf->memory[buf->rpos];
+    uint16_t len;
+
+    //the frame has been validated by scanAVPs, only the type is checked
+    if((buf->rpos >= buf->size) || (get_short(&p[4]) != wtype)) return (1);
+    len = get_short(&p[2]);
+    decodeValue(AVPDesc[wtype].kind, p + AVP_HEADLEN, len - AVP_HEADLEN, value);
+    buf->rpos += len;
+    return (0);
+}
+
+static int16_t parseTag(IOBuffer_t *buf, CAENRFIDInventoryParams* params, CAENRFIDTag* Tag,
+                        int16_t (*get)(IOBuffer_t *, uint16_t, void *))
+{
+    uint16_t pos = buf->rpos, type = 0;
+
+    memset(Tag, 0, sizeof(*Tag));
+    if(!params->has_compact)
+    {
+        if(get(buf, AVP_SOURCE_NAME, Tag->LogicalSource) != 0) goto not_a_tag;
+        if(get(buf, AVP_READPOINT_NAME, Tag->ReadPoint) != 0) goto not_a_tag;
+        if(get(buf, AVP_TIMESTAMP, Tag->TimeStamp) != 0) goto not_a_tag;
+        if(get(buf, AVP_TAGTYPE, &type) != 0) goto not_a_tag;
+        Tag->Type = (CAENRFIDProtocol) type;
+        if(get(buf, AVP_TAGIDLEN, &Tag->Length) != 0) goto not_a_tag;
+        if(get(buf, AVP_TAGID, Tag->ID) != 0) goto not_a_tag;
+    }
+    else
+    {
+        if(get(buf, AVP_TAGID, Tag->ID) != 0) goto not_a_tag;
+        Tag->Length = (buf->rpos - pos) - AVP_HEADLEN;
+    }
+    if(params->has_RSSI)
+    {
+        if(get(buf, AVP_RSSI, &Tag->RSSI) != 0) goto not_a_tag;
+    }
+    if(params->has_TID)
+    {
+        if(get(buf, AVP_LENGTH, &Tag->TIDLen) != 0) goto not_a_tag;
+        if(Tag->TIDLen)
+        {
+            //AVP_TAG_VALUE length is not bounded by getAVP
+            if((buf->rpos + AVP_HEADLEN <= buf->size) &&
+               (get_short(&buf->memory[buf->rpos + 2]) > AVP_HEADLEN + MAX_TID_SIZE)) goto not_a_tag;
+            if(get(buf, AVP_TAG_VALUE, Tag->TID) != 0) goto not_a_tag;
+        }
+    }
+    if(params->has_XPC)
+    {
+        if(get(buf, AVP_XPC, Tag->XPC) != 0) goto not_a_tag;
+    }
+    if(params->has_PC)
+    {
+        if(get(buf, AVP_PC, Tag->PC) != 0) goto not_a_tag;
+    }
+    return (0);
+
+    not_a_tag:
+    //rewind, so that the caller can look for the result code
+    buf->rpos = pos;
+    return (1);
+}
+
+int16_t getTag(IOBuffer_t *buf, CAENRFIDInventoryParams* params, CAENRFIDTag* Tag)
+{
+    return parseTag(buf, params, Tag, getAVP);
+}
+
+int16_t getScannedTag(IOBuffer_t *buf, CAENRFIDInventoryParams* params, CAENRFIDTag* Tag)
+{
+    return parseTag(buf, params, Tag, takeAVP);
+}
+
+static const uint8_t* takeValue(IOBuffer_t *buf, uint16_t wtype, uint16_t *len)
+{
+    uint8_t* p = &buf->memory[buf->rpos];
+
+    //the frame has been validated by scanAVPs, only the type is checked
+    if((buf->rpos >= buf->size) || (get_short(&p[4]) != wtype)) return (NULL);
+    *len = get_short(&p[2]) - AVP_HEADLEN;
+    buf->rpos += AVP_HEADLEN + *len;
+    return (p + AVP_HEADLEN);
+}
+
+int16_t viewTag(IOBuffer_t *buf, CAENRFIDInventoryParams* params, CAENRFIDTagView* View)
+{
+    uint16_t pos = buf->rpos, type = 0, len;
+
+    memset(View, 0, sizeof(*View));
+    if(!params->has_compact)
+    {
+        View->LogicalSource = (const char*) takeValue(buf, AVP_SOURCE_NAME, &View->LogicalSourceLen);
+        if(View->LogicalSource == NULL) goto not_a_tag;
+        View->ReadPoint = (const char*) takeValue(buf, AVP_READPOINT_NAME, &View->ReadPointLen);
+        if(View->ReadPoint == NULL) goto not_a_tag;
+        if(takeAVP(buf, AVP_TIMESTAMP, View->TimeStamp) != 0) goto not_a_tag;
+        if(takeAVP(buf, AVP_TAGTYPE, &type) != 0) goto not_a_tag;
+        View->Type = (CAENRFIDProtocol) type;
+        if(takeAVP(buf, AVP_TAGIDLEN, &len) != 0) goto not_a_tag;
+    }
+    if((View->ID = takeValue(buf, AVP_TAGID, &View->Length)) == NULL) goto not_a_tag;
+    if(params->has_RSSI)
+    {
+        if(takeAVP(buf, AVP_RSSI, &View->RSSI) != 0) goto not_a_tag;
+    }
+    if(params->has_TID)
+    {
+        if(takeAVP(buf, AVP_LENGTH, &len) != 0) goto not_a_tag;
+        if(len)
+        {
+            if((View->TID = takeValue(buf, AVP_TAG_VALUE, &View->TIDLen)) == NULL) goto not_a_tag;
+        }
+    }
+    if(params->has_XPC)
+    {
+        if((View->XPC = takeValue(buf, AVP_XPC, &len)) == NULL) goto not_a_tag;
+    }
+    if(params->has_PC)
+    {
+        if((View->PC = takeValue(buf, AVP_PC, &len)) == NULL) goto not_a_tag;
+    }
+    return (0);
+
+    not_a_tag:
+    //rewind, so that the caller can look for the result code
+    buf->rpos = pos;
+    return (1);
+}
+
+static int16_t parseHeader(uint8_t* header, uint16_t* CmdID, uint16_t* Length)
+{
+    uint16_t TxVer    = get_short(header);
+    uint32_t VendorID = get_long(header + 4);
+
+    *CmdID  = get_short(header + 2);
+    *Length = get_short(header + 8);
+    if(*Length == 0) *Length = HEADER_LEN + sizeAVP(AVP_COMMAND, sizeof(uint16_t));
+    if((TxVer != 0x0001) ||
+       (VendorID != CAEN_VENDOR)||
+       (*Length < HEADER_LEN)
+       )
+    {
+        return CAENRFID_CommunicationError;
+    }
+    return CAENRFID_StatusOK;
+}
+
+int16_t checkHeader(CAENRFIDReader* reader, uint8_t* header, uint16_t* CmdID, uint16_t* Length)
+{
+    int16_t tmp;
+
+    if((tmp = parseHeader(header, CmdID, Length)) != 0) return (tmp);
+    //the reply must fit into the reader scratch buffer
+    if(*Length > reader->_buffer_size)
+    {
+        return CAENRFID_OutOfMemoryError;
+    }
+    return CAENRFID_StatusOK;
+}
+
+int16_t sendFrame(CAENRFIDReader* reader, IOBuffer_t* txbuf)
+{
+    int16_t tmp;
+
+    //--note : time interval between bytes of command must
+    // not exceed the reader timeout value, otherwise reader 
+    // will disregard command
+    reader->disable_irqs();
+    tmp = reader->tx(reader->_port_handle, txbuf->memory, txbuf->size);
+    reader->enable_irqs();
+    if(tmp != 0)
+    {
+        return CAENRFID_CommunicationError;
+    }
+    return CAENRFID_StatusOK;
+}
+
+int16_t receiveFrame(CAENRFIDReader* reader, IOBuffer_t* rxbuf, uint16_t* CmdID)
+{
+    int16_t tmp;
+    uint16_t Length;
+    uint8_t header[HEADER_LEN] = {0};
+
+    rxbuf->size = 0;
+    //get protocol header
+    if(reader->rx(reader->_port_handle, header, HEADER_LEN, STANDARD_RX_MSEC_TMO) != 0)
+    {
+        return CAENRFID_CommunicationError;
+    }
+
+    //verify header
+    if((tmp = checkHeader(reader, header, CmdID, &Length)) != 0) return (tmp);
+    rxbuf->memory = reader->_buffer;
+    memcpy(rxbuf->memory, header, HEADER_LEN);
+    rxbuf->size = Length;
+    rxbuf->wpos = HEADER_LEN;
+    rxbuf->rpos = 0;
+    //get rest of data
+    Length -= HEADER_LEN;
+    if(Length != 0)
+    {
+        if(reader->rx(reader->_port_handle, &rxbuf->memory[rxbuf->wpos], Length, STANDARD_RX_MSEC_TMO) != 0)
+        {
+            rxbuf->size = 0;
+            rxbuf->wpos = 0;
+            return CAENRFID_CommunicationError;
+        }
+        rxbuf->wpos += Length;
+    }
+
+    return CAENRFID_StatusOK;
+}
+
+int16_t sendReceive(CAENRFIDReader* reader, IOBuffer_t* txbuf, IOBuffer_t* rxbuf)
+{
+    int16_t tmp = 0;
+    uint16_t sentCmdID, CmdID;
+
+    sentCmdID = get_short(txbuf->memory + 2);
+    reader->clear_rx_data(reader->_port_handle);
+    reader->_rx_rpos = 0;
+    reader->_rx_wpos = 0;
+    //send command
+    if((tmp = sendFrame(reader, txbuf)) != 0)
+    {
+        rxbuf->size = 0;
+        return (tmp);
+    }
+    //reply is received into the reader scratch buffer, overwriting the command
+    if((tmp = receiveFrame(reader, rxbuf, &CmdID)) != 0) return (tmp);
+    if(CmdID != sentCmdID)
+    {
+        return CAENRFID_CommunicationError;
+    }
+
+    return CAENRFID_StatusOK;
+}
+
+int16_t sendReceiveHead(CAENRFIDReader* reader, IOBuffer_t* txbuf)
+{
+    int16_t tmp;
+    uint16_t sentCmdID, CmdID, Length;
+    uint8_t head[HEADER_LEN + AVP_HEADLEN + sizeof(uint16_t)];
+
+    sentCmdID = get_short(txbuf->memory + 2);
+    reader->clear_rx_data(reader->_port_handle);
+    reader->_rx_rpos = 0;
+    reader->_rx_wpos = 0;
+    if((tmp = sendFrame(reader, txbuf)) != 0) return (tmp);
+    //only header and command AVP are received, the rest of the reply is
+    //left to receiveFramedTag whatever its length
+    if(reader->rx(reader->_port_handle, head, sizeof(head), STANDARD_RX_MSEC_TMO) != 0)
+    {
+        return CAENRFID_CommunicationError;
+    }
+    if((tmp = parseHeader(head, &CmdID, &Length)) != 0) return (tmp);
+    if((CmdID != sentCmdID) || (Length < sizeof(head)) ||
+       (get_short(&head[HEADER_LEN + 2]) != AVP_HEADLEN + sizeof(uint16_t)) ||
+       (get_short(&head[HEADER_LEN + 4]) != AVP_COMMAND))
+    {
+        return CAENRFID_CommunicationError;
+    }
+    return CAENRFID_StatusOK;
+}
+
+int16_t sendAbort(CAENRFIDReader* reader)
+{
+    uint8_t abort = UART_ABORT;
+
+    if(reader->tx(reader->_port_handle, &abort, sizeof(abort)) != 0) return CAENRFID_CommunicationError;
+    return CAENRFID_StatusOK;
+}
+
+/*
+    Framed tag decoders, one for each combination of the inventory flags
+    changing the AVPs sent for a tag. The flags are constants in each
+    expansion, so every decoder parses its own AVP sequence straight-line.
+    The decoder is chosen by selectFramedDecoder when the inventory starts.
+*/
+#define FRAMED_DEC_COMPACT      0x01
+#define FRAMED_DEC_RSSI         0x02
+#define FRAMED_DEC_TID          0x04
+#define FRAMED_DEC_XPC          0x08
+#define FRAMED_DEC_PC           0x10
+#define FRAMED_DECODERS         0x20
+
+//next AVP of the tag, taken in place when already buffered as a whole,
+//the reply is broken if it does not come
+#define FRAMED_NEXT_AVP()                                                           \
+    p = &reader->_rx_buffer[reader->_rx_rpos];                                      \
+    avail = reader->_rx_wpos - reader->_rx_rpos;                                    \
+    if((avail >= AVP_HEADLEN) && (p[0] == 0) && (p[1] == 0) &&                      \
+       ((len = get_short(&p[2])) >= AVP_HEADLEN) && (len <= avail))                 \
+    {                                                                               \
+        rxbuf.memory = p;                                                           \
+        rxbuf.size = len;                                                           \
+        rxbuf.rpos = 0;                                                             \
+        rxbuf.wpos = len;                                                           \
+        reader->_rx_rpos += len;                                                    \
+    }                                                                               \
+    else if(receiveAVP(reader, &rxbuf, FRAMED_RX_MSEC_TMO_OTHER) != 0)              \
+        return CAENRFID_CommunicationError
+
+//value of the AVP just received, checked against the descriptor of the
+//expected type as getAVP does. A different AVP means the tags are over
+//and the result code is expected instead
+#define FRAMED_GET_AVP(type, value)                                                 \
+    len = rxbuf.size - AVP_HEADLEN;                                                 \
+    if((get_short(&rxbuf.memory[4]) != (type)) ||                                   \
+       (len < AVPDesc[type].min) || (len > AVPDesc[type].max)) goto get_result;     \
+    decodeValue(AVPDesc[type].kind, &rxbuf.memory[AVP_HEADLEN], len, (value))
+
+#define FRAMED_DECODER(n)                                                           \
+static int16_t receiveFramedTag_##n(CAENRFIDReader* reader, bool* has_tag,          \
+                                    CAENRFIDTag* Tag, bool* has_result_code)        \
+{                                                                                   \
+    int16_t ret;                                                                    \
+    uint16_t type, avail, len;                                                      \
+    uint8_t* p;                                                                     \
+    IOBuffer_t rxbuf;                                                               \
+                                                                                    \
+    *has_tag = false;                                                               \
+    *has_result_code = false;                                                       \
+    if(receiveAVP(reader, &rxbuf, FRAMED_RX_MSEC_TMO_FIRST) != 0)                   \
+        return CAENRFID_StatusOK;                                                   \
+    if((n) & FRAMED_DEC_COMPACT)                                                    \
+    {                                                                               \
+        FRAMED_GET_AVP(AVP_TAGID, Tag->ID);                                         \
+        Tag->Length = len;                                                          \
+    }                                                                               \
+    else                                                                            \
+    {                                                                               \
+        FRAMED_GET_AVP(AVP_SOURCE_NAME, Tag->LogicalSource);                        \
+        FRAMED_NEXT_AVP();                                                          \
+        FRAMED_GET_AVP(AVP_READPOINT_NAME, Tag->ReadPoint);                         \
+        FRAMED_NEXT_AVP();                                                          \
+        FRAMED_GET_AVP(AVP_TIMESTAMP, Tag->TimeStamp);                              \
+        FRAMED_NEXT_AVP();                                                          \
+        FRAMED_GET_AVP(AVP_TAGTYPE, &type);                                         \
+        Tag->Type = (CAENRFIDProtocol) type;                                        \
+        FRAMED_NEXT_AVP();                                                          \
+        FRAMED_GET_AVP(AVP_TAGIDLEN, &Tag->Length);                                 \
+        if(Tag->Length > MAX_ID_LENGTH) return CAENRFID_LibraryError;               \
+        FRAMED_NEXT_AVP();                                                          \
+        FRAMED_GET_AVP(AVP_TAGID, Tag->ID);                                         \
+    }                                                                               \
+    if((n) & FRAMED_DEC_RSSI)                                                       \
+    {                                                                               \
+        FRAMED_NEXT_AVP();                                                          \
+        FRAMED_GET_AVP(AVP_RSSI, &Tag->RSSI);                                       \
+    }                                                                               \
+    if((n) & FRAMED_DEC_TID)                                                        \
+    {                                                                               \
+        FRAMED_NEXT_AVP();                                                          \
+        FRAMED_GET_AVP(AVP_LENGTH, &Tag->TIDLen);                                   \
+        if(Tag->TIDLen > MAX_TID_SIZE) return CAENRFID_LibraryError;                \
+        if(Tag->TIDLen > 0)                                                         \
+        {                                                                           \
+            FRAMED_NEXT_AVP();                                                      \
+            if(rxbuf.size - AVP_HEADLEN > MAX_TID_SIZE)                             \
+                return CAENRFID_LibraryError;                                       \
+            FRAMED_GET_AVP(AVP_TAG_VALUE, Tag->TID);                                \
+        }                                                                           \
+    }                                                                               \
+    if((n) & FRAMED_DEC_XPC)                                                        \
+    {                                                                               \
+        FRAMED_NEXT_AVP();                                                          \
+        FRAMED_GET_AVP(AVP_XPC, Tag->XPC);                                          \
+    }                                                                               \
+    if((n) & FRAMED_DEC_PC)                                                         \
+    {                                                                               \
+        FRAMED_NEXT_AVP();                                                          \
+        FRAMED_GET_AVP(AVP_PC, Tag->PC);                                            \
+    }                                                                               \
+    *has_tag = true;                                                                \
+    return CAENRFID_StatusOK;                                                       \
+                                                                                    \
+get_result:                                                                         \
+    if(getAVP(&rxbuf, AVP_RESULT_CODE, &ret) != 0) return CAENRFID_LibraryError;    \
+    *has_result_code = true;                                                        \
+    return (ret);                                                                   \
+}
+
+FRAMED_DECODER(0)  FRAMED_DECODER(1)  FRAMED_DECODER(2)  FRAMED_DECODER(3)
+FRAMED_DECODER(4)  FRAMED_DECODER(5)  FRAMED_DECODER(6)  FRAMED_DECODER(7)
+FRAMED_DECODER(8)  FRAMED_DECODER(9)  FRAMED_DECODER(10) FRAMED_DECODER(11)
+FRAMED_DECODER(12) FRAMED_DECODER(13) FRAMED_DECODER(14) FRAMED_DECODER(15)
+FRAMED_DECODER(16) FRAMED_DECODER(17) FRAMED_DECODER(18) FRAMED_DECODER(19)
+FRAMED_DECODER(20) FRAMED_DECODER(21) FRAMED_DECODER(22) FRAMED_DECODER(23)
+FRAMED_DECODER(24) FRAMED_DECODER(25) FRAMED_DECODER(26) FRAMED_DECODER(27)
+FRAMED_DECODER(28) FRAMED_DECODER(29) FRAMED_DECODER(30) FRAMED_DECODER(31)
+
+static const CAENRFIDFramedDecoder framedDecoders[FRAMED_DECODERS] = {
+    receiveFramedTag_0,  receiveFramedTag_1,  receiveFramedTag_2,  receiveFramedTag_3,
+    receiveFramedTag_4,  receiveFramedTag_5,  receiveFramedTag_6,  receiveFramedTag_7,
+    receiveFramedTag_8,  receiveFramedTag_9,  receiveFramedTag_10, receiveFramedTag_11,
+    receiveFramedTag_12, receiveFramedTag_13, receiveFramedTag_14, receiveFramedTag_15,
+    receiveFramedTag_16, receiveFramedTag_17, receiveFramedTag_18, receiveFramedTag_19,
+    receiveFramedTag_20, receiveFramedTag_21, receiveFramedTag_22, receiveFramedTag_23,
+    receiveFramedTag_24, receiveFramedTag_25, receiveFramedTag_26, receiveFramedTag_27,
+    receiveFramedTag_28, receiveFramedTag_29, receiveFramedTag_30, receiveFramedTag_31,
+};
+
+void selectFramedDecoder(CAENRFIDReader* reader)
+{
+    uint8_t n = 0;
+
+    if(reader->_inventory_params.has_compact) n |= FRAMED_DEC_COMPACT;
+    if(reader->_inventory_params.has_RSSI) n |= FRAMED_DEC_RSSI;
+    if(reader->_inventory_params.has_TID) n |= FRAMED_DEC_TID;
+    if(reader->_inventory_params.has_XPC) n |= FRAMED_DEC_XPC;
+    if(reader->_inventory_params.has_PC) n |= FRAMED_DEC_PC;
+    reader->_framed_decoder = framedDecoders[n];
+}
+
+int16_t receiveFramedTag(CAENRFIDReader* reader, bool* has_tag, CAENRFIDTag* Tag,
+                         bool* has_result_code)
+{
+    //no framed inventory was started on this reader
+    if(reader->_framed_decoder == NULL) selectFramedDecoder(reader);
+    return reader->_framed_decoder(reader, has_tag, Tag, has_result_code);
 }
\ No newline at end of file
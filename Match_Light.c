@@ -0,0 +1,208 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2022, CAEN RFID S.R.L.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of CAEN RFID S.R.L. nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+
+#include <string.h>
+#include "Match_Light.h"
+
+/*
+    Vector kernels are selected at compile time from the target baseline
+    (SSE2 is always there on x86-64, NEON on AArch64), CAENRFID_NO_SIMD
+    forces the portable word at a time code.
+*/
+#if !defined(CAENRFID_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define MATCH_SSE2
+#elif !defined(CAENRFID_NO_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#include <arm_neon.h>
+#define MATCH_NEON
+#endif
+
+static uint64_t load64(const uint8_t* p)
+{
+    uint64_t v;
+
+    memcpy(&v, p, sizeof(v));
+    return (v);
+}
+
+static uint32_t load32(const uint8_t* p)
+{
+    uint32_t v;
+
+    memcpy(&v, p, sizeof(v));
+    return (v);
+}
+
+// non zero if a and b differ on the bits set in c, for n < 16 bytes: the
+// two loads overlap, so a 12 bytes EPC takes two words
+static uint64_t diffShort(const uint8_t* a, const uint8_t* b, const uint8_t* c, uint16_t n)
+{
+    uint64_t d = 0;
+    uint16_t i;
+
+    if(n >= 8)
+    {
+        d = (load64(a) ^ load64(b)) & (c ? load64(c) : ~(uint64_t)0);
+        a += n - 8; b += n - 8; if(c) c += n - 8;
+        return d | ((load64(a) ^ load64(b)) & (c ? load64(c) : ~(uint64_t)0));
+    }
+    if(n >= 4)
+    {
+        d = (load32(a) ^ load32(b)) & (c ? load32(c) : ~(uint32_t)0);
+        a += n - 4; b += n - 4; if(c) c += n - 4;
+        return d | ((load32(a) ^ load32(b)) & (c ? load32(c) : ~(uint32_t)0));
+    }
+    for(i = 0; i < n; i++) d |= (uint8_t)((a[i] ^ b[i]) & (c ? c[i] : 0xFF));
+    return (d);
+}
+
+// n >= 16 bytes: full blocks, then a last block overlapping the previous
+// one (comparing some bytes twice is harmless)
+static bool equalLong(const uint8_t* a, const uint8_t* b, const uint8_t* c, uint16_t n)
+{
+    uint16_t i = 0;
+
+    while(1)
+    {
+#if defined(MATCH_SSE2)
+        __m128i x = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(a + i)),
+                                  _mm_loadu_si128((const __m128i*)(b + i)));
+
+        if(c) x = _mm_and_si128(x, _mm_loadu_si128((const __m128i*)(c + i)));
+        if(_mm_movemask_epi8(_mm_cmpeq_epi8(x, _mm_setzero_si128())) != 0xFFFF) return false;
+#elif defined(MATCH_NEON)
+        uint8x16_t x = veorq_u8(vld1q_u8(a + i), vld1q_u8(b + i));
+        uint64x2_t w;
+
+        if(c) x = vandq_u8(x, vld1q_u8(c + i));
+        w = vreinterpretq_u64_u8(x);
+        if((vgetq_lane_u64(w, 0) | vgetq_lane_u64(w, 1)) != 0) return false;
+#else
+        if(diffShort(a + i, b + i, c ? c + i : NULL, 8) |
+           diffShort(a + i + 8, b + i + 8, c ? c + i + 8 : NULL, 8)) return false;
+#endif
+        if(i + 16 == n) return true;
+        i = (n - i >= 32) ? i + 16 : n - 16;
+    }
+}
+
+uint32_t matchHash(const uint8_t* ID, uint16_t Length, uint32_t Seed)
+{
+    const uint64_t k = 0x9E3779B97F4A7C15ULL;
+    uint64_t h = (Seed ^ ((uint64_t)Length << 32)) * k, w;
+    uint16_t i;
+
+    //one multiply per word, the last word overlaps the previous one
+    for(i = 0; i + 8 <= Length; i += 8) h = (h ^ load64(ID + i)) * k;
+    if(i < Length)
+    {
+        if(Length >= 8) w = load64(ID + Length - 8);
+        else if(Length >= 4) w = ((uint64_t)load32(ID) << 32) | load32(ID + Length - 4);
+        else for(w = 0; i < Length; i++) w = (w << 8) | ID[i];
+        h = (h ^ w) * k;
+    }
+    h ^= h >> 32;
+    h *= k;
+    return (uint32_t)(h >> 32);
+}
+
+bool matchEqual(const uint8_t* a, const uint8_t* b, uint16_t Length)
+{
+    if(Length < 16) return (diffShort(a, b, NULL, Length) == 0);
+    return equalLong(a, b, NULL, Length);
+}
+
+int16_t matchCompile(MatchMask_t* m, uint16_t BitAddress, uint16_t BitLength, const uint8_t* Mask)
+{
+    uint32_t i, bit;
+
+    m->start = BitAddress / 8;
+    m->len = 0;
+    if(BitLength == 0) return (0);
+    if((uint32_t)BitAddress % 8 + BitLength > MATCH_MAX_SPAN * 8) return (-1);
+    m->len = (uint16_t)(((uint32_t)BitAddress % 8 + BitLength + 7) / 8);
+    memset(m->value, 0, m->len);
+    memset(m->care, 0, m->len);
+    //bit by bit, once per mask: compares are then byte aligned whatever
+    //the mask address
+    for(i = 0; i < BitLength; i++)
+    {
+        bit = BitAddress % 8 + i;
+        m->care[bit / 8] |= (uint8_t)(0x80 >> (bit % 8));
+        if((Mask[i / 8] >> (7 - (i % 8))) & 1) m->value[bit / 8] |= (uint8_t)(0x80 >> (bit % 8));
+    }
+    return (0);
+}
+
+bool matchMasked(const uint8_t* mem, uint16_t memStart, uint16_t memLength, const MatchMask_t* m)
+{
+    uint16_t off;
+
+    if(m->len == 0) return true;
+    if((m->start < memStart) || ((uint32_t)m->start + m->len > (uint32_t)memStart + memLength)) return false;
+    off = m->start - memStart;
+    if(m->len < 16) return (diffShort(mem + off, m->value, m->care, m->len) == 0);
+    return equalLong(mem + off, m->value, m->care, m->len);
+}
+
+int16_t matchExtract(const uint8_t* mem, uint16_t memStart, uint16_t memLength,
+                     uint16_t BitAddress, uint16_t BitLength, uint8_t* out)
+{
+    uint16_t i, n = (BitLength + 7) / 8, shift = BitAddress % 8;
+    const uint8_t* p;
+
+    if((BitAddress / 8 < memStart) || ((uint32_t)BitAddress + BitLength > ((uint32_t)memStart + memLength) * 8)) return (-1);
+    if(n == 0) return (0);
+    p = mem + (BitAddress / 8 - memStart);
+    if(shift == 0)
+    {
+        memcpy(out, p, n);
+    }
+    else
+    {
+        //the byte after the last one is read only if it holds wanted bits
+        for(i = 0; i + 1 < n; i++) out[i] = (uint8_t)((p[i] << shift) | (p[i + 1] >> (8 - shift)));
+        out[i] = (uint8_t)(p[i] << shift);
+        if(shift + BitLength - 8 * i > 8) out[i] |= (uint8_t)(p[i + 1] >> (8 - shift));
+    }
+    if(BitLength % 8) out[n - 1] &= (uint8_t)(0xFF << (8 - BitLength % 8));
+    return (0);
+}
+
+bool matchBitsEqual(const uint8_t* a, const uint8_t* b, uint16_t BitLength)
+{
+    uint16_t n = BitLength / 8;
+    uint8_t last = (uint8_t)(0xFF << (8 - BitLength % 8));
+
+    if(!matchEqual(a, b, n)) return false;
+    return ((BitLength % 8) == 0) || (((a[n] ^ b[n]) & last) == 0);
+}
@@ -0,0 +1,63 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2022, CAEN RFID S.R.L.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of CAEN RFID S.R.L. nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+
+#ifndef SRC_MATCH_LIGHT_H_
+#define SRC_MATCH_LIGHT_H_
+
+#include "CAENRFIDTypes_Light.h"
+
+// widest span of memory bank bytes a mask can be compared against on the
+// host: CRC and PC words followed by the longest ID
+#define MATCH_MAX_SPAN  (MAX_ID_LENGTH + 8)
+
+// Mask/MaskBitAddress/MaskBitLength turned into a byte aligned compare:
+// bank bytes [start, start + len) must equal value on the bits set in care
+typedef struct MatchMask
+{
+    uint16_t         start;
+    uint16_t         len;
+    uint8_t          value[MATCH_MAX_SPAN];
+    uint8_t          care[MATCH_MAX_SPAN];
+} MatchMask_t;
+
+uint32_t matchHash(const uint8_t* ID, uint16_t Length, uint32_t Seed);
+bool matchEqual(const uint8_t* a, const uint8_t* b, uint16_t Length);
+int16_t matchCompile(MatchMask_t* m, uint16_t BitAddress, uint16_t BitLength, const uint8_t* Mask);
+// mem holds the bank bytes [memStart, memStart + memLength)
+bool matchMasked(const uint8_t* mem, uint16_t memStart, uint16_t memLength, const MatchMask_t* m);
+// copies bank bits [BitAddress, BitAddress + BitLength) to out starting at
+// bit 0, as a Mask is laid out, clearing the unused bits of the last byte
+int16_t matchExtract(const uint8_t* mem, uint16_t memStart, uint16_t memLength,
+                     uint16_t BitAddress, uint16_t BitLength, uint8_t* out);
+bool matchBitsEqual(const uint8_t* a, const uint8_t* b, uint16_t BitLength);
+
+#endif /* SRC_MATCH_LIGHT_H_ */
@@ -0,0 +1,924 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2022, CAEN RFID S.R.L.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of CAEN RFID S.R.L. nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+
+/*
+    Micro-benchmarks of the frame encoding/decoding and inventory parsing paths.
+
+    The library and the emulator sources are built into this file, so that
+    malloc can be counted and no port is needed. Build and run on a POSIX host
+    from this directory:
+
+        cc -O2 -std=c99 -I../.. benchmark.c -o benchmark && ./benchmark
+
+    Replies are recorded once from CAENRFIDEmulator and then replayed from
+    memory, so the figures only account for the library. For each benchmark
+    ns/op, malloc calls/op and, for inventories, tags/s are reported.
+*/
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static unsigned long bench_allocs;
+
+static void* bench_malloc(size_t size)
+{
+    bench_allocs++;
+    return malloc(size);
+}
+
+#define malloc(size) bench_malloc(size)
+
+#include "../../IO_Light.c"
+#include "../../Match_Light.c"
+#include "../../CAENRFIDLib_Light.c"
+#include "../../CAENRFIDEmulator_Light.c"
+#include "../common/emu_fixture.h"
+
+#define BENCH_TAGS              (200)
+#define BENCH_MIN_NS            (200000000ULL)
+#define BENCH_STREAM_SIZE       (0x20000)
+
+typedef struct Bench_s {
+    const char* name;
+    uint32_t    (*run)(uint32_t iters);   // returns the tags parsed
+} Bench_t;
+
+/*
+    Replay port: tx is discarded and rx serves the recorded stream
+*/
+static uint8_t  stream[BENCH_STREAM_SIZE];
+static uint32_t stream_len;
+static uint32_t stream_pos;
+static bool     recording;
+static CAENRFIDEmulator emu;
+static CAENRFIDEmuTag emu_tags[BENCH_TAGS];
+
+static int16_t replay_connect(void* *port_handle, int16_t port_type, void* port_params)
+{
+    (void) port_handle;
+    (void) port_type;
+    (void) port_params;
+    return 0;
+}
+
+static int16_t replay_disconnect(void* port_handle)
+{
+    (void) port_handle;
+    return 0;
+}
+
+static int16_t replay_tx(void* port_handle, uint8_t* data, uint32_t len)
+{
+    (void) port_handle;
+    if(recording) return CAENRFID_EmulatorWrite(&emu, data, len);
+    return 0;
+}
+
+static int16_t replay_rx(void* port_handle, uint8_t* data, uint32_t len, uint32_t ms_timeout)
+{
+    (void) port_handle;
+    (void) ms_timeout;
+    if(recording)
+    {
+        if(CAENRFID_EmulatorRead(&emu, data, len) != len) return (-1);
+        if(stream_len + len > sizeof(stream)) return (-1);
+        memcpy(&stream[stream_len], data, len);
+        stream_len += len;
+        return 0;
+    }
+    if(stream_pos + len > stream_len) return (-1);
+    memcpy(data, &stream[stream_pos], len);
+    stream_pos += len;
+    return 0;
+}
+
+static int32_t replay_rx_some(void* port_handle, uint8_t* data, uint32_t maxlen, uint32_t ms_timeout)
+{
+    uint32_t len = stream_len - stream_pos;
+
+    (void) port_handle;
+    (void) ms_timeout;
+    if(len == 0) return (-1);
+    if(len > maxlen) len = maxlen;
+    memcpy(data, &stream[stream_pos], len);
+    stream_pos += len;
+    return (int32_t) len;
+}
+
+static int16_t replay_clear_rx_data(void* port_handle)
+{
+    (void) port_handle;
+    return 0;
+}
+
+static void replay_irqs(void)
+{
+}
+
+static CAENRFIDReader reader = {
+    .connect = replay_connect,
+    .disconnect = replay_disconnect,
+    .tx = replay_tx,
+    .rx = replay_rx,
+    .clear_rx_data = replay_clear_rx_data,
+    .enable_irqs = replay_irqs,
+    .disable_irqs = replay_irqs,
+};
+
+static void record_start(void)
+{
+    emu_fixture_tags(emu_tags, BENCH_TAGS);
+    memset(&emu, 0, sizeof(emu));
+    emu.Tags = emu_tags;
+    emu.NumTags = BENCH_TAGS;
+    CAENRFID_EmulatorInit(&emu);
+    stream_len = 0;
+    recording = true;
+}
+
+static void record_stop(void)
+{
+    recording = false;
+}
+
+/*
+    Benchmarks
+*/
+static uint8_t  frame[256];
+static volatile uint16_t sink;
+static CAENRFIDTag batch[BENCH_TAGS];
+
+static uint32_t bench_addHeader(uint32_t iters)
+{
+    IOBuffer_t buf = {frame, sizeof(frame), 0, 0};
+
+    while(iters--)
+    {
+        buf.wpos = 0;
+        addHeader((uint16_t) iters, &buf, sizeof(frame));
+        sink = frame[3];
+    }
+    return 0;
+}
+
+static void encode_read(IOBuffer_t* buf)
+{
+    uint16_t cmd = CMD_G2READ, len = 12, bank = 3, addr = 0, size = 16;
+    uint8_t id[12] = {0};
+
+    buf->wpos = 0;
+    addHeader(0, buf, buf->size);
+    addAVP(buf, sizeof(cmd), AVP_COMMAND, &cmd);
+    addAVP(buf, sizeof("Source_0"), AVP_SOURCE_NAME, "Source_0");
+    addAVP(buf, sizeof(len), AVP_TAGIDLEN, &len);
+    addAVP(buf, len, AVP_TAGID, id);
+    addAVP(buf, sizeof(bank), AVP_MEMBANK, &bank);
+    addAVP(buf, sizeof(addr), AVP_TAGADDRESS, &addr);
+    addAVP(buf, sizeof(size), AVP_LENGTH, &size);
+}
+
+static uint32_t bench_addAVP(uint32_t iters)
+{
+    IOBuffer_t buf = {frame, sizeof(frame), 0, 0};
+
+    while(iters--)
+    {
+        encode_read(&buf);
+        sink = frame[HEADER_LEN + 7];
+    }
+    return 0;
+}
+
+static uint32_t bench_getAVP(uint32_t iters)
+{
+    IOBuffer_t buf = {frame, sizeof(frame), 0, 0};
+    uint16_t value;
+    uint8_t id[MAX_ID_LENGTH];
+
+    encode_read(&buf);
+    while(iters--)
+    {
+        buf.rpos = HEADER_LEN;
+        getAVP(&buf, AVP_COMMAND, &value);
+        getAVP(&buf, AVP_TAGIDLEN, &value);
+        getAVP(&buf, AVP_TAGID, id);
+        getAVP(&buf, AVP_LENGTH, &value);
+        sink = value;
+    }
+    return 0;
+}
+
+static uint32_t bench_encodeTagData(uint32_t iters)
+{
+    IOBuffer_t buf = {0};
+    CAENRFIDTagHandle Handle;
+
+    //what every CAENRFID_ReadTagData_EPC_C1G2 call does
+    while(iters--)
+    {
+        CAENRFID_TagHandleInit(&Handle, &batch[0], 0x12345678);
+        encodeTagData(&reader, &buf, CMD_G2READ, &Handle, 3, 0, 16, NULL);
+        sink = buf.memory[HEADER_LEN + 7];
+    }
+    return 0;
+}
+
+static uint32_t bench_encodeTagDataHandle(uint32_t iters)
+{
+    IOBuffer_t buf = {0};
+    CAENRFIDTagHandle Handle;
+
+    CAENRFID_TagHandleInit(&Handle, &batch[0], 0x12345678);
+    while(iters--)
+    {
+        encodeTagData(&reader, &buf, CMD_G2READ, &Handle, 3, 0, 16, NULL);
+        sink = buf.memory[HEADER_LEN + 7];
+    }
+    return 0;
+}
+
+static uint32_t bench_encodeInventory(uint32_t iters)
+{
+    IOBuffer_t buf = {0};
+    CAENRFIDInventoryParams params;
+    uint8_t Mask[2] = {0xE2, 0x00};
+
+    //every call encodes the frame again
+    while(iters--)
+    {
+        clearTemplates(&reader);
+        encodeInventory(&reader, &buf, &params, "Source_0", 1, 32, 16, Mask, sizeof(Mask), RSSI);
+        sink = buf.memory[HEADER_LEN + 7];
+    }
+    return 0;
+}
+
+static uint32_t bench_encodeInventoryTemplate(uint32_t iters)
+{
+    IOBuffer_t buf = {0};
+    CAENRFIDInventoryParams params;
+    uint8_t Mask[2] = {0xE2, 0x00};
+
+    //after the first call the frame is copied from a template slot
+    while(iters--)
+    {
+        encodeInventory(&reader, &buf, &params, "Source_0", 1, 32, 16, Mask, sizeof(Mask), RSSI);
+        sink = buf.memory[HEADER_LEN + 7];
+    }
+    return 0;
+}
+
+static uint8_t fw_request[HEADER_LEN + AVP_HEADLEN + 2];
+static uint32_t fw_reply;
+
+static uint32_t bench_sendReceive(uint32_t iters)
+{
+    IOBuffer_t txbuf, rxbuf;
+    char FWRel[200];
+    uint16_t cmd;
+
+    while(iters--)
+    {
+        stream_pos = fw_reply;
+        txbuf.memory = fw_request;
+        txbuf.size = sizeof(fw_request);
+        sendReceive(&reader, &txbuf, &rxbuf);
+        rxbuf.rpos = HEADER_LEN;
+        getAVP(&rxbuf, AVP_COMMAND, &cmd);
+        getAVP(&rxbuf, AVP_GETFWRELEASE, FWRel);
+        sink = cmd;
+    }
+    return 0;
+}
+
+static uint32_t inventory_reply;
+static uint16_t inventory_cmdID;
+
+static uint32_t bench_InventoryTag(uint32_t iters)
+{
+    CAENRFIDTagList *list, *next;
+    uint16_t found;
+    uint32_t tags = 0;
+
+    while(iters--)
+    {
+        stream_pos = inventory_reply;
+        reader._cmdID = inventory_cmdID;
+        list = NULL;
+        CAENRFID_InventoryTag(&reader, "Source_0", 0, 0, 0, NULL, 0, 0, &list, &found);
+        tags += found;
+        while(list != NULL)
+        {
+            next = list->Next;
+            free(list);
+            list = next;
+        }
+    }
+    return tags;
+}
+
+static uint32_t bench_InventoryTagArray(uint32_t iters)
+{
+    static CAENRFIDTag Tags[BENCH_TAGS];
+    uint16_t size, found;
+    uint32_t tags = 0;
+
+    while(iters--)
+    {
+        stream_pos = inventory_reply;
+        reader._cmdID = inventory_cmdID;
+        CAENRFID_InventoryTagArray(&reader, "Source_0", 0, 0, 0, NULL, 0, 0,
+                                   Tags, BENCH_TAGS, &size, &found);
+        tags += size;
+    }
+    return tags;
+}
+
+static uint32_t bench_InventoryTagFrame(uint32_t iters)
+{
+    CAENRFIDTagFrame Frame;
+    CAENRFIDTagView View;
+    uint32_t tags = 0;
+
+    while(iters--)
+    {
+        stream_pos = inventory_reply;
+        reader._cmdID = inventory_cmdID;
+        CAENRFID_InventoryTagFrame(&reader, "Source_0", 0, 0, 0, NULL, 0, 0, &Frame);
+        while(CAENRFID_TagFrameNext(&Frame, &View) == CAENRFID_StatusOK)
+        {
+            tags++;
+        }
+        CAENRFID_TagFrameRelease(&Frame);
+    }
+    return tags;
+}
+
+static uint32_t framed_reply;
+static uint16_t framed_cmdID;
+static uint32_t framed_full_reply;
+static uint16_t framed_full_cmdID;
+
+#define FRAMED_FULL     (FRAMED | CONTINUOS | RSSI | TID_READING | XPC | PC)
+
+static uint32_t framed(uint32_t iters, uint32_t reply, uint16_t cmdID, uint16_t flag)
+{
+    CAENRFIDTagList *list;
+    CAENRFIDTag Tag;
+    bool has_tag, has_result;
+    uint16_t found;
+    uint32_t tags = 0;
+
+    while(iters--)
+    {
+        stream_pos = reply;
+        reader._cmdID = cmdID;
+        reader._rx_rpos = 0;
+        reader._rx_wpos = 0;
+        list = NULL;
+        CAENRFID_InventoryTag(&reader, "Source_0", 0, 0, 0, NULL, 0, flag, &list, &found);
+        do
+        {
+            if(CAENRFID_GetFramedTag(&reader, &has_tag, &Tag, &has_result) != 0) break;
+            if(has_tag) tags++;
+        } while(!has_result);
+    }
+    return tags;
+}
+
+static uint32_t bench_GetFramedTag(uint32_t iters)
+{
+    reader.rx_some = NULL;
+    return framed(iters, framed_reply, framed_cmdID, FRAMED | CONTINUOS);
+}
+
+static uint32_t bench_GetFramedTag_rx_some(uint32_t iters)
+{
+    uint32_t tags;
+
+    reader.rx_some = replay_rx_some;
+    tags = framed(iters, framed_reply, framed_cmdID, FRAMED | CONTINUOS);
+    reader.rx_some = NULL;
+    return tags;
+}
+
+static uint32_t bench_GetFramedTag_full(uint32_t iters)
+{
+    uint32_t tags;
+
+    //RSSI, TID, XPC and PC AVPs follow every EPC
+    reader.rx_some = replay_rx_some;
+    tags = framed(iters, framed_full_reply, framed_full_cmdID, FRAMED_FULL);
+    reader.rx_some = NULL;
+    return tags;
+}
+
+static uint8_t  framed_full_tag[CAENRFID_RX_BUFFER_SIZE];
+static uint16_t framed_full_tag_len;
+
+static void framed_full_params(void)
+{
+    memset(&reader._inventory_params, 0, sizeof(reader._inventory_params));
+    reader._inventory_params.has_framed = true;
+    reader._inventory_params.has_continuous = true;
+    reader._inventory_params.has_RSSI = true;
+    reader._inventory_params.has_TID = true;
+    reader._inventory_params.has_XPC = true;
+    reader._inventory_params.has_PC = true;
+    selectFramedDecoder(&reader);
+}
+
+/*
+    Reference decoder: the generic state machine receiveFramedTag used before
+    the decoders specialised per inventory flag set, testing
+    _inventory_params at every AVP. Kept here so that both are timed on the
+    same tag.
+*/
+static int16_t referenceFramedTag(CAENRFIDReader* reader, bool* has_tag, CAENRFIDTag* Tag,
+                                  bool* has_result_code)
+{
+    int16_t ret = CAENRFID_LibraryError, pos;
+    uint16_t type;
+    IOBuffer_t rxbuf;
+    uint32_t tmo = FRAMED_RX_MSEC_TMO_FIRST;
+    bool nextAVP = true;
+
+    enum {
+     STATE_FIRST_AVP_RECEIVED = 0,
+     STATE_GET_SOURCE,
+     STATE_GET_READPOINT,
+     STATE_GET_TIMESTAMP,
+     STATE_GET_TYPE,
+     STATE_GET_ID_LENGTH,
+     STATE_GET_ID,
+     STATE_GET_RSSI,
+     STATE_GET_TID_LENGTH,
+     STATE_GET_TID,
+     STATE_GET_XPC,
+     STATE_GET_PC,
+     STATE_GET_RESULT,
+     STATE_TAG_DONE,
+     STATE_EXIT_DONE,
+    } state = STATE_FIRST_AVP_RECEIVED;
+
+    *has_tag = false;
+    *has_result_code = false;
+    while(1)
+    {
+        if(nextAVP)
+        {
+            if(receiveAVP(reader, &rxbuf, tmo) != 0)
+            {
+                nextAVP = false;
+                if(state == STATE_FIRST_AVP_RECEIVED)
+                {
+                    ret = CAENRFID_StatusOK;
+                }
+                else
+                {
+                    ret = CAENRFID_CommunicationError;
+                }
+                state = STATE_EXIT_DONE;
+            }
+        }
+
+        switch(state)
+        {
+        case STATE_FIRST_AVP_RECEIVED:
+            tmo = FRAMED_RX_MSEC_TMO_OTHER;
+            if(reader->_inventory_params.has_compact) state = STATE_GET_ID;
+            else state = STATE_GET_SOURCE;
+            nextAVP = false;
+            break;
+        case STATE_GET_SOURCE:
+            if(getAVP(&rxbuf, AVP_SOURCE_NAME, Tag->LogicalSource) != 0)
+            {
+                nextAVP = false;
+                state = STATE_GET_RESULT;
+                break;
+            }
+            nextAVP = true;
+            state = STATE_GET_READPOINT;
+            break;
+        case STATE_GET_READPOINT:
+            if(getAVP(&rxbuf, AVP_READPOINT_NAME, Tag->ReadPoint) != 0)
+            {
+                nextAVP = false;
+                state = STATE_GET_RESULT;
+                break;
+            }
+            state = STATE_GET_TIMESTAMP;
+            break;
+        case STATE_GET_TIMESTAMP:
+            if(getAVP(&rxbuf, AVP_TIMESTAMP, Tag->TimeStamp) != 0)
+            {
+                nextAVP = false;
+                state = STATE_GET_RESULT;
+                break;
+            }
+            state = STATE_GET_TYPE;
+            break;
+        case STATE_GET_TYPE:
+            if(getAVP(&rxbuf, AVP_TAGTYPE, &type) != 0)
+            {
+                nextAVP = false;
+                state = STATE_GET_RESULT;
+                break;
+            }
+            Tag->Type = (CAENRFIDProtocol) type;
+            state = STATE_GET_ID_LENGTH;
+            break;
+        case STATE_GET_ID_LENGTH:
+            if(getAVP(&rxbuf, AVP_TAGIDLEN, &Tag->Length) != 0)
+            {
+                nextAVP = false;
+                state = STATE_GET_RESULT;
+                break;
+            }
+            else if(Tag->Length > MAX_ID_LENGTH)
+            {
+                nextAVP = false;
+                ret = CAENRFID_LibraryError;
+                state = STATE_EXIT_DONE;
+                break;
+            }
+            state = STATE_GET_ID;
+            break;
+        case STATE_GET_ID:
+            if(reader->_inventory_params.has_compact)
+            {
+                pos = rxbuf.rpos;
+                if(getAVP(&rxbuf, AVP_TAGID, Tag->ID) != 0)
+                {
+                    nextAVP = false;
+                    state = STATE_GET_RESULT;
+                    break;
+                }
+                Tag->Length = (rxbuf.rpos - pos) - AVP_HEADLEN;
+            }
+            else
+            {
+                if(getAVP(&rxbuf, AVP_TAGID, Tag->ID) != 0)
+                {
+                    nextAVP = false;
+                    state = STATE_GET_RESULT;
+                    break;
+                }
+            }
+            if(reader->_inventory_params.has_RSSI) state = STATE_GET_RSSI;
+            else if(reader->_inventory_params.has_TID) state = STATE_GET_TID_LENGTH;
+            else if(reader->_inventory_params.has_XPC) state = STATE_GET_XPC;
+            else if(reader->_inventory_params.has_PC) state = STATE_GET_PC;
+            else
+            {
+                nextAVP = false;
+                state = STATE_TAG_DONE;
+                break;
+            }
+            nextAVP = true;
+            break;
+        case STATE_GET_RESULT:
+            if(getAVP(&rxbuf, AVP_RESULT_CODE,  &ret) != 0)
+            {
+                ret = CAENRFID_LibraryError;
+            }
+            else
+            {
+                *has_result_code = true;
+            }
+            nextAVP = false;
+            state = STATE_EXIT_DONE;
+            break;
+        case STATE_TAG_DONE:
+            *has_tag = true;
+            ret = CAENRFID_StatusOK;
+            //fall through
+        case STATE_EXIT_DONE:
+            return (ret);
+        case STATE_GET_RSSI:
+            if(getAVP(&rxbuf, AVP_RSSI, &Tag->RSSI) != 0)
+            {
+                nextAVP = false;
+                state = STATE_GET_RESULT;
+                break;
+            }
+            if(reader->_inventory_params.has_TID) state = STATE_GET_TID_LENGTH;
+            else if(reader->_inventory_params.has_XPC) state = STATE_GET_XPC;
+            else if(reader->_inventory_params.has_PC) state = STATE_GET_PC;
+            else
+            {
+                nextAVP = false;
+                state = STATE_TAG_DONE;
+            }
+            break;
+        case STATE_GET_TID_LENGTH:
+            if(getAVP(&rxbuf, AVP_LENGTH, &Tag->TIDLen) != 0) 
+            {
+                nextAVP = false;
+                state = STATE_GET_RESULT;
+                break;
+            }
+            else if(Tag->TIDLen > MAX_TID_SIZE)
+            {
+                nextAVP = false;
+                ret = CAENRFID_LibraryError;
+                state = STATE_EXIT_DONE;
+                break;
+            }
+            if(Tag->TIDLen > 0) state = STATE_GET_TID;
+            else if(reader->_inventory_params.has_XPC) state = STATE_GET_XPC;
+            else if(reader->_inventory_params.has_PC) state = STATE_GET_PC;
+            else
+            {
+                nextAVP = false;
+                state = STATE_TAG_DONE;
+            }
+            break;
+        case STATE_GET_TID:
+            if(rxbuf.size - AVP_HEADLEN > MAX_TID_SIZE)
+            {
+                nextAVP = false;
+                ret = CAENRFID_LibraryError;
+                state = STATE_EXIT_DONE;
+                break;
+            }
+            if(getAVP(&rxbuf, AVP_TAG_VALUE, Tag->TID) != 0)
+            {
+                nextAVP = false;
+                state = STATE_GET_RESULT;
+                break;
+            }
+            if(reader->_inventory_params.has_XPC) state = STATE_GET_XPC;
+            else if(reader->_inventory_params.has_PC) state = STATE_GET_PC;
+            else
+            {
+                nextAVP = false;
+                state = STATE_TAG_DONE;
+            }
+            break;
+        case STATE_GET_XPC:
+            if(getAVP(&rxbuf, AVP_XPC, Tag->XPC) != 0)
+            {
+                nextAVP = false;
+                state = STATE_GET_RESULT;
+                break;
+            }
+            if(reader->_inventory_params.has_PC) state = STATE_GET_PC;
+            else
+            {
+                nextAVP = false;
+                state = STATE_TAG_DONE;
+            }
+            break;
+        case STATE_GET_PC:
+            if(getAVP(&rxbuf, AVP_PC, Tag->PC) != 0)
+            {
+                nextAVP = false;
+                state = STATE_GET_RESULT;
+            }
+            else
+            {
+                nextAVP = false;
+                state = STATE_TAG_DONE;
+            }
+            break;
+        default:
+            return CAENRFID_LibraryError;
+        }
+    }
+}
+
+static uint32_t bench_receiveFramedTag(uint32_t iters)
+{
+    CAENRFIDTag Tag;
+    bool has_tag, has_result;
+    uint32_t tags = 0;
+
+    //the tag AVPs are already in the rx buffer, only the decoding is timed
+    framed_full_params();
+    memcpy(reader._rx_buffer, framed_full_tag, framed_full_tag_len);
+    while(iters--)
+    {
+        reader._rx_rpos = 0;
+        reader._rx_wpos = framed_full_tag_len;
+        receiveFramedTag(&reader, &has_tag, &Tag, &has_result);
+        tags += has_tag;
+    }
+    return tags;
+}
+
+static uint32_t bench_referenceFramedTag(uint32_t iters)
+{
+    CAENRFIDTag Tag;
+    bool has_tag, has_result;
+    uint32_t tags = 0;
+
+    framed_full_params();
+    memcpy(reader._rx_buffer, framed_full_tag, framed_full_tag_len);
+    while(iters--)
+    {
+        reader._rx_rpos = 0;
+        reader._rx_wpos = framed_full_tag_len;
+        referenceFramedTag(&reader, &has_tag, &Tag, &has_result);
+        tags += has_tag;
+    }
+    return tags;
+}
+
+static uint32_t bench_FilterTags(uint32_t iters)
+{
+    //the 10 bytes prefix shared by all the EPCs, every tag matches
+    static uint8_t Mask[10] = {0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30};
+    uint32_t size, tags = 0;
+
+    while(iters--)
+    {
+        CAENRFID_FilterTags(batch, BENCH_TAGS, EPC_CAEN, 32, 80, Mask, sizeof(Mask), &size);
+        tags += size;
+    }
+    return tags;
+}
+
+static uint32_t bench_DedupAdd(uint32_t iters)
+{
+    static CAENRFIDDedupEntry Entries[BENCH_TAGS];
+    static uint32_t Slots[2 * 256];
+    CAENRFIDDedup Dedup;
+    CAENRFIDDedupEvent Event;
+    bool has_event;
+    uint32_t i, tags = 0;
+
+    CAENRFID_DedupInit(&Dedup, Entries, BENCH_TAGS, Slots, 2 * 256, 0, 1000, 5000);
+    while(iters--)
+    {
+        for(i = 0; i < BENCH_TAGS; i++)
+        {
+            CAENRFID_DedupAdd(&Dedup, &batch[i], iters, &Event, &has_event);
+        }
+        tags += BENCH_TAGS;
+    }
+    return tags;
+}
+
+static const Bench_t benches[] = {
+    {"addHeader",                   bench_addHeader},
+    {"addAVP (G2 read command)",    bench_addAVP},
+    {"getAVP (4 AVPs)",             bench_getAVP},
+    {"encodeTagData (tag)",         bench_encodeTagData},
+    {"encodeTagData (handle)",      bench_encodeTagDataHandle},
+    {"encodeInventory (encode)",    bench_encodeInventory},
+    {"encodeInventory (template)",  bench_encodeInventoryTemplate},
+    {"sendReceive (FW release)",    bench_sendReceive},
+    {"InventoryTag",                bench_InventoryTag},
+    {"InventoryTagArray",           bench_InventoryTagArray},
+    {"InventoryTagFrame",           bench_InventoryTagFrame},
+    {"GetFramedTag (rx)",           bench_GetFramedTag},
+    {"GetFramedTag (rx_some)",      bench_GetFramedTag_rx_some},
+    {"GetFramedTag (all fields)",   bench_GetFramedTag_full},
+    {"receiveFramedTag (decode)",   bench_receiveFramedTag},
+    {"receiveFramedTag (generic)",  bench_referenceFramedTag},
+    {"FilterTags (EPC prefix)",     bench_FilterTags},
+    {"DedupAdd",                    bench_DedupAdd},
+};
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + (uint64_t) ts.tv_nsec;
+}
+
+static void record(void)
+{
+    CAENRFIDTagList *list, *next;
+    CAENRFIDTag Tag, RefTag;
+    IOBuffer_t txbuf = {fw_request, sizeof(fw_request), 0, 0};
+    IOBuffer_t rxbuf;
+    uint16_t cmd = CMD_GETFWRELEASE, found;
+    bool has_tag, has_result = false;
+    uint32_t i;
+
+    addHeader(0, &txbuf, sizeof(fw_request));
+    addAVP(&txbuf, sizeof(cmd), AVP_COMMAND, &cmd);
+
+    record_start();
+    fw_reply = stream_len;
+    sendReceive(&reader, &txbuf, &rxbuf);
+    inventory_reply = stream_len;
+    inventory_cmdID = reader._cmdID;
+    list = NULL;
+    CAENRFID_InventoryTag(&reader, "Source_0", 0, 0, 0, NULL, 0, 0, &list, &found);
+    while(list != NULL)
+    {
+        next = list->Next;
+        free(list);
+        list = next;
+    }
+    framed_reply = stream_len;
+    framed_cmdID = reader._cmdID;
+    list = NULL;
+    CAENRFID_InventoryTag(&reader, "Source_0", 0, 0, 0, NULL, 0, FRAMED | CONTINUOS, &list, &found);
+    while(!has_result)
+    {
+        if(CAENRFID_GetFramedTag(&reader, &has_tag, &Tag, &has_result) != 0) break;
+    }
+    framed_full_reply = stream_len;
+    framed_full_cmdID = reader._cmdID;
+    has_result = false;
+    CAENRFID_InventoryTag(&reader, "Source_0", 0, 0, 0, NULL, 0, FRAMED_FULL, &list, &found);
+    while(!has_result)
+    {
+        if(CAENRFID_GetFramedTag(&reader, &has_tag, &Tag, &has_result) != 0) break;
+    }
+    //the AVPs of the first tag follow the reply header and the command AVP
+    framed_full_params();
+    memcpy(reader._rx_buffer, &stream[framed_full_reply + HEADER_LEN + AVP_HEADLEN + 2], sizeof(framed_full_tag));
+    reader._rx_rpos = 0;
+    reader._rx_wpos = sizeof(framed_full_tag);
+    memset(&Tag, 0, sizeof(Tag));
+    receiveFramedTag(&reader, &has_tag, &Tag, &has_result);
+    framed_full_tag_len = reader._rx_rpos;
+    memcpy(framed_full_tag, reader._rx_buffer, framed_full_tag_len);
+    //both decoders must agree on the tag they are timed on
+    memset(&RefTag, 0, sizeof(RefTag));
+    reader._rx_rpos = 0;
+    referenceFramedTag(&reader, &has_tag, &RefTag, &has_result);
+    if(!has_tag || memcmp(&Tag, &RefTag, sizeof(Tag)) != 0) printf("warning: framed decoders disagree\n");
+    record_stop();
+    for(i = 0; i < BENCH_TAGS; i++)
+    {
+        memcpy(batch[i].ID, emu_tags[i].ID, emu_tags[i].Length);
+        batch[i].Length = emu_tags[i].Length;
+        memcpy(batch[i].PC, emu_tags[i].PC, PC_LENGTH);
+        strcpy(batch[i].ReadPoint, "Ant0");
+        strcpy(batch[i].LogicalSource, "Source_0");
+    }
+}
+
+int main(void)
+{
+    uint64_t start, elapsed;
+    unsigned long allocs;
+    uint32_t iters, tags;
+    size_t i;
+
+    CAENRFID_Connect(&reader, CAENRFID_RS232, NULL);
+    record();
+
+    printf("%-28s %12s %12s %14s\n", "benchmark", "ns/op", "allocs/op", "tags/s");
+    for(i = 0; i < sizeof(benches) / sizeof(benches[0]); i++)
+    {
+        //double the iterations until the run is long enough to be timed
+        for(iters = 1; iters < 0x80000000UL; iters *= 2)
+        {
+            allocs = bench_allocs;
+            start = now_ns();
+            tags = benches[i].run(iters);
+            elapsed = now_ns() - start;
+            if(elapsed >= BENCH_MIN_NS) break;
+        }
+        printf("%-28s %12.1f %12.2f", benches[i].name,
+               (double) elapsed / iters, (double)(bench_allocs - allocs) / iters);
+        if(tags != 0)
+        {
+            printf(" %14.0f", tags * 1e9 / elapsed);
+        }
+        printf("\n");
+    }
+    CAENRFID_Disconnect(&reader);
+    return 0;
+}
@@ -0,0 +1,90 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2022, CAEN RFID S.R.L.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of CAEN RFID S.R.L. nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+
+/*
+    Fixture shared by the examples driving CAENRFIDEmulator.
+
+    Included by the example sources as "../common/emu_fixture.h", so no
+    extra include path is needed to build them.
+*/
+
+#ifndef EXAMPLES_COMMON_EMU_FIXTURE_H_
+#define EXAMPLES_COMMON_EMU_FIXTURE_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "CAENRFIDEmulator_Light.h"
+
+#define CHECK(cond) \
+    do { \
+        if(!(cond)) \
+        { \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); \
+            exit(1); \
+        } \
+    } while(0)
+
+/*
+    emu_fixture_tags
+    -----------------------------------------------------------------------------
+    Parameters:
+        [out]   tags        : The emulated tags to fill.
+        [in]    num_tags    : Number of tags to fill, at most 65536.
+    -----------------------------------------------------------------------------
+    Description:
+        Fills the tags with 12 bytes EPCs made of 0x30 and ending with the
+        tag index (big endian), an 8 bytes TID, an RSSI of -600 and the
+        antenna rotating over 4 read points. The User bank of the tag i
+        holds i + j at the byte j.
+*/
+static void emu_fixture_tags(CAENRFIDEmuTag* tags, uint32_t num_tags)
+{
+    uint32_t i, j;
+
+    memset(tags, 0, num_tags * sizeof(CAENRFIDEmuTag));
+    for(i = 0; i < num_tags; i++)
+    {
+        tags[i].Length = 12;
+        memset(tags[i].ID, 0x30, 12);
+        tags[i].ID[10] = (uint8_t)(i >> 8);
+        tags[i].ID[11] = (uint8_t) i;
+        tags[i].TIDLen = 8;
+        tags[i].PC[0] = 0x30;
+        tags[i].RSSI = -600;
+        tags[i].Antenna = (uint16_t)(i % 4);
+        for(j = 0; j < CAENRFID_EMU_USER_SIZE; j++) tags[i].User[j] = (uint8_t)(i + j);
+    }
+}
+
+#endif /* EXAMPLES_COMMON_EMU_FIXTURE_H_ */
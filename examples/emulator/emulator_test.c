@@ -0,0 +1,239 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2022, CAEN RFID S.R.L.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of CAEN RFID S.R.L. nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+
+
+/*
+    Regression tests of the library against CAENRFIDEmulator.
+
+    No reader is needed: every command is served in memory by the emulator.
+    Build and run on a POSIX host from this directory:
+
+        cc -std=c99 -I../.. emulator_test.c ../../CAENRFIDLib_Light.c \
+           ../../IO_Light.c ../../Match_Light.c ../../CAENRFIDEmulator_Light.c \
+           -o emulator_test && ./emulator_test
+
+    Adding -fsanitize=address,undefined is recommended. The program prints
+    one line per test and exits with a non zero status on the first failure.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "CAENRFIDLib_Light.h"
+#include "CAENRFIDEmulator_Light.h"
+#include "../common/emu_fixture.h"
+
+#define TEST_TAGS               (6000)
+#define TEST_INVENTORY_TAGS     (200)
+#define TEST_WORD               (8)
+
+static CAENRFIDEmulator emu;
+static CAENRFIDEmuTag emu_tags[TEST_TAGS];
+static CAENRFIDTag tags[TEST_TAGS];
+static CAENRFIDErrorCodes results[TEST_TAGS];
+static uint8_t data[TEST_TAGS * TEST_WORD];
+
+static void setup(CAENRFIDReader* reader, uint32_t num_tags)
+{
+    uint32_t i;
+
+    memset(tags, 0, sizeof(tags));
+    emu_fixture_tags(emu_tags, num_tags);
+    for(i = 0; i < num_tags; i++)
+    {
+        memcpy(tags[i].ID, emu_tags[i].ID, 12);
+        tags[i].Length = 12;
+        strcpy(tags[i].LogicalSource, "Source_0");
+    }
+    memset(&emu, 0, sizeof(emu));
+    emu.Tags = emu_tags;
+    emu.NumTags = num_tags;
+    CAENRFID_EmulatorInit(&emu);
+    memset(reader, 0, sizeof(*reader));
+    CAENRFID_EmulatorAttach(reader, &emu);
+    CHECK(CAENRFID_Connect(reader, CAENRFID_RS232, &emu) == CAENRFID_StatusOK);
+}
+
+static void test_uninitialised_reader(void)
+{
+    CAENRFIDReader reader;
+    char fw[200];
+
+    //only the callbacks are set, the other fields hold a typical pattern
+    //of uninitialised RAM
+    setup(&reader, 0);
+    CAENRFID_Disconnect(&reader);
+    memset(&reader, 0xFF, sizeof(reader));
+    CAENRFID_EmulatorAttach(&reader, &emu);
+    CHECK(CAENRFID_Connect(&reader, CAENRFID_RS232, &emu) == CAENRFID_StatusOK);
+    CHECK(CAENRFID_GetFirmwareRelease(&reader, fw) == CAENRFID_StatusOK);
+    CHECK(CAENRFID_Connect(&reader, CAENRFID_RS232, &emu) == CAENRFID_StatusOK);
+    CHECK(CAENRFID_GetFirmwareRelease(&reader, fw) == CAENRFID_StatusOK);
+    CAENRFID_Disconnect(&reader);
+}
+
+static void test_settings(void)
+{
+    CAENRFIDReader reader;
+    uint32_t power;
+    char fw[200];
+    int i;
+
+    setup(&reader, 0);
+    CHECK(CAENRFID_GetFirmwareRelease(&reader, fw) == CAENRFID_StatusOK);
+    CHECK(CAENRFID_SetPower(&reader, 800) == CAENRFID_StatusOK);
+    CHECK(CAENRFID_GetPower(&reader, &power) == CAENRFID_StatusOK);
+    CHECK(power == 800);
+    //reconnecting must not leak or lose the reader state
+    for(i = 0; i < 4; i++)
+    {
+        CHECK(CAENRFID_Disconnect(&reader) == CAENRFID_StatusOK);
+        CHECK(CAENRFID_Connect(&reader, CAENRFID_RS232, &emu) == CAENRFID_StatusOK);
+    }
+    CHECK(CAENRFID_GetPower(&reader, &power) == CAENRFID_StatusOK);
+    CHECK(power == 800);
+    //the port parameters are not needed by an attached emulator
+    CHECK(CAENRFID_Disconnect(&reader) == CAENRFID_StatusOK);
+    CHECK(CAENRFID_Connect(&reader, CAENRFID_RS232, NULL) == CAENRFID_StatusOK);
+    CHECK(CAENRFID_GetPower(&reader, &power) == CAENRFID_StatusOK);
+    CAENRFID_Disconnect(&reader);
+}
+
+static void test_inventory(void)
+{
+    CAENRFIDReader reader;
+    uint16_t size = 0, found = 0;
+
+    setup(&reader, TEST_INVENTORY_TAGS);
+    CHECK(CAENRFID_InventoryTagArray(&reader, "Source_0", 0, 0, 0, NULL, 0, 0,
+                                     tags, TEST_INVENTORY_TAGS, &size, &found) == CAENRFID_StatusOK);
+    CHECK(size == TEST_INVENTORY_TAGS);
+    CHECK(found == TEST_INVENTORY_TAGS);
+    CAENRFID_Disconnect(&reader);
+}
+
+static void test_select(void)
+{
+    CAENRFIDReader reader;
+    uint8_t mask = 0x30;
+    //two rounds reporting the same tags, i.e. the EPCs ending with 3h
+    CAENRFIDSelectClause clauses[2] = {
+        {GROUP_SELECT_EQUAL, EPC_CAEN, 124, 4, &mask, 1},
+        {GROUP_SELECT_EQUAL, EPC_CAEN, 124, 4, &mask, 1},
+    };
+    CAENRFIDDedup overflow;
+    CAENRFIDDedupEntry entries[16];
+    uint32_t slots[32];
+    uint16_t size = 0, found = 0;
+    uint16_t expected = (TEST_INVENTORY_TAGS + 12) / 16;
+
+    setup(&reader, TEST_INVENTORY_TAGS);
+    CHECK(CAENRFID_InventoryTagSelect(&reader, "Source_0", clauses, 2, 0,
+                                      tags, TEST_INVENTORY_TAGS, NULL, &size, &found) == CAENRFID_StatusOK);
+    CHECK(size == expected);
+    CHECK(found == expected);
+    //tags not fitting in Tags are counted once when tracked in a set
+    CHECK(CAENRFID_DedupInit(&overflow, entries, 16, slots, 32, 0, 0, 0) == CAENRFID_StatusOK);
+    CHECK(CAENRFID_InventoryTagSelect(&reader, "Source_0", clauses, 2, 0,
+                                      tags, 4, &overflow, &size, &found) == CAENRFID_StatusOK);
+    CHECK(size == 4);
+    CHECK(found == expected);
+    //and by every round reporting them otherwise
+    CHECK(CAENRFID_InventoryTagSelect(&reader, "Source_0", clauses, 2, 0,
+                                      tags, 4, NULL, &size, &found) == CAENRFID_StatusOK);
+    CHECK(size == 4);
+    CHECK(found == 2 * expected - 4);
+    CAENRFID_Disconnect(&reader);
+}
+
+static void check_batch(uint32_t num_tags)
+{
+    uint32_t i, j;
+
+    for(i = 0; i < num_tags; i++)
+    {
+        CHECK(results[i] == CAENRFID_StatusOK);
+        for(j = 0; j < TEST_WORD; j++) CHECK(data[i * TEST_WORD + j] == (uint8_t)(i + j));
+    }
+}
+
+static void test_batch(bool reorder)
+{
+    CAENRFIDReader reader;
+
+    //the replies of a batch outgrow the emulator output buffer, which is
+    //then compacted between the commands
+    setup(&reader, TEST_TAGS);
+    emu.ReorderReplies = reorder;
+    memset(data, 0, sizeof(data));
+    CHECK(CAENRFID_ReadTagDataBatch_EPC_C1G2(&reader, tags, TEST_TAGS, 3, 0, TEST_WORD,
+                                             data, 0, results) == CAENRFID_StatusOK);
+    check_batch(TEST_TAGS);
+    CAENRFID_Disconnect(&reader);
+}
+
+static void test_handle(void)
+{
+    CAENRFIDReader reader;
+    CAENRFIDTagHandle handle;
+    uint8_t word[TEST_WORD];
+
+    setup(&reader, 1);
+    CHECK(CAENRFID_TagHandleInit(&handle, &tags[0], 0) == CAENRFID_StatusOK);
+    CHECK(CAENRFID_ReadTagDataHandle_EPC_C1G2(&reader, &handle, 3, 0, TEST_WORD, word) == CAENRFID_StatusOK);
+    CHECK(word[1] == 1);
+    //a handle addressing no tag carries no ID to be programmed
+    CHECK(CAENRFID_TagHandleInit(&handle, NULL, 0) == CAENRFID_StatusOK);
+    CHECK(CAENRFID_ProgramIDHandle_EPC_C1G2(&reader, &handle, 0) != CAENRFID_StatusOK);
+    CHECK(emu_tags[0].Length == 12);
+    CAENRFID_Disconnect(&reader);
+}
+
+int main(void)
+{
+    test_settings();
+    printf("settings: OK\n");
+    test_uninitialised_reader();
+    printf("uninitialised reader: OK\n");
+    test_inventory();
+    printf("inventory: OK\n");
+    test_select();
+    printf("select: OK\n");
+    test_batch(false);
+    printf("batch read: OK\n");
+    test_batch(true);
+    printf("batch read, reordered replies: OK\n");
+    test_handle();
+    printf("tag handle: OK\n");
+    return 0;
+}
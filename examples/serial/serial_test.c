@@ -0,0 +1,214 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2022, CAEN RFID S.R.L.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of CAEN RFID S.R.L. nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+
+
+/*
+    Test of the Linux serial backend (CAENRFIDSerial_Light) over a pseudo
+    terminal.
+
+    A thread serves the master side of a pty with CAENRFIDEmulator, while
+    the library drives the slave side as it would drive the tty of a reader.
+    Build and run on Linux from this directory:
+
+        cc -std=c99 -I../.. serial_test.c ../../CAENRFIDSerial_Light.c \
+           ../../CAENRFIDLib_Light.c ../../IO_Light.c ../../Match_Light.c \
+           ../../CAENRFIDEmulator_Light.c -lpthread -o serial_test && ./serial_test
+
+    The program exits with a non zero status on the first failure, otherwise
+    it prints the mean GetPower round trip and the time taken to report a
+    reader that stopped answering.
+*/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "CAENRFIDLib_Light.h"
+#include "CAENRFIDSerial_Light.h"
+#include "CAENRFIDEmulator_Light.h"
+#include "../common/emu_fixture.h"
+
+#define TEST_TAGS               (300)
+#define TEST_POLLS              (500)
+
+static CAENRFIDEmulator emu;
+static CAENRFIDEmuTag emu_tags[TEST_TAGS];
+static CAENRFIDSerialPort port;
+static int master;
+static volatile bool running = true;
+
+/*
+    Emulated reader: pumps bytes between the pty master and the emulator
+*/
+static void* pump(void* arg)
+{
+    uint8_t in[4096], out[4096];
+    uint32_t pending = 0, offset = 0;
+    ssize_t n;
+
+    while(running)
+    {
+        struct pollfd pfd = {master, (short)(POLLIN | (pending ? POLLOUT : 0)), 0};
+
+        poll(&pfd, 1, 1);
+        if(pfd.revents & POLLIN)
+        {
+            n = read(master, in, sizeof(in));
+            if(n > 0) CAENRFID_EmulatorWrite(&emu, in, (uint32_t) n);
+        }
+        if(pending == 0)
+        {
+            pending = CAENRFID_EmulatorRead(&emu, out, sizeof(out));
+            offset = 0;
+        }
+        if(pending > 0)
+        {
+            n = write(master, &out[offset], pending);
+            if(n > 0)
+            {
+                offset += (uint32_t) n;
+                pending -= (uint32_t) n;
+            }
+        }
+    }
+    return arg;
+}
+
+static double now_ms(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+static void setup_emulator(void)
+{
+    emu_fixture_tags(emu_tags, TEST_TAGS);
+    emu.Tags = emu_tags;
+    emu.NumTags = TEST_TAGS;
+    CAENRFID_EmulatorInit(&emu);
+}
+
+static void test_framed_inventory(CAENRFIDReader* reader)
+{
+    CAENRFIDTagList* list = NULL;
+    CAENRFIDTag tag;
+    uint16_t size = 0;
+    bool has_tag, has_result = false;
+    uint32_t count = 0;
+
+    CHECK(CAENRFID_InventoryTag(reader, "Source_0", 0, 0, 0, NULL, 0,
+                                FRAMED | CONTINUOS | RSSI | TID_READING, &list, &size) == CAENRFID_StatusOK);
+    while(!has_result)
+    {
+        CHECK(CAENRFID_GetFramedTag(reader, &has_tag, &tag, &has_result) == CAENRFID_StatusOK);
+        if(has_tag)
+        {
+            CHECK(tag.ID[11] == (uint8_t) count);
+            count++;
+        }
+    }
+    CHECK(count == TEST_TAGS);
+}
+
+int main(void)
+{
+    CAENRFIDReader reader;
+    CAENRFIDSerialParams params, bad;
+    static CAENRFIDTag tags[TEST_TAGS];
+    uint16_t size = 0, found = 0;
+    uint32_t power;
+    char fw[200];
+    pthread_t thread;
+    double start, poll_ms, timeout_ms;
+    int i, fd;
+
+    master = posix_openpt(O_RDWR | O_NOCTTY);
+    CHECK(master >= 0);
+    CHECK(grantpt(master) == 0 && unlockpt(master) == 0);
+    fcntl(master, F_SETFL, O_NONBLOCK);
+    setup_emulator();
+    CHECK(pthread_create(&thread, NULL, pump, NULL) == 0);
+
+    memset(&reader, 0, sizeof(reader));
+    CAENRFID_SerialAttach(&reader, &port);
+    memset(&params, 0, sizeof(params));
+    params.Device = ptsname(master);
+    params.Parity = CAENRS232_Parity_None;
+    params.FlowControl = CAENRFID_RS232_FlowControl_None;
+
+    //unsupported settings and missing devices are reported as port errors
+    bad = params;
+    bad.BaudRate = 12345;
+    CHECK(CAENRFID_Connect(&reader, CAENRFID_RS232, &bad) == CAENRFID_PortError);
+    bad = params;
+    bad.Device = "/dev/nonexistent_tty";
+    CHECK(CAENRFID_Connect(&reader, CAENRFID_RS232, &bad) == CAENRFID_PortError);
+
+    //connecting again closes the tty first
+    CHECK(CAENRFID_Connect(&reader, CAENRFID_RS232, &params) == CAENRFID_StatusOK);
+    fd = port._fd;
+    CHECK(CAENRFID_Connect(&reader, CAENRFID_RS232, &params) == CAENRFID_StatusOK);
+    CHECK(CAENRFID_Disconnect(&reader) == CAENRFID_StatusOK);
+    CHECK(fcntl(fd, F_GETFD) == -1);
+
+    CHECK(CAENRFID_Connect(&reader, CAENRFID_RS232, &params) == CAENRFID_StatusOK);
+    CHECK(CAENRFID_GetFirmwareRelease(&reader, fw) == CAENRFID_StatusOK);
+    start = now_ms();
+    for(i = 0; i < TEST_POLLS; i++) CHECK(CAENRFID_GetPower(&reader, &power) == CAENRFID_StatusOK);
+    poll_ms = (now_ms() - start) / TEST_POLLS;
+    CHECK(CAENRFID_InventoryTagArray(&reader, "Source_0", 0, 0, 0, NULL, 0, RSSI,
+                                     tags, TEST_TAGS, &size, &found) == CAENRFID_StatusOK);
+    CHECK(size == TEST_TAGS);
+    for(i = 0; i < 3; i++) test_framed_inventory(&reader);
+    CHECK(CAENRFID_GetPower(&reader, &power) == CAENRFID_StatusOK);
+
+    //a reader that stopped answering times out
+    running = false;
+    pthread_join(thread, NULL);
+    start = now_ms();
+    CHECK(CAENRFID_GetPower(&reader, &power) == CAENRFID_CommunicationError);
+    timeout_ms = now_ms() - start;
+    CHECK(CAENRFID_Disconnect(&reader) == CAENRFID_StatusOK);
+    close(master);
+
+    printf("OK %.3f ms/GetPower, timeout %.0f ms\n", poll_ms, timeout_ms);
+    return 0;
+}
@@ -0,0 +1,331 @@
+/* --COPYRIGHT--,BSD
+ * Copyright (c) 2022, CAEN RFID S.R.L.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ *
+ * *  Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * *  Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * *  Neither the name of CAEN RFID S.R.L. nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ * OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ * OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+ * EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ * --/COPYRIGHT--*/
+
+
+/*
+    Test of the TCP backend (CAENRFIDTCP_Light) over the loopback interface.
+
+    A thread serves a listening socket on 127.0.0.1 with CAENRFIDEmulator,
+    replies to pipelined commands being sent back in reverse order, and can
+    be told to close the connection to check that it is restored.
+    Build and run on a POSIX host from this directory:
+
+        cc -std=c99 -I../.. tcp_test.c ../../CAENRFIDTCP_Light.c \
+           ../../CAENRFIDLib_Light.c ../../IO_Light.c ../../Match_Light.c \
+           ../../CAENRFIDEmulator_Light.c -lpthread -o tcp_test && ./tcp_test
+
+    The inventory abort is sent by a second thread while the main one waits
+    for tags, so the same build with -fsanitize=thread checks the locking of
+    the port. The program exits with a non zero status on the first failure.
+*/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include "CAENRFIDLib_Light.h"
+#include "CAENRFIDTCP_Light.h"
+#include "CAENRFIDEmulator_Light.h"
+#include "../common/emu_fixture.h"
+
+#define TEST_TAGS               (300)
+#define TEST_POLLS              (500)
+#define TEST_ABORT_AFTER        (1000)
+#define TEST_WORD               (8)
+
+static CAENRFIDEmulator emu;
+static CAENRFIDEmuTag emu_tags[TEST_TAGS];
+static CAENRFIDTCPPort port;
+static CAENRFIDReader reader;
+static int listener;
+
+/*
+    Flags shared by the test threads
+*/
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static int running = 1;
+static int drop;           // close the connection now
+static int drop_on_cmd;    // close the connection on the next command
+static int recvs;          // recv calls returning data
+static int seen;           // tags seen before the inventory abort
+
+static int get_flag(const int* flag)
+{
+    int value;
+
+    pthread_mutex_lock(&lock);
+    value = *flag;
+    pthread_mutex_unlock(&lock);
+    return value;
+}
+
+static void set_flag(int* flag, int value)
+{
+    pthread_mutex_lock(&lock);
+    *flag = value;
+    pthread_mutex_unlock(&lock);
+}
+
+static bool take_flag(int* flag)
+{
+    bool value;
+
+    pthread_mutex_lock(&lock);
+    value = (*flag != 0);
+    *flag = 0;
+    pthread_mutex_unlock(&lock);
+    return value;
+}
+
+static void add_flag(int* flag, int value)
+{
+    pthread_mutex_lock(&lock);
+    *flag += value;
+    pthread_mutex_unlock(&lock);
+}
+
+/*
+    Emulated reader: each accepted connection finds a reader just powered on
+*/
+static void serve(int fd)
+{
+    uint8_t in[8192], out[4096];
+    uint32_t pending = 0, offset = 0;
+    ssize_t n;
+
+    CAENRFID_EmulatorInit(&emu);
+    while(get_flag(&running) && !take_flag(&drop))
+    {
+        struct pollfd pfd = {fd, (short)(POLLIN | (pending ? POLLOUT : 0)), 0};
+
+        poll(&pfd, 1, 1);
+        if(pfd.revents & POLLIN)
+        {
+            n = recv(fd, in, sizeof(in), 0);
+            if(n == 0) break;
+            if(n > 0)
+            {
+                add_flag(&recvs, 1);
+                if(take_flag(&drop_on_cmd)) break;
+                CAENRFID_EmulatorWrite(&emu, in, (uint32_t) n);
+            }
+        }
+        if(pending == 0)
+        {
+            pending = CAENRFID_EmulatorRead(&emu, out, sizeof(out));
+            offset = 0;
+        }
+        if(pending > 0)
+        {
+            n = send(fd, &out[offset], pending, MSG_NOSIGNAL);
+            if(n > 0)
+            {
+                offset += (uint32_t) n;
+                pending -= (uint32_t) n;
+            }
+        }
+    }
+}
+
+static void* server(void* arg)
+{
+    int fd;
+
+    while(get_flag(&running))
+    {
+        struct pollfd pfd = {listener, POLLIN, 0};
+
+        if(poll(&pfd, 1, 5) <= 0) continue;
+        if((fd = accept(listener, NULL, NULL)) < 0) continue;
+        fcntl(fd, F_SETFL, O_NONBLOCK);
+        serve(fd);
+        close(fd);
+    }
+    return arg;
+}
+
+static void* aborter(void* arg)
+{
+    while(get_flag(&seen) < TEST_ABORT_AFTER) usleep(100);
+    CHECK(CAENRFID_InventoryAbort(&reader) == CAENRFID_StatusOK);
+    return arg;
+}
+
+static double now_ms(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+static uint16_t setup_server(void)
+{
+    struct sockaddr_in addr;
+    socklen_t addr_len = sizeof(addr);
+    int one = 1;
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    listener = socket(AF_INET, SOCK_STREAM, 0);
+    CHECK(listener >= 0);
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    CHECK(bind(listener, (struct sockaddr*) &addr, sizeof(addr)) == 0);
+    CHECK(listen(listener, 4) == 0);
+    CHECK(getsockname(listener, (struct sockaddr*) &addr, &addr_len) == 0);
+
+    emu_fixture_tags(emu_tags, TEST_TAGS);
+    emu.Tags = emu_tags;
+    emu.NumTags = TEST_TAGS;
+    emu.ReorderReplies = true;
+    return ntohs(addr.sin_port);
+}
+
+static uint32_t framed_inventory(uint16_t flag, bool count_seen)
+{
+    CAENRFIDTagList* list = NULL;
+    CAENRFIDTag tag;
+    uint16_t size = 0;
+    bool has_tag, has_result = false;
+    uint32_t count = 0;
+
+    CHECK(CAENRFID_InventoryTag(&reader, "Source_0", 0, 0, 0, NULL, 0,
+                                FRAMED | CONTINUOS | flag, &list, &size) == CAENRFID_StatusOK);
+    while(!has_result)
+    {
+        CHECK(CAENRFID_GetFramedTag(&reader, &has_tag, &tag, &has_result) == CAENRFID_StatusOK);
+        if(has_tag)
+        {
+            count++;
+            if(count_seen) add_flag(&seen, 1);
+        }
+    }
+    return count;
+}
+
+int main(void)
+{
+    CAENRFIDTCPParams params, bad;
+    static CAENRFIDTag tags[TEST_TAGS];
+    static uint8_t data[TEST_TAGS * TEST_WORD];
+    static CAENRFIDErrorCodes results[TEST_TAGS];
+    uint16_t size = 0, found = 0;
+    uint32_t power, i;
+    char fw[200];
+    pthread_t thread, abort_thread;
+    double start, poll_ms, reconnect_ms;
+    int batch_recvs;
+
+    memset(&params, 0, sizeof(params));
+    params.Address = "127.0.0.1";
+    params.Port = setup_server();
+    params.ConnectMs = 200;
+    params.ReconnectTries = 3;
+    CHECK(pthread_create(&thread, NULL, server, NULL) == 0);
+    CAENRFID_TCPAttach(&reader, &port);
+
+    //wrong port types and refused connections are reported as port errors
+    CHECK(CAENRFID_Connect(&reader, CAENRFID_RS232, &params) == CAENRFID_PortError);
+    bad = params;
+    bad.Port = 1;
+    CHECK(CAENRFID_Connect(&reader, CAENRFID_TCP, &bad) == CAENRFID_PortError);
+
+    CHECK(CAENRFID_Connect(&reader, CAENRFID_TCP, &params) == CAENRFID_StatusOK);
+    CHECK(CAENRFID_GetFirmwareRelease(&reader, fw) == CAENRFID_StatusOK);
+    //connecting again replaces the connection
+    CHECK(CAENRFID_Connect(&reader, CAENRFID_TCP, &params) == CAENRFID_StatusOK);
+    CHECK(CAENRFID_GetFirmwareRelease(&reader, fw) == CAENRFID_StatusOK);
+    start = now_ms();
+    for(i = 0; i < TEST_POLLS; i++) CHECK(CAENRFID_GetPower(&reader, &power) == CAENRFID_StatusOK);
+    poll_ms = (now_ms() - start) / TEST_POLLS;
+
+    //pipelined reads are coalesced and their replies matched out of order
+    CHECK(CAENRFID_InventoryTagArray(&reader, "Source_0", 0, 0, 0, NULL, 0, 0,
+                                     tags, TEST_TAGS, &size, &found) == CAENRFID_StatusOK);
+    CHECK(size == TEST_TAGS);
+    batch_recvs = get_flag(&recvs);
+    CHECK(CAENRFID_ReadTagDataBatch_EPC_C1G2(&reader, tags, TEST_TAGS, 3, 0, TEST_WORD,
+                                             data, 0, results) == CAENRFID_StatusOK);
+    batch_recvs = get_flag(&recvs) - batch_recvs;
+    for(i = 0; i < TEST_TAGS; i++)
+    {
+        uint32_t k = tags[i].ID[10] * 256u + tags[i].ID[11];
+
+        CHECK(results[i] == CAENRFID_StatusOK);
+        CHECK(memcmp(&data[i * TEST_WORD], emu_tags[k].User, TEST_WORD) == 0);
+    }
+    CHECK(framed_inventory(RSSI, false) == TEST_TAGS);
+
+    //the abort is sent by another thread while this one waits for tags
+    CHECK(CAENRFID_SetSourceConfiguration(&reader, "Source_0", CONFIG_READCYCLE, 0) == CAENRFID_StatusOK);
+    CHECK(pthread_create(&abort_thread, NULL, aborter, NULL) == 0);
+    framed_inventory(0, true);
+    pthread_join(abort_thread, NULL);
+    CHECK(get_flag(&seen) >= TEST_ABORT_AFTER);
+
+    //the peer closes between commands: restored before the next one
+    set_flag(&drop, 1);
+    while(get_flag(&drop)) usleep(100);
+    start = now_ms();
+    CHECK(CAENRFID_GetPower(&reader, &power) == CAENRFID_StatusOK);
+    reconnect_ms = now_ms() - start;
+    CHECK(port.Reconnects == 1);
+
+    //the peer closes while a reply is awaited: that command fails, the next works
+    set_flag(&drop_on_cmd, 1);
+    CHECK(CAENRFID_GetPower(&reader, &power) == CAENRFID_CommunicationError);
+    CHECK(port.Reconnects == 2);
+    CHECK(CAENRFID_GetPower(&reader, &power) == CAENRFID_StatusOK);
+
+    //no server left
+    set_flag(&running, 0);
+    pthread_join(thread, NULL);
+    close(listener);
+    CHECK(CAENRFID_GetPower(&reader, &power) != CAENRFID_StatusOK);
+    CHECK(CAENRFID_Disconnect(&reader) == CAENRFID_StatusOK);
+    CHECK(CAENRFID_Connect(&reader, CAENRFID_TCP, &params) == CAENRFID_PortError);
+    CHECK(CAENRFID_Disconnect(&reader) == CAENRFID_StatusOK);
+
+    printf("OK %.3f ms/GetPower, %d recvs for %d pipelined reads, reconnect %.2f ms\n",
+           poll_ms, batch_recvs, TEST_TAGS, reconnect_ms);
+    return 0;
+}